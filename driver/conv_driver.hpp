@@ -382,6 +382,27 @@ class ConvDriver : public Driver
         BwdBias
     };
 
+    /// Error of the CPU reference itself, which depends on the algorithm it uses.
+    double GetCpuReferenceError(Direction direction)
+    {
+        if(UseGPUReference())
+            return 0;
+
+        const auto& conv = miopen::deref(convDesc);
+        auto cpu_direction =
+            direction == Direction::WrW ? cpu_conv_direction::backward_weights
+            : (direction == Direction::Fwd) == (conv.mode != miopenTranspose)
+                ? cpu_conv_direction::forward
+                : cpu_conv_direction::backward_data;
+
+        return cpu_convolution_reference_error(cpu_convolution_algo(cpu_direction,
+                                                                    wei.desc,
+                                                                    conv.GetConvPads(),
+                                                                    conv.GetConvStrides(),
+                                                                    conv.GetConvDilations(),
+                                                                    conv.GetGroupCount()));
+    }
+
     std::string GetVerificationCacheFileName(const Direction& direction) const;
     bool IsInputTensorTransform() const;
 
@@ -3206,6 +3227,7 @@ int ConvDriver<Tgpu, Tref>::VerifyForward()
     // The reason is most likely different order of computations.
     if(is_fwd_igemm)
         tolerance = tolerance * 10;
+    tolerance += GetCpuReferenceError(Direction::Fwd);
 
     if(error > tolerance)
     {
@@ -3250,6 +3272,7 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
         // The reason is most likely different order of computations.
         if(is_bwd_igemm)
             tolerance = tolerance * 10;
+        tolerance += GetCpuReferenceError(Direction::Bwd);
 
         if(error_data > tolerance)
         {
@@ -3295,6 +3318,7 @@ int ConvDriver<Tgpu, Tref>::VerifyBackward()
             else if(std::is_same<Tgpu, float16>::value)
                 tolerance *= 5;
         }
+        tolerance += GetCpuReferenceError(Direction::WrW);
 
         auto error_weights = is_wrw_run_failed ? std::numeric_limits<double>::max()
                                                : miopen::rms_range(dwei_host.data, dwei);
@@ -276,6 +276,16 @@ MIOPEN_DECLARE_OBJECT(miopenTensorDescriptor);
  */
 MIOPEN_DECLARE_OBJECT(miopenConvolutionDescriptor);
 
+/*! @ingroup convolutions
+ * @brief Creates the miopenPreparedConvolution_t type
+ *
+ * Prepared convolution is an object that holds a convolution problem together with the solution
+ * chosen for it, resolved once, so that the convolution can be executed repeatedly with only the
+ * tensor and workspace pointers.
+ *
+ */
+MIOPEN_DECLARE_OBJECT(miopenPreparedConvolution);
+
 /*! @ingroup pooling
  * @brief Creates the miopenPoolingDescriptor_t type
  *
@@ -989,6 +999,16 @@ typedef enum
     miopenConvolutionAlgoImplicitGEMM = 5, /*!< Implicit GEMM convolutions, fp32 only */
 } miopenConvAlgorithm_t;
 
+/*! @enum miopenConvDirection_t
+ * Direction of a convolution
+ */
+typedef enum
+{
+    miopenConvDirectionForward         = 0, /*!< Forward convolution */
+    miopenConvDirectionBackwardData    = 1, /*!< Backward convolution w-r-t data */
+    miopenConvDirectionBackwardWeights = 2, /*!< Backward convolution w-r-t weights */
+} miopenConvDirection_t;
+
 /*! @brief Perf struct for forward, backward filter, or backward data algorithms
  *
  * Contains the union to hold the selected convolution algorithm for forward, or backwards layers,
@@ -1449,6 +1469,68 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
                                           size_t workSpaceSize,
                                           const uint64_t solution_id);
 
+/*! @brief Prepares a convolution to be executed repeatedly with the provided solution ID.
+ *
+ * Validates the tensor descriptors and resolves the solution once, compiling its kernels if
+ * needed, so that miopenRunPreparedConvolution only launches them. This saves the host time that
+ * the Immediate calls spend on the same work for each launch, which matters for small problems.
+ *
+ * The tensors are named as for the forward convolution for all the directions: y is the output
+ * of the forward convolution and the input dy of the backward ones, x is the output dx of the
+ * backward convolution w-r-t data and w is the output dw of the backward convolution w-r-t
+ * weights. The descriptors are copied, so they may be changed or destroyed afterwards.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param prepared       Prepared convolution (output)
+ * @param direction      Direction of the convolution (input)
+ * @param wDesc          Tensor descriptor for weight tensor w (input)
+ * @param xDesc          Tensor descriptor for data tensor x (input)
+ * @param convDesc       Convolution layer descriptor (input)
+ * @param yDesc          Tensor descriptor for data tensor y (input)
+ * @param solution_id    ID of the solution to be used, as chosen by the user (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenCreatePreparedConvolution(miopenHandle_t handle,
+                                miopenPreparedConvolution_t* prepared,
+                                miopenConvDirection_t direction,
+                                const miopenTensorDescriptor_t wDesc,
+                                const miopenTensorDescriptor_t xDesc,
+                                const miopenConvolutionDescriptor_t convDesc,
+                                const miopenTensorDescriptor_t yDesc,
+                                const uint64_t solution_id);
+
+/*! @brief Executes a prepared convolution
+ *
+ * Must be called with the handle the convolution has been prepared with. The tensors are named
+ * as in miopenCreatePreparedConvolution, and the one written depends on the direction.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param prepared       Prepared convolution (input)
+ * @param w              Weight tensor w (input or output)
+ * @param x              Data tensor x (input or output)
+ * @param y              Data tensor y (input or output)
+ * @param workSpace      Workspace tensor (input)
+ * @param workSpaceSize  Size in bytes of the memory pointed to by workSpace
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenRunPreparedConvolution(miopenHandle_t handle,
+                             const miopenPreparedConvolution_t prepared,
+                             void* w,
+                             void* x,
+                             void* y,
+                             void* workSpace,
+                             size_t workSpaceSize);
+
+/*! @brief Destroys a prepared convolution
+ *
+ * @param prepared       Prepared convolution (input)
+ * @return               miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t
+miopenDestroyPreparedConvolution(miopenPreparedConvolution_t prepared);
+
 /*! @brief Query the workspace size required for a forward convolution layer
  *
  * This call is required and must be executed once before running
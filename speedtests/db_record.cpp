@@ -0,0 +1,253 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_record.hpp>
+#include <miopen/logger.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace miopen {
+namespace db_record {
+
+/// Reproduces the former DbRecord contents handling, for comparison.
+struct LegacyRecord
+{
+    std::string key;
+    std::unordered_map<std::string, std::string> map;
+
+    bool ParseContents(const std::string& contents)
+    {
+        auto ss = std::istringstream(contents);
+        std::string id_and_values;
+        map.clear();
+
+        while(std::getline(ss, id_and_values, ';'))
+        {
+            const auto id_size = id_and_values.find(':');
+            if(id_size == std::string::npos)
+                continue;
+
+            const auto id     = id_and_values.substr(0, id_size);
+            const auto values = id_and_values.substr(id_size + 1);
+
+            if(map.find(id) == map.end())
+                map.emplace(id, values);
+        }
+
+        return !map.empty();
+    }
+
+    void WriteContents(std::ostream& stream) const
+    {
+        if(map.empty())
+            return;
+
+        stream << key << '=';
+
+        const auto pairsJoiner = [](const std::string& sum,
+                                    const std::pair<std::string, std::string>& pair) {
+            const auto pair_str = pair.first + ':' + pair.second;
+            return sum.empty() ? pair_str : sum + ';' + pair_str;
+        };
+
+        stream << std::accumulate(map.begin(), map.end(), std::string(), pairsJoiner) << std::endl;
+    }
+
+    bool GetValues(const std::string& id, std::string& values) const
+    {
+        const auto it = map.find(id);
+
+        if(it == map.end())
+        {
+            MIOPEN_LOG_I(key << '=' << id << ':' << "<values not found>");
+            return false;
+        }
+
+        values = it->second;
+        MIOPEN_LOG_I(key << '=' << id << ':' << values);
+        return true;
+    }
+};
+
+struct Key
+{
+    void Serialize(std::ostream& stream) const
+    {
+        stream << "64-56-56-3x3-64-56-56-64-1x1-1x1-1x1-0-NCHW-FP32-F";
+    }
+};
+
+struct Values
+{
+    std::string str;
+
+    bool Deserialize(const std::string& s)
+    {
+        str = s;
+        return true;
+    }
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(ids, "ids");
+    }
+
+    void run() const
+    {
+        std::ostringstream contents_stream;
+        for(auto i = 0; i < ids; ++i)
+        {
+            if(i != 0)
+                contents_stream << ';';
+            contents_stream << Id(i) << ':' << "16,32,4,1,1,8,2,4,64,128," << i;
+        }
+        const auto contents = contents_stream.str();
+
+        auto legacy = LegacyRecord{};
+        legacy.key  = DbRecord{Key{}}.GetKey();
+        auto record = DbRecord{Key{}};
+
+        if(!legacy.ParseContents(contents) || !record.ParseContents(contents))
+        {
+            std::cerr << "Failed to parse the record." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        // Silences the logging of the lookups.
+        const auto logging = IsLogging(LoggingLevel::Info);
+        if(logging)
+            std::cout << "Set MIOPEN_LOG_LEVEL below 5 for meaningful results." << std::endl;
+
+        std::cout << "Record with " << ids << " IDs, " << contents.size() << " bytes" << std::endl;
+
+        Compare(
+            "Parse",
+            [&]() { return legacy.ParseContents(contents); },
+            [&]() { return record.ParseContents(contents); });
+
+        Compare(
+            "Write",
+            [&]() {
+                std::ostringstream ss;
+                legacy.WriteContents(ss);
+                return ss.tellp() > 0;
+            },
+            [&]() {
+                std::ostringstream ss;
+                record.WriteContents(ss);
+                return ss.tellp() > 0;
+            });
+
+        Compare(
+            "Copy",
+            [&]() {
+                const auto copy = legacy;
+                return !copy.map.empty();
+            },
+            [&]() {
+                const auto copy = record;
+                return copy.GetSize() != 0;
+            });
+
+        Compare(
+            "Lookup all IDs",
+            [&]() {
+                auto found = true;
+                Values values;
+                for(auto i = 0; i < ids; ++i)
+                {
+                    std::string str;
+                    found = legacy.GetValues(Id(i), str) && values.Deserialize(str) && found;
+                }
+                return found;
+            },
+            [&]() {
+                auto found = true;
+                Values values;
+                for(auto i = 0; i < ids; ++i)
+                    found = record.GetValues(Id(i), values) && found;
+                return found;
+            });
+    }
+
+    private:
+    int iterations = 100000;
+    int ids        = 64;
+
+    static std::string Id(int i) { return "ConvAsmImplicitGemmSolver" + std::to_string(i); }
+
+    template <class TOld, class TNew>
+    void Compare(const std::string& name, const TOld& old_impl, const TNew& new_impl) const
+    {
+        const auto old_time = Measure(old_impl);
+        const auto new_time = Measure(new_impl);
+
+        std::cout << name << ": old " << old_time << " us, new " << new_time << " us, x"
+                  << old_time / new_time << std::endl;
+    }
+
+    /// Returns the average time of a call in microseconds.
+    template <class TFunc>
+    double Measure(const TFunc& func) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for(auto i = 0; i < iterations; ++i)
+        {
+            if(!func())
+            {
+                std::cerr << "Benchmarked function has failed." << std::endl;
+                std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+            }
+        }
+
+        const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        return time * .001 / iterations;
+    }
+};
+} // namespace db_record
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::db_record::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/cow_registry.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <driver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace db_registry {
+
+enum class Registries
+{
+    RamDb,
+    SQLite,
+    Mutex,
+    Unknown,
+};
+
+/// Reproduces the former registries, which took a global lock around a std::map lookup.
+struct MutexRegistry
+{
+    int& Get(const std::string& path)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto it = instances.find(path);
+        if(it != instances.end())
+            return it->second;
+        return instances.emplace(path, 0).first->second;
+    }
+
+    private:
+    std::mutex mutex;
+    std::map<std::string, int> instances;
+};
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(max_threads, "max-threads");
+        add(registry_str, "registry");
+    }
+
+    void run()
+    {
+        const TempFile db_file{"miopen.speedtest.db_registry"};
+        const auto path     = db_file.Path();
+        const auto registry = ParseRegistry(registry_str);
+
+        switch(registry)
+        {
+        case Registries::RamDb: {
+            std::ofstream(path) << "key=id:values" << std::endl;
+            Test([&]() { return &ReadonlyRamDb::GetCached(path, false); });
+            break;
+        }
+        case Registries::SQLite:
+#if MIOPEN_ENABLE_SQLITE
+            Test([&]() { return &SQLitePerfDb::GetCached(path, false, "gfx906", 64); });
+            break;
+#else
+            std::cerr << "SQLite is disabled in this build." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+#endif
+        case Registries::Mutex: {
+            MutexRegistry mutex_registry;
+            Test([&]() { return &mutex_registry.Get(path); });
+            break;
+        }
+        case Registries::Unknown:
+            std::cerr << "Unknown registry." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+    }
+
+    void show_help()
+    {
+        test_driver::show_help();
+        std::cout << "Permitted registries: ramdb, sqlite, mutex" << std::endl;
+    }
+
+    private:
+    int iterations           = 1000000;
+    int max_threads          = 64;
+    std::string registry_str = "ramdb";
+
+    static Registries ParseRegistry(const std::string& str)
+    {
+        if(str == "ramdb")
+            return Registries::RamDb;
+        if(str == "sqlite")
+            return Registries::SQLite;
+        if(str == "mutex")
+            return Registries::Mutex;
+        return Registries::Unknown;
+    }
+
+    template <class TGetter>
+    void Test(const TGetter& getter) const
+    {
+        // The first call creates the instance, so it is not measured.
+        const auto expected = getter();
+
+        for(auto threads_count = 1; threads_count <= max_threads; threads_count *= 2)
+        {
+            std::atomic<int> mismatches{0};
+            auto threads = std::vector<std::thread>{};
+            threads.reserve(threads_count);
+
+            const auto start = std::chrono::steady_clock::now();
+
+            for(auto i = 0; i < threads_count; ++i)
+            {
+                threads.emplace_back([&]() {
+                    for(auto j = 0; j < iterations; ++j)
+                        if(getter() != expected)
+                            ++mismatches;
+                });
+            }
+
+            for(auto& thread : threads)
+                thread.join();
+
+            const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+            const auto lookups = static_cast<double>(iterations) * threads_count;
+
+            std::cout << "Threads: " << threads_count << ", time: " << time * .001 * .001 * .001
+                      << " seconds, " << lookups / time * 1000 << " M lookups/second" << std::endl;
+
+            if(mismatches != 0)
+            {
+                std::cerr << "Registry returned a different instance." << std::endl;
+                std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+            }
+        }
+    }
+};
+} // namespace db_registry
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::db_registry::SpeedTestDriver>(argc, argv);
+    return 0;
+}
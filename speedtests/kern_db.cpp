@@ -0,0 +1,180 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/temp_file.hpp>
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+#include <miopen/kern_db.hpp>
+#endif
+
+#include <driver.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace kern_db {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(kernels, "kernels");
+        add(kernel_size, "kernel-size");
+        add(blob_path, "blob");
+    }
+
+    void run() const
+    {
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        const auto blob = blob_path.empty() ? MakeBlob() : ReadBlob();
+        std::cout << kernels << " kernels of " << blob.size() << " bytes" << std::endl;
+
+        for(const auto codec : {KernDbCodec::Bzip2, KernDbCodec::Lz, KernDbCodec::None})
+            Test(codec, blob);
+#else
+        std::cerr << "The SQLite kernel cache is disabled in this build." << std::endl;
+        std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+#endif
+    }
+
+    private:
+    int kernels     = 100;
+    int kernel_size = 256 * 1024;
+    std::string blob_path;
+
+    /// Resembles a code object: instructions of a small vocabulary with varying operands,
+    /// separated by zero padding.
+    std::string MakeBlob() const
+    {
+        std::mt19937 rng{42};
+        std::vector<std::uint32_t> opcodes(64);
+        for(auto& opcode : opcodes)
+            opcode = rng() & 0xFFFF0000u;
+
+        const auto size = static_cast<std::size_t>(kernel_size);
+        std::string blob;
+        blob.reserve(size);
+        while(blob.size() < size)
+        {
+            if(rng() % 64 == 0)
+            {
+                blob.append(rng() % 256, '\0');
+                continue;
+            }
+            const auto word = opcodes[rng() % opcodes.size()] | (rng() % 256);
+            blob.append(reinterpret_cast<const char*>(&word), sizeof(word));
+        }
+        blob.resize(size);
+        return blob;
+    }
+
+    std::string ReadBlob() const
+    {
+        std::ifstream file{blob_path, std::ios::binary};
+        if(!file)
+        {
+            std::cerr << "Unable to read " << blob_path << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        return ss.str();
+    }
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    void Test(KernDbCodec codec, const std::string& blob) const
+    {
+        const TempFile db_file{"miopen.speedtest.kern_db"};
+        const auto path = db_file.Path();
+
+        KernelConfig cfg;
+        cfg.kernel_name = "kernel";
+        cfg.kernel_blob = blob;
+
+        const auto store_time = Measure([&]() {
+            KernDb db{path, false, "gfx906", 64, codec};
+            for(auto i = 0; i < kernels; ++i)
+            {
+                cfg.kernel_args = std::to_string(i);
+                db.StoreRecordUnsafe(cfg);
+            }
+        });
+
+        auto mismatches      = 0;
+        const auto load_time = Measure([&]() {
+            KernDb db{path, true, "gfx906", 64, codec};
+            for(auto i = 0; i < kernels; ++i)
+            {
+                cfg.kernel_args    = std::to_string(i);
+                const auto readout = db.FindRecordUnsafe(cfg);
+                if(!readout || *readout != blob)
+                    ++mismatches;
+            }
+        });
+
+        if(mismatches != 0)
+        {
+            std::cerr << ToString(codec) << ": loaded a different kernel." << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        const auto size = boost::filesystem::file_size(path);
+        std::cout << ToString(codec) << ": " << size / 1024 << " KiB on disk ("
+                  << 100. * size / (static_cast<double>(blob.size()) * kernels) << "%), store "
+                  << store_time / kernels << " us/kernel, load " << load_time / kernels
+                  << " us/kernel" << std::endl;
+    }
+#endif
+
+    /// Microseconds spent in f.
+    template <class TFunc>
+    static double Measure(const TFunc& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+};
+
+} // namespace kern_db
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kern_db::SpeedTestDriver>(argc, argv);
+    return 0;
+}
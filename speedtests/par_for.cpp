@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/thread_pool.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace par_for_speedtest {
+
+/// Reproduces the former par_for implementation: a thread per call and static chunks.
+template <class F>
+void LegacyParFor(std::size_t n, std::size_t threadsize, F f)
+{
+    std::vector<std::thread> threads;
+    const auto grainsize = (n + threadsize - 1) / threadsize;
+
+    for(std::size_t start = 0; start < n; start += grainsize)
+    {
+        threads.emplace_back([=]() {
+            const auto last = std::min(n, start + grainsize);
+            for(auto i = start; i < last; ++i)
+                f(i);
+        });
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+}
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(threads, "threads");
+        add(n, "n");
+    }
+
+    void run() const
+    {
+        ThreadPool pool{static_cast<std::size_t>(threads - 1)};
+        const auto size = static_cast<std::size_t>(n);
+
+        // Roughly the work of a reference convolution output element, same for all of them.
+        const auto uniform = [](std::size_t i) { return Work(64, i); };
+        // The first eighth of the iterations takes most of the time, like ragged outputs or
+        // kernels with very different compile times.
+        const auto ragged = [=](std::size_t i) { return Work(i < size / 8 ? 4096 : 64, i); };
+
+        Compare("Uniform", pool, uniform);
+        Compare("Ragged", pool, ragged);
+    }
+
+    private:
+    int iterations = 100;
+    int threads    = 8;
+    int n          = 1024;
+
+    static double Work(int count, std::size_t seed)
+    {
+        auto sum = static_cast<double>(seed);
+        for(auto i = 0; i < count; ++i)
+            sum = std::sqrt(sum + i);
+        return sum;
+    }
+
+    template <class TFunc>
+    void Compare(const std::string& name, ThreadPool& pool, const TFunc& func) const
+    {
+        const auto size = static_cast<std::size_t>(n);
+        std::vector<double> results(size);
+
+        const auto old_time = Measure([&]() {
+            LegacyParFor(size, threads, [&](std::size_t i) { results[i] = func(i); });
+        });
+        const auto new_time = Measure([&]() {
+            pool.ParallelFor(size, threads, [&](std::size_t begin, std::size_t end) {
+                for(auto i = begin; i < end; ++i)
+                    results[i] = func(i);
+            });
+        });
+
+        std::cout << name << ": old " << old_time << " us, new " << new_time << " us, x"
+                  << old_time / new_time << std::endl;
+    }
+
+    /// Returns the average time of a call in microseconds.
+    template <class TFunc>
+    double Measure(const TFunc& func) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for(auto i = 0; i < iterations; ++i)
+            func();
+
+        const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        return time * .001 / iterations;
+    }
+};
+} // namespace par_for_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::par_for_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/problem_key.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+namespace problem_key_speedtest {
+
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(problems, "problems");
+    }
+
+    void run() const
+    {
+        const auto descriptions = MakeProblems();
+
+        // Plain maps on both sides, so that only the keys differ.
+        auto by_config = std::unordered_map<std::string, std::size_t>{};
+        auto by_key    = std::unordered_map<ProblemKey, std::size_t, ProblemKeyHash>{};
+        auto configs   = std::vector<std::string>{};
+        auto keys      = std::vector<ProblemKey>{};
+
+        for(const auto& description : descriptions)
+        {
+            configs.push_back(description.BuildConfKey().ToString());
+            keys.push_back(description.BuildProblemKey());
+            by_config.emplace(configs.back(), configs.size());
+            by_key.emplace(keys.back(), keys.size());
+        }
+
+        std::size_t found = 0;
+
+        Compare(
+            "Key building",
+            [&](std::size_t i) { found += descriptions[i].BuildConfKey().ToString().size(); },
+            [&](std::size_t i) { found += descriptions[i].BuildProblemKey().GetHash() & 1; });
+        Compare(
+            "Map lookup",
+            [&](std::size_t i) { found += by_config.count(configs[i]); },
+            [&](std::size_t i) { found += by_key.count(keys[i]); });
+        Compare(
+            "Both",
+            [&](std::size_t i) { found += by_config.count(descriptions[i].BuildConfKey()); },
+            [&](std::size_t i) { found += by_key.count(descriptions[i].BuildProblemKey()); });
+
+        // Keeps the loops from being optimized out.
+        if(found == 0)
+            std::cout << "Nothing found" << std::endl;
+    }
+
+    private:
+    int iterations = 100;
+    int problems   = 1000;
+
+    std::vector<conv::ProblemDescription> MakeProblems() const
+    {
+        auto ret = std::vector<conv::ProblemDescription>{};
+        ret.reserve(problems);
+
+        for(auto i = 0; i < problems; ++i)
+        {
+            const auto channels = static_cast<std::size_t>(8 + i % 64);
+            const auto size     = static_cast<std::size_t>(7 + i / 64);
+            const auto conv     = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+            const auto in       = TensorDescriptor{miopenFloat, {16, channels, size, size}};
+            const auto weights  = TensorDescriptor{miopenFloat, {64, channels, 3, 3}};
+            const auto out      = conv.GetForwardOutputTensor(in, weights);
+            ret.emplace_back(in, weights, out, conv, conv::Direction::Forward);
+        }
+
+        return ret;
+    }
+
+    void Compare(const std::string& name,
+                 const std::function<void(std::size_t)>& old_func,
+                 const std::function<void(std::size_t)>& new_func) const
+    {
+        const auto old_time = Measure(old_func);
+        const auto new_time = Measure(new_func);
+
+        std::cout << name << ": string " << old_time << " ns, key " << new_time << " ns, x"
+                  << old_time / new_time << std::endl;
+    }
+
+    /// Returns the average time of a call in nanoseconds.
+    double Measure(const std::function<void(std::size_t)>& func) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        for(auto i = 0; i < iterations; ++i)
+            for(auto p = 0; p < problems; ++p)
+                func(p);
+
+        const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        return static_cast<double>(time) / iterations / problems;
+    }
+};
+
+} // namespace problem_key_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::problem_key_speedtest::SpeedTestDriver>(argc, argv);
+    return 0;
+}
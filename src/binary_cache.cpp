@@ -35,17 +35,26 @@
 #include <miopen/version.h>
 #include <miopen/sqlite_db.hpp>
 #include <miopen/kern_db.hpp>
+#include <miopen/mapped_file.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
 
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CUSTOM_CACHE_DIR)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_KERNEL_CACHE_BLOBS)
 
 static boost::filesystem::path ComputeSysCachePath()
 {
@@ -98,7 +107,7 @@ boost::filesystem::path GetCachePath(bool is_system)
     }
 }
 
-static bool IsCacheDisabled()
+bool IsCacheDisabled()
 {
 #ifdef MIOPEN_CACHE_DIR
     if(MIOPEN_DISABLE_USERDB && MIOPEN_DISABLE_SYSDB)
@@ -150,6 +159,133 @@ static inline std::string GetFilenameForInfo2Logging(const bool is_kernel_str,
     return filename;
 }
 
+namespace {
+
+/// Ends each file of the blob store, so that a truncated or damaged file is never loaded.
+struct BlobTrailer
+{
+    std::uint64_t size;
+    std::uint64_t hash;
+    std::uint64_t magic;
+};
+
+constexpr std::uint64_t blob_magic = 0x31424f4c424f494dull; // "MIOBLOB1"
+
+std::uint64_t HashBlob(const char* data, std::size_t size)
+{
+    // FNV-1a
+    auto hash = std::uint64_t{14695981039346656037ull};
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool IsIntactBlob(const MappedFile& file)
+{
+    if(file.Size() < sizeof(BlobTrailer))
+        return false;
+
+    BlobTrailer trailer;
+    std::memcpy(&trailer, file.Data() + file.Size() - sizeof(trailer), sizeof(trailer));
+    return trailer.magic == blob_magic && trailer.size == file.Size() - sizeof(trailer) &&
+           trailer.hash == HashBlob(file.Data(), trailer.size);
+}
+
+void RemoveBlob(const std::string& path)
+{
+    boost::system::error_code ec;
+    boost::filesystem::remove(path, ec);
+    if(ec)
+        MIOPEN_LOG_W("Unable to remove the binary " << path << ": " << ec.message());
+}
+
+} // namespace
+
+/// The blob store keeps an uncompressed copy of each binary of the user cache in a file of its
+/// own, named after the binary's key, so that loading it takes no query and no decompression.
+/// It takes more disk space than the compressed database, so it is used only when enabled.
+static boost::filesystem::path GetBlobFile(const TargetProperties& target,
+                                           const size_t num_cu,
+                                           const std::string& filename,
+                                           const std::string& args)
+{
+    if(!miopen::IsEnabled(MIOPEN_DEBUG_KERNEL_CACHE_BLOBS{}))
+        return {};
+
+    const auto& user_dir = GetCachePath(false);
+    if(user_dir.empty())
+        return {};
+
+    const auto key = Handle::GetDbBasename(target, num_cu) + ":" + filename + ":" + args;
+    return user_dir / "blobs" / (miopen::md5(key) + ".o");
+}
+
+static void SaveBlob(const boost::filesystem::path& path, const std::string& hsaco)
+{
+    if(path.empty())
+        return;
+
+    // Written aside and renamed, so the others never map a partially written file.
+    const auto temp = path.parent_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.tmp");
+    try
+    {
+        boost::filesystem::create_directories(path.parent_path());
+
+        const auto trailer =
+            BlobTrailer{hsaco.size(), HashBlob(hsaco.data(), hsaco.size()), blob_magic};
+        std::ofstream file{temp.string(), std::ios::binary};
+        file.write(hsaco.data(), hsaco.size());
+        file.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+        file.close();
+        if(!file)
+            MIOPEN_THROW("Failed to write to " + temp.string());
+
+        boost::filesystem::rename(temp, path);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to save the binary to " << path << ": " << ex.what());
+        boost::system::error_code ec;
+        boost::filesystem::remove(temp, ec);
+    }
+}
+
+MappedFile MapBinary(const TargetProperties& target,
+                     const size_t num_cu,
+                     const std::string& name,
+                     const std::string& args,
+                     bool is_kernel_str)
+{
+    if(miopen::IsCacheDisabled())
+        return {};
+
+    const std::string filename = (is_kernel_str ? miopen::md5(name) : name) + ".o";
+    const auto path            = GetBlobFile(target, num_cu, filename, args);
+    if(path.empty())
+        return {};
+
+    auto file = MappedFile{path.string()};
+    if(!file.IsValid())
+        return {};
+
+    if(!IsIntactBlob(file))
+    {
+        MIOPEN_LOG_W("Damaged binary removed from the cache: " << path);
+        RemoveBlob(path.string());
+        return {};
+    }
+
+    file.DropTail(sizeof(BlobTrailer));
+    const auto verbose_name = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
+    MIOPEN_LOG_I2("Mapped binary for: " << verbose_name << "; args: " << args);
+    return file;
+}
+
+void RemoveMappedBinary(const MappedFile& file) { RemoveBlob(file.Path()); }
+
 std::string LoadBinary(const TargetProperties& target,
                        const size_t num_cu,
                        const std::string& name,
@@ -170,6 +306,9 @@ std::string LoadBinary(const TargetProperties& target,
     if(record)
     {
         MIOPEN_LOG_I2("Sucessfully loaded binary for: " << verbose_name << "; args: " << args);
+        // The binaries cached before the blob store existed, or found in the system cache, are
+        // mapped next time.
+        SaveBlob(GetBlobFile(target, num_cu, filename, args), record.get());
         return record.get();
     }
     else
@@ -197,6 +336,7 @@ void SaveBinary(const std::string& hsaco,
     const auto verbose_name = GetFilenameForInfo2Logging(is_kernel_str, filename, name);
     MIOPEN_LOG_I2("Saving binary for: " << verbose_name << "; args: " << args);
     db.StoreRecord(cfg);
+    SaveBlob(GetBlobFile(target, num_cu, filename, args), hsaco);
 }
 #else
 boost::filesystem::path LoadBinary(const TargetProperties& target,
@@ -238,4 +378,141 @@ void SaveBinary(const boost::filesystem::path& binary_path,
     }
 }
 #endif
+
+struct CompileClaim::Flight
+{
+    std::mutex mutex;
+    std::condition_variable landed;
+    bool is_landed = false;
+};
+
+struct CompileClaim::Flights
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> in_progress;
+};
+
+namespace {
+
+/// A process that takes longer to build a binary is likely to hang, so it is not waited for.
+constexpr long compile_lock_timeout_s = 300;
+
+} // namespace
+
+CompileClaim::Flights& CompileClaim::GetFlights()
+{
+    static Flights flights;
+    return flights;
+}
+
+std::shared_ptr<CompileClaim::Flight> CompileClaim::Join(const std::string& key, bool& is_first)
+{
+    auto& flights = GetFlights();
+    std::lock_guard<std::mutex> lock(flights.mutex);
+
+    auto& flight = flights.in_progress[key];
+    is_first     = (flight == nullptr);
+    if(is_first)
+        flight = std::make_shared<Flight>();
+    return flight;
+}
+
+void CompileClaim::Leave(const std::string& key)
+{
+    auto& flights = GetFlights();
+    std::lock_guard<std::mutex> lock(flights.mutex);
+    flights.in_progress.erase(key);
+}
+
+CompileClaim::CompileClaim(const TargetProperties& target,
+                           std::size_t num_cu,
+                           const std::string& name,
+                           const std::string& args,
+                           bool is_kernel_str)
+{
+    if(miopen::IsCacheDisabled() || GetCachePath(false).empty())
+        return;
+
+    key = miopen::md5(Handle::GetDbBasename(target, num_cu) + ":" + (is_kernel_str ? "s:" : "f:") +
+                      name + ":" + args);
+
+    bool is_first    = false;
+    const auto other = Join(key, is_first);
+    if(is_first)
+    {
+        flight = other;
+        LockFile(is_kernel_str ? std::string{"kernel string"} : name);
+        return;
+    }
+
+    const auto what = is_kernel_str ? std::string{"kernel string"} : name;
+    MIOPEN_LOG_I2("Waiting for another thread to build " << what);
+    std::unique_lock<std::mutex> lock(other->mutex);
+    if(!other->landed.wait_for(lock, std::chrono::seconds(compile_lock_timeout_s), [&]() {
+           return other->is_landed;
+       }))
+        MIOPEN_LOG_W("Another thread has been building " << what << " for "
+                                                         << compile_lock_timeout_s
+                                                         << " s, building it here as well");
+}
+
+void CompileClaim::LockFile(const std::string& name)
+{
+    try
+    {
+        const auto directory = GetCachePath(false) / "locks";
+        if(!boost::filesystem::exists(directory))
+            boost::filesystem::create_directories(directory);
+
+        // The files are left in place: removing one could let a process lock a file that has
+        // just been unlinked by another one.
+        const auto path = (directory / (key + ".lock")).string();
+        std::ofstream{path, std::ios::app};
+        file_lock = boost::interprocess::file_lock{path.c_str()};
+
+        if(file_lock.try_lock())
+        {
+            file_locked = true;
+            return;
+        }
+
+        MIOPEN_LOG_I2("Waiting for another process to build " << name);
+        file_locked = file_lock.timed_lock(boost::posix_time::microsec_clock::universal_time() +
+                                           boost::posix_time::seconds(compile_lock_timeout_s));
+        if(!file_locked)
+            MIOPEN_LOG_W("Another process has been building " << name << " for "
+                                                              << compile_lock_timeout_s
+                                                              << " s, building it here as well");
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to lock the build of " << name << ": " << ex.what());
+    }
+}
+
+CompileClaim::~CompileClaim()
+{
+    if(file_locked)
+    {
+        try
+        {
+            file_lock.unlock();
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Unable to unlock the build lock file: " << ex.what());
+        }
+    }
+
+    if(flight != nullptr)
+    {
+        Leave(key);
+        {
+            std::lock_guard<std::mutex> lock(flight->mutex);
+            flight->is_landed = true;
+        }
+        flight->landed.notify_all();
+    }
+}
+
 } // namespace miopen
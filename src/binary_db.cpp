@@ -0,0 +1,555 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/binary_db.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+constexpr char binary_db_magic[8]            = {'M', 'I', 'O', 'P', 'E', 'N', 'D', 'B'};
+constexpr std::uint32_t binary_db_version    = 1;
+constexpr std::uint32_t binary_db_byte_order = 0x01020304;
+} // namespace
+
+struct BinaryDb::Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t record_count;
+    std::uint32_t slot_count;
+    std::uint32_t pair_count;
+    std::uint32_t reserved;
+    std::uint64_t slots_offset;
+    std::uint64_t records_offset;
+    std::uint64_t pairs_offset;
+    std::uint64_t strings_offset;
+    std::uint64_t strings_size;
+};
+
+struct BinaryDb::Record
+{
+    std::uint64_t hash;
+    std::uint32_t key_offset;
+    std::uint32_t key_size;
+    std::uint32_t first_pair;
+    std::uint32_t pair_count;
+};
+
+struct BinaryDb::Pair
+{
+    std::uint32_t id_offset;
+    std::uint32_t id_size;
+    std::uint32_t values_offset;
+    std::uint32_t values_size;
+};
+
+BinaryDb::BinaryDb(const std::string& path, bool warn_if_unreadable)
+    : db_path(path), file(path)
+{
+    if(!file.IsValid())
+    {
+        const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                                   ? LoggingLevel::Warning
+                                   : LoggingLevel::Info;
+        MIOPEN_LOG(log_level, "File is unreadable: " << path);
+        return;
+    }
+
+    if(!Open())
+    {
+        MIOPEN_LOG_E("File is not a valid binary db: " << path);
+        header  = nullptr;
+        slots   = nullptr;
+        records = nullptr;
+        pairs   = nullptr;
+        strings = nullptr;
+        return;
+    }
+
+    MIOPEN_LOG_I2("Opened binary db " << path << " with " << header->record_count << " records");
+}
+
+BinaryDb& BinaryDb::GetCached(const std::string& path,
+                              bool warn_if_unreadable,
+                              const std::string& /*arch*/,
+                              const std::size_t /*num_cu*/)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::map<std::string, BinaryDb*>{};
+    const auto it         = instances.find(path);
+
+    if(it != instances.end())
+        return *it->second;
+
+    // The same as ReadonlyRamDb, these objects are small, few and intentionally never deleted.
+    const auto instance = new BinaryDb{path, warn_if_unreadable};
+    instances.emplace(path, instance);
+    return *instance;
+}
+
+std::uint64_t BinaryDb::Hash(boost::string_view key)
+{
+    // FNV-1a
+    auto hash = std::uint64_t{14695981039346656037ull};
+    for(const auto c : key)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::size_t BinaryDb::GetSize() const { return header == nullptr ? 0 : header->record_count; }
+
+bool BinaryDb::Open()
+{
+    static_assert(sizeof(Header) == 72, "Binary db header layout has changed");
+    static_assert(sizeof(Record) == 24, "Binary db record layout has changed");
+    static_assert(sizeof(Pair) == 16, "Binary db pair layout has changed");
+
+    const auto size = static_cast<std::uint64_t>(file.Size());
+    const auto data = file.Data();
+
+    if(size < sizeof(Header))
+        return false;
+
+    header = reinterpret_cast<const Header*>(data);
+
+    if(std::memcmp(header->magic, binary_db_magic, sizeof(binary_db_magic)) != 0)
+        return false;
+    if(header->version != binary_db_version)
+    {
+        MIOPEN_LOG_E("Unsupported binary db version " << header->version << ", expected "
+                                                      << binary_db_version);
+        return false;
+    }
+    if(header->byte_order != binary_db_byte_order)
+        return false;
+
+    const auto fits = [&](std::uint64_t offset, std::uint64_t count, std::uint64_t item_size) {
+        return offset % alignof(std::uint64_t) == 0 && offset <= size &&
+               count <= (size - offset) / item_size;
+    };
+
+    const auto slot_count = header->slot_count;
+    if(slot_count <= header->record_count || (slot_count & (slot_count - 1)) != 0 ||
+       !fits(header->slots_offset, slot_count, sizeof(std::uint32_t)) ||
+       !fits(header->records_offset, header->record_count, sizeof(Record)) ||
+       !fits(header->pairs_offset, header->pair_count, sizeof(Pair)) ||
+       !fits(header->strings_offset, header->strings_size, 1))
+        return false;
+
+    slots   = reinterpret_cast<const std::uint32_t*>(data + header->slots_offset);
+    records = reinterpret_cast<const Record*>(data + header->records_offset);
+    pairs   = reinterpret_cast<const Pair*>(data + header->pairs_offset);
+    strings = data + header->strings_offset;
+
+    // Checking all the references once is linear in the number of records and allows lookups to
+    // trust the file.
+    const auto string_fits = [&](std::uint32_t offset, std::uint32_t length) {
+        return offset <= header->strings_size && length <= header->strings_size - offset;
+    };
+
+    for(auto i = std::uint32_t{0}; i < slot_count; ++i)
+        if(slots[i] > header->record_count)
+            return false;
+
+    for(auto i = std::uint32_t{0}; i < header->record_count; ++i)
+    {
+        const auto& record = records[i];
+        if(!string_fits(record.key_offset, record.key_size) ||
+           record.first_pair > header->pair_count ||
+           record.pair_count > header->pair_count - record.first_pair)
+            return false;
+    }
+
+    for(auto i = std::uint32_t{0}; i < header->pair_count; ++i)
+    {
+        const auto& pair = pairs[i];
+        if(!string_fits(pair.id_offset, pair.id_size) ||
+           !string_fits(pair.values_offset, pair.values_size))
+            return false;
+    }
+
+    return true;
+}
+
+boost::string_view BinaryDb::GetString(std::uint32_t offset, std::uint32_t size) const
+{
+    return {strings + offset, size};
+}
+
+const BinaryDb::Record* BinaryDb::Find(boost::string_view key) const
+{
+    if(header == nullptr)
+        return nullptr;
+
+    const auto hash = Hash(key);
+    const auto mask = header->slot_count - 1;
+    auto slot       = static_cast<std::uint32_t>(hash) & mask;
+
+    for(auto probe = std::uint32_t{0}; probe < header->slot_count; ++probe)
+    {
+        if(slots[slot] == 0)
+            return nullptr;
+
+        const auto& record = records[slots[slot] - 1];
+        if(record.hash == hash && GetString(record.key_offset, record.key_size) == key)
+            return &record;
+
+        slot = (slot + 1) & mask;
+    }
+
+    return nullptr;
+}
+
+boost::optional<DbRecord> BinaryDb::FindRecord(const std::string& problem) const
+{
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+    const auto record = Find(problem);
+
+    if(record == nullptr)
+        return boost::none;
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+    auto ret = DbRecord{problem};
+
+    for(auto i = record->first_pair; i < record->first_pair + record->pair_count; ++i)
+    {
+        const auto& pair = pairs[i];
+        ret.Emplace(GetString(pair.id_offset, pair.id_size),
+                    GetString(pair.values_offset, pair.values_size));
+    }
+
+    return ret;
+}
+
+bool BinaryDb::FindValues(const std::string& problem,
+                          const std::string& id,
+                          std::string& values) const
+{
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+    const auto record = Find(problem);
+
+    if(record == nullptr)
+        return false;
+
+    for(auto i = record->first_pair; i < record->first_pair + record->pair_count; ++i)
+    {
+        const auto& pair = pairs[i];
+        if(GetString(pair.id_offset, pair.id_size) != id)
+            continue;
+
+        values = GetString(pair.values_offset, pair.values_size).to_string();
+        MIOPEN_LOG_I(problem << '=' << id << ':' << values);
+        return true;
+    }
+
+    MIOPEN_LOG_I(problem << '=' << id << ':' << "<values not found>");
+    return false;
+}
+
+namespace {
+struct TextRecord
+{
+    boost::string_view key;
+    std::vector<std::pair<boost::string_view, boost::string_view>> pairs;
+};
+
+/// Calls func(key, contents, line) for the first occurrence of every well-formed key.
+template <class TFunc>
+void ForEachTextRecord(const char* begin, const char* end, const std::string& path, TFunc&& func)
+{
+    auto keys   = std::unordered_set<std::string>{};
+    auto n_line = 0;
+
+    for(auto line_begin = begin; line_begin < end;)
+    {
+        ++n_line;
+
+        const auto eol =
+            static_cast<const char*>(std::memchr(line_begin, '\n', end - line_begin));
+        const auto line_end = eol == nullptr ? end : eol;
+        const auto line     = boost::string_view(line_begin, line_end - line_begin);
+        line_begin          = eol == nullptr ? end : eol + 1;
+
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == boost::string_view::npos || key_size == 0)
+        {
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#" << n_line);
+            continue;
+        }
+
+        const auto key = line.substr(0, key_size);
+        if(!keys.insert(key.to_string()).second)
+        {
+            MIOPEN_LOG_W("Duplicate key (ignored): " << key << ": " << path << "#" << n_line);
+            continue;
+        }
+
+        func(key, line.substr(key_size + 1), n_line);
+    }
+}
+} // namespace
+
+bool BinaryDb::Convert(const std::string& text_path, const std::string& binary_path)
+{
+    const MappedFile text{text_path};
+    if(!text.IsValid())
+    {
+        MIOPEN_LOG_E("File is unreadable: " << text_path);
+        return false;
+    }
+
+    auto text_records = std::vector<TextRecord>{};
+    auto pair_count   = std::size_t{0};
+
+    ForEachTextRecord(
+        text.Data(),
+        text.Data() + text.Size(),
+        text_path,
+        [&](boost::string_view key, boost::string_view contents, int n_line) {
+            auto record = TextRecord{key, {}};
+
+            // Same rules as DbRecord::ParseContents(): empty VALUES is ok, empty ID is not, the
+            // first pair with an ID wins.
+            while(!contents.empty())
+            {
+                const auto pair_size = std::min(contents.find(';'), contents.size());
+                const auto pair      = contents.substr(0, pair_size);
+                contents.remove_prefix(std::min(pair_size + 1, contents.size()));
+
+                const auto id_size = pair.find(':');
+                if(id_size == boost::string_view::npos)
+                {
+                    MIOPEN_LOG_E("Ill-formed file: ID not found; skipped; key: " << key);
+                    continue;
+                }
+
+                const auto id     = pair.substr(0, id_size);
+                const auto values = pair.substr(id_size + 1);
+
+                const auto is_same_id = [&](const auto& p) { return p.first == id; };
+
+                if(std::any_of(record.pairs.begin(), record.pairs.end(), is_same_id))
+                {
+                    MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << key);
+                    continue;
+                }
+
+                record.pairs.emplace_back(id, values);
+            }
+
+            if(record.pairs.empty())
+            {
+                MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file "
+                                                                     << text_path << "#"
+                                                                     << n_line);
+                return;
+            }
+
+            pair_count += record.pairs.size();
+            text_records.push_back(std::move(record));
+        });
+
+    if(text_records.size() >= std::numeric_limits<std::uint32_t>::max() / 2 ||
+       pair_count >= std::numeric_limits<std::uint32_t>::max())
+    {
+        MIOPEN_LOG_E("Too many records in " << text_path);
+        return false;
+    }
+
+    std::sort(text_records.begin(), text_records.end(), [](const auto& l, const auto& r) {
+        return l.key < r.key;
+    });
+
+    // Strings are deduplicated, IDs repeat a lot.
+    auto string_blob    = std::string{};
+    auto string_offsets = std::unordered_map<std::string, std::uint32_t>{};
+
+    const auto add_string = [&](boost::string_view str) {
+        const auto inserted =
+            string_offsets.emplace(str.to_string(), static_cast<std::uint32_t>(string_blob.size()));
+        if(inserted.second)
+            string_blob.append(str.data(), str.size());
+        return inserted.first->second;
+    };
+
+    auto slot_count = std::size_t{16};
+    while(slot_count < text_records.size() * 2)
+        slot_count *= 2;
+
+    auto slots_out   = std::vector<std::uint32_t>(slot_count, 0);
+    auto records_out = std::vector<Record>{};
+    auto pairs_out   = std::vector<Pair>{};
+    records_out.reserve(text_records.size());
+    pairs_out.reserve(pair_count);
+
+    for(const auto& text_record : text_records)
+    {
+        auto record       = Record{};
+        record.hash       = Hash(text_record.key);
+        record.key_offset = add_string(text_record.key);
+        record.key_size   = static_cast<std::uint32_t>(text_record.key.size());
+        record.first_pair = static_cast<std::uint32_t>(pairs_out.size());
+        record.pair_count = static_cast<std::uint32_t>(text_record.pairs.size());
+
+        for(const auto& pair : text_record.pairs)
+        {
+            auto out          = Pair{};
+            out.id_offset     = add_string(pair.first);
+            out.id_size       = static_cast<std::uint32_t>(pair.first.size());
+            out.values_offset = add_string(pair.second);
+            out.values_size   = static_cast<std::uint32_t>(pair.second.size());
+            pairs_out.push_back(out);
+        }
+
+        auto slot = static_cast<std::uint32_t>(record.hash) & (slot_count - 1);
+        while(slots_out[slot] != 0)
+            slot = (slot + 1) & (slot_count - 1);
+
+        records_out.push_back(record);
+        slots_out[slot] = static_cast<std::uint32_t>(records_out.size());
+
+        if(string_blob.size() >= std::numeric_limits<std::uint32_t>::max())
+        {
+            MIOPEN_LOG_E("Too much data in " << text_path);
+            return false;
+        }
+    }
+
+    auto header = Header{};
+    std::memcpy(header.magic, binary_db_magic, sizeof(binary_db_magic));
+    header.version        = binary_db_version;
+    header.byte_order     = binary_db_byte_order;
+    header.record_count   = static_cast<std::uint32_t>(records_out.size());
+    header.slot_count     = static_cast<std::uint32_t>(slot_count);
+    header.pair_count     = static_cast<std::uint32_t>(pairs_out.size());
+    header.slots_offset   = sizeof(Header);
+    header.records_offset = header.slots_offset + slots_out.size() * sizeof(std::uint32_t);
+    header.pairs_offset   = header.records_offset + records_out.size() * sizeof(Record);
+    header.strings_offset = header.pairs_offset + pairs_out.size() * sizeof(Pair);
+    header.strings_size   = string_blob.size();
+
+    const auto temp_name = binary_path + ".temp";
+
+    {
+        std::ofstream out(temp_name, std::ios::binary);
+        const auto write = [&](const void* data, std::size_t size) {
+            out.write(static_cast<const char*>(data), size);
+        };
+
+        write(&header, sizeof(header));
+        write(slots_out.data(), slots_out.size() * sizeof(std::uint32_t));
+        write(records_out.data(), records_out.size() * sizeof(Record));
+        write(pairs_out.data(), pairs_out.size() * sizeof(Pair));
+        write(string_blob.data(), string_blob.size());
+
+        if(!out)
+        {
+            MIOPEN_LOG_E("Error writing to temp file: " << temp_name);
+            std::remove(temp_name.c_str());
+            return false;
+        }
+    }
+
+    if(std::rename(temp_name.c_str(), binary_path.c_str()) != 0)
+    {
+        MIOPEN_LOG_E("Unable to replace " << binary_path << " with " << temp_name);
+        std::remove(temp_name.c_str());
+        return false;
+    }
+
+    MIOPEN_LOG_I("Converted " << records_out.size() << " records from " << text_path << " to "
+                              << binary_path);
+    return true;
+}
+
+bool BinaryDb::Verify(const std::string& text_path, const std::string& binary_path)
+{
+    const MappedFile text{text_path};
+    const BinaryDb db{binary_path};
+
+    if(!text.IsValid() || !db.IsValid())
+        return false;
+
+    auto ok      = true;
+    auto records = std::size_t{0};
+
+    // The text side is parsed by DbRecord, independently of Convert().
+    ForEachTextRecord(text.Data(),
+                      text.Data() + text.Size(),
+                      text_path,
+                      [&](boost::string_view key, boost::string_view contents, int n_line) {
+                          auto expected       = DbRecord{key.to_string()};
+                          const auto is_valid = expected.ParseContents(contents);
+                          const auto actual   = db.FindRecord(expected.GetKey());
+
+                          if(is_valid)
+                              ++records;
+
+                          if(is_valid == actual.is_initialized() &&
+                             (!is_valid || actual->HasSameContents(expected)))
+                              return;
+
+                          MIOPEN_LOG_E("Binary db " << binary_path << " does not match "
+                                                    << text_path << "#" << n_line);
+                          ok = false;
+                      });
+
+    if(records != db.GetSize())
+    {
+        MIOPEN_LOG_E("Binary db " << binary_path << " has " << db.GetSize() << " records, "
+                                  << text_path << " has " << records);
+        ok = false;
+    }
+
+    return ok;
+}
+
+} // namespace miopen
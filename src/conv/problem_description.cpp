@@ -30,6 +30,7 @@
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include <miopen/tensor_layout.hpp>
 
+#include <array>
 #include <sstream>
 
 namespace miopen {
@@ -83,44 +84,134 @@ void ProblemDescription::HeuristicUpdateLayouts()
     // If we did not find consistent layout, leave them as-is
 }
 
-void ProblemDescription::BuildConfKey(std::string& conf_key) const
+namespace {
+
+enum ConfKeyField
 {
-    std::ostringstream ss;
-
-    ss << GetInChannels();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetInDepth(), GetInHeight(), GetInWidth());
-    ss << 'x'
-       << PrintDHW('x', GetSpatialDims(), GetWeightsDepth(), GetWeightsHeight(), GetWeightsWidth());
-    ss << 'x' << GetOutChannels();
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetOutDepth(), GetOutHeight(), GetOutWidth());
-    ss << 'x' << GetInBatchSize();
-    if((GetInLayout() == "NCHW" && GetWeightsLayout() == "NCHW" && GetOutLayout() == "NCHW") ||
-       (GetInLayout() == "NCDHW" && GetWeightsLayout() == "NCDHW" && GetOutLayout() == "NCDHW"))
+    SpatialDims,
+    InChannels,
+    InDepth,
+    InHeight,
+    InWidth,
+    WeightsDepth,
+    WeightsHeight,
+    WeightsWidth,
+    OutChannels,
+    OutDepth,
+    OutHeight,
+    OutWidth,
+    BatchSize,
+    InLayout,
+    WeightsLayout,
+    OutLayout,
+    InDataType,
+    WeightsDataType,
+    OutDataType,
+    PadD,
+    PadH,
+    PadW,
+    StrideD,
+    StrideH,
+    StrideW,
+    DilationD,
+    DilationH,
+    DilationW,
+    GroupCount,
+    ConvDirection,
+    ConfKeyFieldsCount,
+};
+
+void FormatConfKey(std::ostream& ss, const ProblemKey::Field* f)
+{
+    const auto dims    = static_cast<int>(f[SpatialDims]);
+    const auto in      = ProblemKey::UnpackString(f[InLayout]);
+    const auto weights = ProblemKey::UnpackString(f[WeightsLayout]);
+    const auto out     = ProblemKey::UnpackString(f[OutLayout]);
+
+    const auto type = [&](ConfKeyField field) { return static_cast<miopenDataType_t>(f[field]); };
+    // The depth, height and width fields follow each other.
+    const auto dhw = [&](ConfKeyField depth) {
+        return PrintDHW('x',
+                        dims,
+                        static_cast<int>(f[depth]),
+                        static_cast<int>(f[depth + 1]),
+                        static_cast<int>(f[depth + 2]));
+    };
+
+    ss << f[InChannels];
+    ss << 'x' << dhw(InDepth);
+    ss << 'x' << dhw(WeightsDepth);
+    ss << 'x' << f[OutChannels];
+    ss << 'x' << dhw(OutDepth);
+    ss << 'x' << f[BatchSize];
+    if((in == "NCHW" && weights == "NCHW" && out == "NCHW") ||
+       (in == "NCDHW" && weights == "NCDHW" && out == "NCDHW"))
     {
-        ss << 'x' << GetInLayout();
+        ss << 'x' << in;
     }
     else
     {
-        ss << 'x' << GetInLayout();
-        ss << 'x' << GetWeightsLayout();
-        ss << 'x' << GetOutLayout();
+        ss << 'x' << in;
+        ss << 'x' << weights;
+        ss << 'x' << out;
     }
-    ss << 'x' << EncodeDataTypesForKey(GetInDataType(), GetWeightsDataType(), GetOutDataType());
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetPadD(), GetPadH(), GetPadW());
-    ss << 'x'
-       << PrintDHW(
-              'x', GetSpatialDims(), GetKernelStrideD(), GetKernelStrideH(), GetKernelStrideW());
-    ss << 'x' << PrintDHW('x', GetSpatialDims(), GetDilationD(), GetDilationH(), GetDilationW());
-    ss << 'x' << GetGroupCount();
+    ss << 'x' << EncodeDataTypesForKey(type(InDataType), type(WeightsDataType), type(OutDataType));
+    ss << 'x' << dhw(PadD);
+    ss << 'x' << dhw(StrideD);
+    ss << 'x' << dhw(DilationD);
+    ss << 'x' << f[GroupCount];
 
-    switch(GetDirection())
+    switch(static_cast<Direction>(f[ConvDirection]))
     {
     case Direction::Forward: ss << 'x' << "F"; break;
     case Direction::BackwardData: ss << 'x' << "B"; break;
     case Direction::BackwardWeights: ss << 'x' << "W"; break;
     }
+}
 
-    conf_key = ss.str();
+} // namespace
+
+ProblemKey ProblemDescription::BuildProblemKey() const
+{
+    auto f = std::array<ProblemKey::Field, ConfKeyFieldsCount>{};
+
+    f[SpatialDims]     = GetSpatialDims();
+    f[InChannels]      = GetInChannels();
+    f[InDepth]         = GetInDepth();
+    f[InHeight]        = GetInHeight();
+    f[InWidth]         = GetInWidth();
+    f[WeightsDepth]    = GetWeightsDepth();
+    f[WeightsHeight]   = GetWeightsHeight();
+    f[WeightsWidth]    = GetWeightsWidth();
+    f[OutChannels]     = GetOutChannels();
+    f[OutDepth]        = GetOutDepth();
+    f[OutHeight]       = GetOutHeight();
+    f[OutWidth]        = GetOutWidth();
+    f[BatchSize]       = GetInBatchSize();
+    f[InLayout]        = ProblemKey::PackString(in_layout);
+    f[WeightsLayout]   = ProblemKey::PackString(weights_layout);
+    f[OutLayout]       = ProblemKey::PackString(out_layout);
+    f[InDataType]      = GetInDataType();
+    f[WeightsDataType] = GetWeightsDataType();
+    f[OutDataType]     = GetOutDataType();
+    f[PadD]            = GetPadD();
+    f[PadH]            = GetPadH();
+    f[PadW]            = GetPadW();
+    f[StrideD]         = GetKernelStrideD();
+    f[StrideH]         = GetKernelStrideH();
+    f[StrideW]         = GetKernelStrideW();
+    f[DilationD]       = GetDilationD();
+    f[DilationH]       = GetDilationH();
+    f[DilationW]       = GetDilationW();
+    f[GroupCount]      = GetGroupCount();
+    f[ConvDirection]   = static_cast<ProblemKey::Field>(GetDirection());
+
+    return {&FormatConfKey, f};
+}
+
+void ProblemDescription::BuildConfKey(std::string& conf_key) const
+{
+    conf_key = BuildProblemKey().ToString();
 }
 
 void ProblemDescription::Serialize(std::ostream& stream) const
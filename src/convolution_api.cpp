@@ -31,6 +31,7 @@
 #include <miopen/find_controls.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/prepared_convolution.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <algorithm>
 
@@ -1024,6 +1025,72 @@ miopenConvolutionBackwardWeightsImmediate(miopenHandle_t handle,
     });
 }
 
+static miopen::conv::Direction ConvDirectionFromApi(miopenConvDirection_t direction)
+{
+    switch(direction)
+    {
+    case miopenConvDirectionForward: return miopen::conv::Direction::Forward;
+    case miopenConvDirectionBackwardData: return miopen::conv::Direction::BackwardData;
+    case miopenConvDirectionBackwardWeights: return miopen::conv::Direction::BackwardWeights;
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Invalid convolution direction");
+}
+
+extern "C" miopenStatus_t
+miopenCreatePreparedConvolution(miopenHandle_t handle,
+                                miopenPreparedConvolution_t* prepared,
+                                miopenConvDirection_t direction,
+                                const miopenTensorDescriptor_t wDesc,
+                                const miopenTensorDescriptor_t xDesc,
+                                const miopenConvolutionDescriptor_t convDesc,
+                                const miopenTensorDescriptor_t yDesc,
+                                const uint64_t solution_id)
+{
+    MIOPEN_LOG_FUNCTION(handle, prepared, direction, wDesc, xDesc, convDesc, yDesc, solution_id);
+    LogCmdConvolution(xDesc,
+                      wDesc,
+                      convDesc,
+                      yDesc,
+                      direction == miopenConvDirectionForward        ? ConvDirection::Fwd
+                      : direction == miopenConvDirectionBackwardData ? ConvDirection::Bwd
+                                                                     : ConvDirection::WrW,
+                      true);
+    return miopen::try_([&] {
+        miopen::deref(prepared) = new miopen::PreparedConvolution(miopen::deref(handle),
+                                                                  miopen::deref(convDesc),
+                                                                  ConvDirectionFromApi(direction),
+                                                                  miopen::deref(wDesc),
+                                                                  miopen::deref(xDesc),
+                                                                  miopen::deref(yDesc),
+                                                                  solution_id);
+    });
+}
+
+extern "C" miopenStatus_t miopenRunPreparedConvolution(miopenHandle_t handle,
+                                                       const miopenPreparedConvolution_t prepared,
+                                                       void* w,
+                                                       void* x,
+                                                       void* y,
+                                                       void* workSpace,
+                                                       size_t workSpaceSize)
+{
+    MIOPEN_LOG_FUNCTION(handle, prepared, w, x, y, workSpace, workSpaceSize);
+    return miopen::try_([&] {
+        miopen::deref(prepared).Run(miopen::deref(handle),
+                                    DataCast(w),
+                                    DataCast(x),
+                                    DataCast(y),
+                                    DataCast(workSpace),
+                                    workSpaceSize);
+    });
+}
+
+extern "C" miopenStatus_t miopenDestroyPreparedConvolution(miopenPreparedConvolution_t prepared)
+{
+    MIOPEN_LOG_FUNCTION(prepared);
+    return miopen::try_([&] { miopen_destroy_object(prepared); });
+}
+
 extern "C" miopenStatus_t
 miopenFindConvolutionBackwardDataAlgorithm(miopenHandle_t handle,
                                            const miopenTensorDescriptor_t dyDesc,
@@ -25,9 +25,11 @@
  *******************************************************************************/
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/mapped_file.hpp>
 #include <miopen/md5.hpp>
 
 #include <boost/date_time/posix_time/posix_time_types.hpp>
@@ -40,13 +42,22 @@
 #include <cassert>
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <future>
 #include <ios>
+#include <map>
 #include <mutex>
 #include <shared_mutex>
+#include <sstream>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DB_JOURNAL)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DB_JOURNAL_COMPACTION_THRESHOLD)
+
 namespace miopen {
 
 struct RecordPositions
@@ -54,6 +65,318 @@ struct RecordPositions
     std::streamoff begin = -1;
     std::streamoff end   = -1;
 };
+
+/// Maps keys of a plain text db file to the positions of respective records in the file.
+/// The file is memory-mapped and indexed once, and re-indexed only after it changes on disk,
+/// so lookups do not need to scan the file. Shared by all PlainTextDb instances working with
+/// the same file. Callers are responsible for holding the db LockFile, this class only
+/// guarantees MT-safety of the index itself.
+///
+/// The file may also contain a journal: records appended after the original record with the
+/// same key. The last record with a key wins, and a record with empty contents removes the key.
+/// Superseded records are dropped by the compaction which rewrites the file.
+class PlainTextDbIndex
+{
+    private:
+    class PassKey
+    {
+    };
+
+    public:
+    struct Item
+    {
+        std::size_t begin;         // Beginning of the line.
+        std::size_t end;           // Beginning of the next line.
+        std::size_t content_begin; // Just after the '='.
+        std::size_t content_end;   // Just before the line break.
+        int line;
+    };
+
+    enum class FindResult
+    {
+        Unreadable,
+        NotFound,
+        Found,
+    };
+
+    PlainTextDbIndex(const std::string& path_, PassKey) : path(path_) {}
+    PlainTextDbIndex(const PlainTextDbIndex&) = delete;
+    PlainTextDbIndex& operator=(const PlainTextDbIndex&) = delete;
+
+    ~PlainTextDbIndex()
+    {
+        if(compaction.valid())
+            compaction.wait();
+    }
+
+    static PlainTextDbIndex& Get(const std::string& path)
+    {
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static std::mutex mutex;
+        const std::lock_guard<std::mutex> lock(mutex);
+
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static std::map<std::string, PlainTextDbIndex> instances;
+
+        const auto found = instances.find(path);
+        if(found != instances.end())
+            return found->second;
+
+        return instances
+            .emplace(std::piecewise_construct,
+                     std::forward_as_tuple(path),
+                     std::forward_as_tuple(path, PassKey{}))
+            .first->second;
+    }
+
+    /// Looks up the key in the up-to-date index of the file and copies out contents of the record.
+    FindResult Find(const std::string& key, Item& item, std::string& contents)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        Refresh();
+
+        if(!file.IsValid())
+            return FindResult::Unreadable;
+
+        const auto found = items.find(key);
+        if(found == items.end())
+            return FindResult::NotFound;
+
+        item     = found->second;
+        contents = std::string(file.Data() + item.content_begin, file.Data() + item.content_end);
+        return FindResult::Found;
+    }
+
+    /// Appends a record line (including the line break) to the end of the file and updates the
+    /// index accordingly, thus avoiding a re-indexing of the whole file.
+    bool Append(const std::string& key, const std::string& line)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        Refresh();
+
+        const auto offset = file.Size();
+        // Do not glue the record to the last line if the file misses the trailing line break.
+        const auto prefix = (offset != 0 && file.Data()[offset - 1] != '\n') ? 1 : 0;
+
+        {
+            std::ofstream out(path, std::ios::app | std::ios::binary);
+
+            if(!out)
+            {
+                MIOPEN_LOG_E("File is unwritable: " << path);
+                return false;
+            }
+
+            if(prefix != 0)
+                out << '\n';
+            out << line;
+
+            if(!out.flush())
+            {
+                MIOPEN_LOG_E("Error writing to file: " << path);
+                Reset();
+                return false;
+            }
+        }
+
+        const auto begin = offset + prefix;
+        auto updated     = MappedFile{path};
+
+        if(!updated.IsValid() || updated.Size() != begin + line.size())
+        {
+            // Somebody have been writing at the same time or the write was partial.
+            Reset();
+            return true;
+        }
+
+        file = std::move(updated);
+        AddItem(key, Item{begin, file.Size(), begin + key.size() + 1, file.Size() - 1, ++lines});
+        return true;
+    }
+
+    /// Drops the index. Shall be called after the file has been rewritten by this process.
+    void Invalidate()
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        Reset();
+    }
+
+    /// Returns true if superseded records take too much of the file.
+    bool NeedsCompaction()
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        const auto live = file.Size() - superseded;
+        return superseded > std::max<std::size_t>(GetCompactionThreshold(), live);
+    }
+
+    /// Rewrites the file keeping only the actual record for each key.
+    bool CompactUnsafe()
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        Refresh();
+
+        if(!file.IsValid() || superseded == 0)
+            return true;
+
+        MIOPEN_LOG_I("Compacting file " << path << ", " << superseded << " of " << file.Size()
+                                        << " bytes superseded");
+
+        auto live = std::vector<const Item*>{};
+        live.reserve(items.size());
+        for(const auto& item : items)
+            live.push_back(&item.second);
+        std::sort(live.begin(), live.end(), [](auto l, auto r) { return l->begin < r->begin; });
+
+        const auto temp_name = path + ".temp";
+
+        {
+            std::ofstream to(temp_name, std::ios::binary);
+
+            if(!to)
+            {
+                MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+                return false;
+            }
+
+            for(const auto item : live)
+                to.write(file.Data() + item->begin, item->content_end - item->begin) << '\n';
+
+            if(!to.flush())
+            {
+                MIOPEN_LOG_E("Error writing to temp file: " << temp_name);
+                std::remove(temp_name.c_str());
+                return false;
+            }
+        }
+
+        Reset();
+
+        if(std::rename(temp_name.c_str(), path.c_str()) != 0)
+        {
+            MIOPEN_LOG_E("Unable to replace " << path << " with " << temp_name);
+            std::remove(temp_name.c_str());
+            return false;
+        }
+
+        boost::filesystem::permissions(path, boost::filesystem::all_all);
+        return true;
+    }
+
+    /// Runs the compaction in a background thread unless one is in flight already.
+    void ScheduleCompaction(LockFile& lock_file)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+
+        if(compaction.valid() &&
+           compaction.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+            return;
+
+        compaction = std::async(std::launch::async, [this, &lock_file]() {
+            try
+            {
+                const auto db_lock = std::unique_lock<LockFile>(lock_file, GetLockTimeout());
+                if(db_lock)
+                    CompactUnsafe();
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_E("Compaction of " << path << " has failed: " << ex.what());
+            }
+        });
+    }
+
+    static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+
+    private:
+    std::string path;
+    std::mutex mutex;
+    bool is_actual = false;
+    MappedFile file;
+    std::unordered_map<std::string, Item> items;
+    std::size_t superseded = 0;
+    int lines              = 0;
+    std::future<void> compaction;
+
+    static std::size_t GetCompactionThreshold()
+    {
+        return Value(MIOPEN_DEBUG_DB_JOURNAL_COMPACTION_THRESHOLD{}, 64 * 1024);
+    }
+
+    void Reset()
+    {
+        is_actual = false;
+        file      = MappedFile{};
+        items.clear();
+        superseded = 0;
+        lines      = 0;
+    }
+
+    void Refresh()
+    {
+        if(!is_actual || file.IsOutdated())
+            Build();
+    }
+
+    void AddItem(const std::string& key, const Item& item)
+    {
+        const auto found = items.find(key);
+
+        if(found != items.end())
+        {
+            superseded += found->second.end - found->second.begin;
+            items.erase(found);
+        }
+
+        // Empty contents mean that the record has been removed.
+        if(item.content_begin == item.content_end)
+            superseded += item.end - item.begin;
+        else
+            items.emplace(key, item);
+    }
+
+    void Build()
+    {
+        Reset();
+        file      = MappedFile{path};
+        is_actual = true;
+
+        if(!file.IsValid())
+            return;
+
+        MIOPEN_LOG_I2("Indexing file " << path);
+
+        const auto data = file.Data();
+        const auto size = file.Size();
+        auto begin      = std::size_t{0};
+
+        while(begin < size)
+        {
+            ++lines;
+            const auto line_begin = begin;
+            const auto eol =
+                static_cast<const char*>(std::memchr(data + line_begin, '\n', size - line_begin));
+            const auto line_end = eol == nullptr ? size : static_cast<std::size_t>(eol - data);
+            begin               = eol == nullptr ? size : line_end + 1;
+
+            const auto eq = static_cast<const char*>(
+                std::memchr(data + line_begin, '=', line_end - line_begin));
+
+            if(eq == nullptr || eq == data + line_begin)
+            {
+                if(line_end != line_begin) // Do not blame empty lines.
+                    MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#" << lines);
+                superseded += begin - line_begin;
+                continue;
+            }
+
+            const auto key           = std::string(data + line_begin, eq);
+            const auto content_begin = static_cast<std::size_t>(eq + 1 - data);
+
+            AddItem(key, Item{line_begin, begin, content_begin, line_end, lines});
+        }
+    }
+};
+
 /// This makes the interface for the MultiFileDb uniform and
 /// allows reusing it for the SQLite perfdb and the kernel cache.
 PlainTextDb::PlainTextDb(const std::string& filename_,
@@ -67,6 +390,7 @@ PlainTextDb::PlainTextDb(const std::string& filename_,
 PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
     : filename(filename_),
       lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
+      index(PlainTextDbIndex::Get(filename_)),
       warn_if_unreadable(is_system)
 {
     if(!is_system)
@@ -91,7 +415,7 @@ PlainTextDb::PlainTextDb(const std::string& filename_, bool is_system)
             MIOPEN_THROW("Db lock has failed to lock."); \
     } while(false)
 
-static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+static std::chrono::seconds GetLockTimeout() { return PlainTextDbIndex::GetLockTimeout(); }
 
 using exclusive_lock = std::unique_lock<LockFile>;
 using shared_lock    = std::shared_lock<LockFile>;
@@ -107,21 +431,27 @@ bool PlainTextDb::StoreRecord(const DbRecord& record)
 {
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    return StoreRecordUnsafe(record);
+    const auto ret = StoreRecordUnsafe(record);
+    ScheduleCompactionIfNeeded();
+    return ret;
 }
 
 bool PlainTextDb::UpdateRecord(DbRecord& record)
 {
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    return UpdateRecordUnsafe(record);
+    const auto ret = UpdateRecordUnsafe(record);
+    ScheduleCompactionIfNeeded();
+    return ret;
 }
 
 bool PlainTextDb::RemoveRecord(const std::string& key)
 {
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    return RemoveRecordUnsafe(key);
+    const auto ret = RemoveRecordUnsafe(key);
+    ScheduleCompactionIfNeeded();
+    return ret;
 }
 
 bool PlainTextDb::Remove(const std::string& key, const std::string& id)
@@ -134,7 +464,22 @@ bool PlainTextDb::Remove(const std::string& key, const std::string& id)
     bool erased = record->EraseValues(id);
     if(!erased)
         return false;
-    return StoreRecordUnsafe(*record);
+    const auto ret = StoreRecordUnsafe(*record);
+    ScheduleCompactionIfNeeded();
+    return ret;
+}
+
+bool PlainTextDb::Compact()
+{
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return index.CompactUnsafe();
+}
+
+void PlainTextDb::ScheduleCompactionIfNeeded()
+{
+    if(index.NeedsCompaction())
+        index.ScheduleCompaction(lock_file);
 }
 
 boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
@@ -148,74 +493,42 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
 
     MIOPEN_LOG_I2("Looking for key " << key << " in file " << filename);
 
-    std::ifstream file(filename);
+    auto item     = PlainTextDbIndex::Item{};
+    auto contents = std::string{};
 
-    if(!file)
+    switch(index.Find(key, item, contents))
     {
+    case PlainTextDbIndex::FindResult::Unreadable:
         if(warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
             MIOPEN_LOG_W("File is unreadable: " << filename);
         else
             MIOPEN_LOG_I2("File is unreadable: " << filename);
-
         return boost::none;
+    case PlainTextDbIndex::FindResult::NotFound:
+        // Record was not found
+        return boost::none;
+    case PlainTextDbIndex::FindResult::Found: break;
     }
 
-    int n_line = 0;
-    while(true)
-    {
-        std::string line;
-        const auto line_begin = file.tellg();
-        if(!std::getline(file, line))
-            break;
-        ++n_line;
-        const auto next_line_begin = file.tellg();
-
-        const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
-        if(!is_key)
-        {
-            if(!line.empty()) // Do not blame empty lines.
-            {
-                MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "#" << n_line);
-            }
-            continue;
-        }
-        const auto current_key = line.substr(0, key_size);
-
-        if(current_key != key)
-        {
-            continue;
-        }
-        MIOPEN_LOG_I2("Key match: " << current_key);
-        const auto contents = line.substr(key_size + 1);
-
-        if(contents.empty())
-        {
-            MIOPEN_LOG_E("None contents under the key: " << current_key << " form file " << filename
-                                                         << "#" << n_line);
-            continue;
-        }
-        MIOPEN_LOG_I2("Contents found: " << contents);
+    MIOPEN_LOG_I2("Key match: " << key);
+    MIOPEN_LOG_I2("Contents found: " << contents);
 
-        DbRecord record(key);
-        const bool is_parse_ok = record.ParseContents(contents);
+    DbRecord record(key);
+    const bool is_parse_ok = record.ParseContents(contents);
 
-        if(!is_parse_ok)
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: " << current_key << " form file "
-                                                                 << filename << "#" << n_line);
-            MIOPEN_LOG_E("Contents: " << contents);
-        }
-        // A record with matching key have been found.
-        if(pos != nullptr)
-        {
-            pos->begin = line_begin;
-            pos->end   = next_line_begin;
-        }
-        return record;
+    if(!is_parse_ok)
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename
+                                                             << "#" << item.line);
+        MIOPEN_LOG_E("Contents: " << contents);
     }
-    // Record was not found
-    return boost::none;
+    // A record with matching key have been found.
+    if(pos != nullptr)
+    {
+        pos->begin = item.begin;
+        pos->end   = item.end;
+    }
+    return record;
 }
 
 static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
@@ -239,25 +552,34 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
 {
     assert(pos);
 
-    if(pos->begin < 0 || pos->end < 0)
-    {
-        {
-            std::ofstream file(filename, std::ios::app);
+    const auto is_new = pos->begin < 0 || pos->end < 0;
 
-            if(!file)
-            {
-                MIOPEN_LOG_E("File is unwritable: " << filename);
-                return false;
-            }
+    if(is_new || !miopen::IsDisabled(MIOPEN_DEBUG_DB_JOURNAL{}))
+    {
+        // Nothing to remove.
+        if(is_new && record.GetSize() == 0)
+            return true;
+
+        // Updated records are appended to the end of the file and supersede the previous ones.
+        // Empty contents mark the record as removed.
+        std::ostringstream line;
+        if(record.GetSize() == 0)
+            line << record.key << '=' << std::endl;
+        else
+            record.WriteContents(line);
 
-            (void)file.tellp();
-            record.WriteContents(file);
-        }
+        const auto existed = boost::filesystem::exists(filename);
+        if(!index.Append(record.key, line.str()))
+            return false;
 
-        boost::filesystem::permissions(filename, boost::filesystem::all_all);
+        if(!existed)
+            boost::filesystem::permissions(filename, boost::filesystem::all_all);
     }
     else
     {
+        // The file is going to be rewritten, the index should be rebuilt on the next access.
+        index.Invalidate();
+
         std::ifstream from(filename, std::ios::ate);
 
         if(!from)
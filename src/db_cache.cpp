@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_cache.hpp>
+#include <miopen/cow_registry.hpp>
+#include <miopen/env.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PERFDB_CACHE_SIZE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_PERFDB_WRITE_BEHIND)
+
+namespace miopen {
+
+DbRecordCache& DbRecordCache::Get(const std::string& db_key)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::vector<std::unique_ptr<DbRecordCache>>{};
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static CowRegistry<DbRecordCache> registry;
+    static const auto capacity = Value(MIOPEN_DEBUG_PERFDB_CACHE_SIZE{}, 1024);
+
+    // The factory runs under the registry insert lock, which also guards instances.
+    return registry.GetOrInsert(db_key, [&]() {
+        instances.push_back(std::make_unique<DbRecordCache>(capacity));
+        return instances.back().get();
+    });
+}
+
+bool DbRecordCache::Find(const std::string& key, boost::optional<DbRecord>& record)
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto it = index.find(key);
+
+    if(it == index.end())
+    {
+        ++misses;
+        return false;
+    }
+
+    ++hits;
+    entries.splice(entries.begin(), entries, it->second);
+    record = it->second->second;
+    return true;
+}
+
+void DbRecordCache::Insert(const std::string& key,
+                           const boost::optional<DbRecord>& record,
+                           std::uint64_t gen)
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // The record may have been changed while it was being read from the db.
+    if(gen != generation.load(std::memory_order_relaxed))
+        return;
+
+    const auto it = index.find(key);
+    if(it != index.end())
+    {
+        it->second->second = record;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.emplace_front(key, record);
+    index.emplace(key, entries.begin());
+
+    if(entries.size() > capacity)
+    {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+void DbRecordCache::Invalidate(const std::string& key)
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    generation.fetch_add(1, std::memory_order_release);
+
+    const auto it = index.find(key);
+    if(it == index.end())
+        return;
+
+    entries.erase(it->second);
+    index.erase(it);
+}
+
+void DbRecordCache::Clear()
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    generation.fetch_add(1, std::memory_order_release);
+    entries.clear();
+    index.clear();
+}
+
+namespace {
+struct DbWriteBehindQueues
+{
+    std::mutex mutex;
+    std::vector<DbWriteBehindQueueBase*> queues;
+};
+
+DbWriteBehindQueues& GetDbWriteBehindQueues()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static DbWriteBehindQueues queues;
+    return queues;
+}
+
+void StopDbWriteBehindQueues()
+{
+    auto& registry = GetDbWriteBehindQueues();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+    for(const auto queue : registry.queues)
+        queue->Stop();
+}
+} // namespace
+
+bool IsDbWriteBehindEnabled()
+{
+    static const auto enabled = IsEnabled(MIOPEN_PERFDB_WRITE_BEHIND{});
+    return enabled;
+}
+
+void RegisterDbWriteBehindQueue(DbWriteBehindQueueBase& queue)
+{
+    auto& registry = GetDbWriteBehindQueues();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.queues.push_back(&queue);
+    // Registered after the queue and the dbs it writes to are constructed, so it is called
+    // before they are destroyed.
+    std::atexit(StopDbWriteBehindQueues); // NOLINT (cert-err33-c)
+}
+
+void FlushDbWriteBehindQueues()
+{
+    auto& registry = GetDbWriteBehindQueues();
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+    for(const auto queue : registry.queues)
+        queue->Flush();
+}
+
+} // namespace miopen
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+// Build-time tool converting text dbs to the binary format read by miopen::BinaryDb.
+
+#include <miopen/binary_db.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    if(argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <text db> <binary db>" << std::endl;
+        return 2;
+    }
+
+    const std::string text_path   = argv[1];
+    const std::string binary_path = argv[2];
+
+    if(!miopen::BinaryDb::Convert(text_path, binary_path))
+    {
+        std::cerr << "Unable to convert " << text_path << " to " << binary_path << std::endl;
+        return 1;
+    }
+
+    if(!miopen::BinaryDb::Verify(text_path, binary_path))
+    {
+        std::cerr << binary_path << " does not match " << text_path << std::endl;
+        std::remove(binary_path.c_str());
+        return 1;
+    }
+
+    return 0;
+}
@@ -23,11 +23,10 @@
  * SOFTWARE.
  *
  *******************************************************************************/
-#include <iostream>
-#include <numeric>
+#include <algorithm>
+#include <iterator>
 #include <ostream>
 #include <string>
-#include <unordered_map>
 #include <utility>
 
 #include <miopen/config.h>
@@ -36,100 +35,226 @@
 
 namespace miopen {
 
+namespace {
+struct EntryLess
+{
+    const std::string& buffer;
+
+    template <class TEntry>
+    boost::string_view Id(const TEntry& entry) const
+    {
+        return {buffer.data() + entry.id_offset, entry.id_size};
+    }
+
+    template <class TEntry>
+    bool operator()(const TEntry& entry, boost::string_view id) const
+    {
+        return Id(entry) < id;
+    }
+
+    template <class TEntry>
+    bool operator()(const TEntry& left, const TEntry& right) const
+    {
+        return Id(left) < Id(right);
+    }
+};
+} // namespace
+
+std::vector<DbRecord::Entry>::const_iterator DbRecord::Find(boost::string_view id) const
+{
+    const auto it = std::lower_bound(entries.begin(), entries.end(), id, EntryLess{buffer});
+    if(it == entries.end() || Id(*it) != id)
+        return entries.end();
+    return it;
+}
+
+DbRecord::Entry DbRecord::Append(boost::string_view id, boost::string_view values)
+{
+    auto entry      = Entry{};
+    entry.id_offset = static_cast<std::uint32_t>(buffer.size());
+    entry.id_size   = static_cast<std::uint32_t>(id.size());
+    buffer.append(id.data(), id.size());
+    entry.values_offset = static_cast<std::uint32_t>(buffer.size());
+    entry.values_size   = static_cast<std::uint32_t>(values.size());
+    buffer.append(values.data(), values.size());
+    return entry;
+}
+
+void DbRecord::Compact()
+{
+    // Replacing or erasing values leaves unused bytes in the buffer, which are dropped once
+    // they take most of it.
+    if(unused < 256 || unused < buffer.size() / 2)
+        return;
+
+    auto old = std::string{};
+    old.swap(buffer);
+    buffer.reserve(old.size() - unused);
+    unused = 0;
+
+    for(auto& entry : entries)
+    {
+        entry = Append({old.data() + entry.id_offset, entry.id_size},
+                       {old.data() + entry.values_offset, entry.values_size});
+    }
+}
+
+bool DbRecord::Emplace(boost::string_view id, boost::string_view values)
+{
+    const auto it = std::lower_bound(entries.begin(), entries.end(), id, EntryLess{buffer});
+    if(it != entries.end() && Id(*it) == id)
+        return false;
+
+    const auto pos = it - entries.begin();
+    entries.insert(entries.begin() + pos, Append(id, values));
+    return true;
+}
+
+bool DbRecord::HasSameContents(const DbRecord& other) const
+{
+    return std::equal(entries.begin(),
+                      entries.end(),
+                      other.entries.begin(),
+                      other.entries.end(),
+                      [&](const Entry& left, const Entry& right) {
+                          return Id(left) == other.Id(right) &&
+                                 Values(left) == other.Values(right);
+                      });
+}
+
 bool DbRecord::SetValues(const std::string& id, const std::string& values)
 {
     constexpr auto log_level = MIOPEN_ENABLE_SQLITE ? LoggingLevel::Info2 : LoggingLevel::Info;
 
+    const auto it    = std::lower_bound(entries.begin(), entries.end(), id, EntryLess{buffer});
+    const auto found = it != entries.end() && Id(*it) == id;
+
     // No need to update the file if values are the same:
-    const auto it = map.find(id);
-    if(it == map.end() || it->second != values)
+    if(found && Values(*it) == values)
     {
-        MIOPEN_LOG(log_level,
-                   key << ", content " << (it == map.end() ? "inserted" : "overwritten") << ": "
-                       << id << ':' << values);
-        map[id] = values;
-        return true;
+        MIOPEN_LOG(log_level, key << ", content is the same, not changed:" << id << ':' << values);
+        return false;
     }
-    MIOPEN_LOG(log_level, key << ", content is the same, not changed:" << id << ':' << values);
-    return false;
+
+    MIOPEN_LOG(log_level,
+               key << ", content " << (found ? "overwritten" : "inserted") << ": " << id << ':'
+                   << values);
+
+    if(found)
+    {
+        unused += it->id_size + it->values_size;
+        *it = Append(id, values);
+        Compact();
+    }
+    else
+    {
+        const auto pos = it - entries.begin();
+        entries.insert(entries.begin() + pos, Append(id, values));
+    }
+
+    return true;
 }
 
 bool DbRecord::GetValues(const std::string& id, std::string& values) const
 {
-    const auto it = map.find(id);
+    const auto it = Find(id);
 
-    if(it == map.end())
+    if(it == entries.end())
     {
         MIOPEN_LOG_I(key << '=' << id << ':' << "<values not found>");
         return false;
     }
 
-    values = it->second;
+    values = Values(*it).to_string();
     MIOPEN_LOG_I(key << '=' << id << ':' << values);
     return true;
 }
 
 bool DbRecord::EraseValues(const std::string& id)
 {
-    const auto it = map.find(id);
-    if(it != map.end())
+    const auto it = Find(id);
+    if(it != entries.end())
     {
-        MIOPEN_LOG_I(key << ", removed: " << id << ':' << it->second);
-        map.erase(it);
+        MIOPEN_LOG_I(key << ", removed: " << id << ':' << Values(*it));
+        unused += it->id_size + it->values_size;
+        entries.erase(it);
+        Compact();
         return true;
     }
     MIOPEN_LOG_W(key << ", not found: " << id);
     return false;
 }
 
-bool DbRecord::ParseContents(std::istream& contents)
+bool DbRecord::ParseContents(boost::string_view contents)
 {
-    std::string id_and_values;
-    int found = 0;
+    buffer.assign(contents.data(), contents.size());
+    entries.clear();
+    entries.reserve(std::count(contents.begin(), contents.end(), ';') + 1);
+    unused = 0;
 
-    map.clear();
+    auto begin = std::size_t{0};
 
-    while(std::getline(contents, id_and_values, ';'))
+    // A trailing empty ID:VALUES pair is skipped silently, same as with std::getline.
+    while(begin < buffer.size())
     {
-        const auto id_size = id_and_values.find(':');
+        auto end = buffer.find(';', begin);
+        if(end == std::string::npos)
+            end = buffer.size();
+
+        const auto id_end = buffer.find(':', begin);
 
         // Empty VALUES is ok, empty ID is not:
-        if(id_size == std::string::npos)
+        if(id_end >= end)
         {
             MIOPEN_LOG_E("Ill-formed file: ID not found; skipped; key: " << key);
-            continue;
+            unused += end - begin;
         }
-
-        const auto id     = id_and_values.substr(0, id_size);
-        const auto values = id_and_values.substr(id_size + 1);
-
-        if(map.find(id) != map.end())
+        else
         {
-            MIOPEN_LOG_E("Duplicate ID (ignored): " << id << "; key: " << key);
-            continue;
+            auto entry          = Entry{};
+            entry.id_offset     = static_cast<std::uint32_t>(begin);
+            entry.id_size       = static_cast<std::uint32_t>(id_end - begin);
+            entry.values_offset = static_cast<std::uint32_t>(id_end + 1);
+            entry.values_size   = static_cast<std::uint32_t>(end - id_end - 1);
+            entries.push_back(entry);
         }
 
-        map.emplace(id, values);
-        ++found;
+        begin = end + 1;
     }
 
-    return (found > 0);
+    // The first one of the pairs with the same ID is kept.
+    std::stable_sort(entries.begin(), entries.end(), EntryLess{buffer});
+    const auto last = std::unique(entries.begin(), entries.end(), [&](auto& left, auto& right) {
+        if(Id(left) != Id(right))
+            return false;
+        MIOPEN_LOG_E("Duplicate ID (ignored): " << Id(right) << "; key: " << key);
+        unused += right.id_size + right.values_size;
+        return true;
+    });
+    entries.erase(last, entries.end());
+
+    return !entries.empty();
 }
 
 void DbRecord::WriteContents(std::ostream& stream) const
 {
-    if(map.empty())
+    if(entries.empty())
         return;
 
     stream << key << '=';
 
-    const auto pairsJoiner = [](const std::string& sum,
-                                const std::pair<std::string, std::string>& pair) {
-        const auto pair_str = pair.first + ':' + pair.second;
-        return sum.empty() ? pair_str : sum + ';' + pair_str;
-    };
+    for(auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        if(it != entries.begin())
+            stream << ';';
+        const auto id     = Id(*it);
+        const auto values = Values(*it);
+        stream.write(id.data(), id.size());
+        stream << ':';
+        stream.write(values.data(), values.size());
+    }
 
-    stream << std::accumulate(map.begin(), map.end(), std::string(), pairsJoiner) << std::endl;
+    stream << std::endl;
 }
 
 void DbRecord::Merge(const DbRecord& that)
@@ -137,11 +262,25 @@ void DbRecord::Merge(const DbRecord& that)
     if(key != that.key)
         return;
 
-    for(const auto& that_pair : that.map)
+    // Both are sorted, so the pairs missing here are found in one pass.
+    auto merged = std::vector<Entry>{};
+    merged.reserve(entries.size() + that.entries.size());
+    auto it = entries.begin();
+
+    for(const auto& that_entry : that.entries)
     {
-        if(map.find(that_pair.first) != map.end())
+        const auto id = that.Id(that_entry);
+
+        while(it != entries.end() && Id(*it) < id)
+            merged.push_back(*it++);
+
+        if(it != entries.end() && Id(*it) == id)
             continue;
-        map[that_pair.first] = that_pair.second;
+
+        merged.push_back(Append(id, that.Values(that_entry)));
     }
+
+    std::copy(it, entries.end(), std::back_inserter(merged));
+    entries.swap(merged);
 }
 } // namespace miopen
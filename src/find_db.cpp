@@ -50,7 +50,7 @@ std::string FindDbRecord_t<TDb>::GetInstalledPath(Handle& handle)
 {
 #if !MIOPEN_DISABLE_SYSDB
     return GetSystemDbPath() + "/" + handle.GetDbBasename() + "." + GetSystemFindDbSuffix() +
-           ".fdb.txt";
+           (MIOPEN_USE_BINARY_FIND_DB ? ".fdb.bin" : ".fdb.txt");
 #else
     (void)(handle);
     return "";
@@ -84,8 +84,23 @@ bool CheckInvokerSupport(const std::string& algo)
            algo == "miopenConvolutionBwdWeightsAlgoGEMM";
 }
 
+void PrefetchFindDb(Handle& handle)
+{
+#if MIOPEN_DEBUG_FIND_DB_CACHING
+    if(!IsEnabled(MIOPEN_FIND_DB_PREFETCH{}) || !testing_find_db_enabled ||
+       IsEnabled(MIOPEN_DEBUG_DISABLE_FIND_DB{}) || testing_find_db_path_override())
+        return;
+
+    const auto path = FindDbRecord::GetInstalledPath(handle);
+    if(!path.empty())
+        SystemFindDb::StartPrefetch(path, true);
+#else
+    (void)(handle);
+#endif
+}
+
 template <class TDb>
-bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config) const
+bool FindDbRecord_t<TDb>::Validate(Handle& handle, const ProblemKey& problem_key) const
 {
     auto unbuilt = false;
     auto any     = false;
@@ -96,7 +111,7 @@ bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config)
         {
             if(CheckInvokerSupport(pair.first))
             {
-                if(!handle.GetInvoker(config, {{pair.second.solver_id}}))
+                if(!handle.GetInvoker(problem_key, {{pair.second.solver_id}}))
                 {
                     unbuilt = true;
                     // This is not an logged as error because no error was detected.
@@ -26,17 +26,22 @@
 #include <cassert>
 #include <miopen/fusion.hpp>
 #include <miopen/md_graph.hpp>
+#include <miopen/env.hpp>
 #include <miopen/fusion_plan.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/stringutils.hpp>
 #include <ostream>
+#include <sstream>
 #include <ios>
 #include <algorithm>
+#include <mutex>
 #include <string>
 #include <half.hpp>
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FUSION_PLAN_CACHE_SIZE)
+
 namespace miopen {
 
 FusionPlanDescriptor::FusionPlanDescriptor(const miopenFusionDirection_t dir,
@@ -71,7 +76,8 @@ miopenStatus_t FusionPlanDescriptor::AddOp(std::shared_ptr<FusionOpDescriptor> d
     desc->GetOutputDesc(output_desc);
     op_map.emplace_back(desc);
     op_count++;
-    is_valid = false;
+    is_valid           = false;
+    compiled_handle_id = 0;
     miopen::try_([&] {
         is_valid = lu.Advance(desc, [&](const std::string& sym, int& val) -> bool {
             // check tensor attr
@@ -995,6 +1001,32 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
     {
         op->GetNetworkConfig(network_config, handle);
     }
+
+    const auto cache_key = GetCacheKey(handle);
+    CompiledFusionPlan cached;
+    if(FusionPlanCache::Get().Find(cache_key, cached))
+    {
+        MIOPEN_LOG_I2("Compiled plan found: " << cached.program_name << ',' << cached.kernel_name);
+        lu.cur_vertex      = {cached.vertex};
+        program_name       = cached.program_name;
+        kernel_name        = cached.kernel_name;
+        algorithm_name     = cached.algorithm_name;
+        kernel_source_type = cached.kernel_source_type;
+        if(!handle.HasKernel(algorithm_name, network_config))
+        {
+            handle.AddKernel(algorithm_name,
+                             network_config,
+                             program_name,
+                             kernel_name,
+                             cached.vld,
+                             cached.vgd,
+                             cached.compile_config);
+        }
+        arg_list = std::move(cached.arg_list);
+        SetCompiled(handle);
+        return miopenStatusSuccess;
+    }
+
     // Check if the kernel is assembly or OpenCL
     auto ops_head  = op_map[0];
     algorithm_name = lu.GetAlgoName(handle);
@@ -1015,6 +1047,7 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
     else
         kernel_source_type = OpenclText;
 
+    auto built     = false;
     auto&& kernels = handle.GetKernels(algorithm_name, network_config);
     if(!kernels.empty())
     {
@@ -1026,7 +1059,7 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
         std::string compile_config;
         auto success = true;
         // lu.cur_vertex is sorted according to the weights from MDGraph::Advance method
-        std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> new_list;
+        std::vector<std::pair<MDGraph_vertex_ptr, MDGraph_path_state>> new_list;
         for(auto& kinder : lu.cur_vertex)
         {
             if(kinder.first == nullptr)
@@ -1035,14 +1068,10 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
                 MIOPEN_THROW(miopenStatusBadParm);
             }
 
-            success = true;
-            solver::AnySolver sol;
-            if(kinder.second.find("solver") != kinder.second.end())
-            {
-                sol = boost::any_cast<solver::AnySolver>(kinder.second.at("solver"));
-            }
-            program_name = kinder.first->vertex_data.at("program");
-            auto d       = handle.GetDeviceName();
+            success               = true;
+            solver::AnySolver sol = kinder.second.solver;
+            program_name          = kinder.first->vertex_data.at("program");
+            auto d                = handle.GetDeviceName();
 
             auto it = std::find(
                 kinder.first->supported_arch.begin(), kinder.first->supported_arch.end(), d);
@@ -1118,7 +1147,11 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
                                  vgd,
                                  compile_config);
 
-                status = miopenStatusSuccess;
+                built                 = true;
+                cached.compile_config = compile_config;
+                cached.vld            = vld;
+                cached.vgd            = vgd;
+                status                = miopenStatusSuccess;
             }
         }
         else
@@ -1129,9 +1162,142 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
         }
     }
     arg_list = CalcArgOrder(handle);
+
+    // Only a kernel built here comes with the build parameters another handle needs
+    if(built)
+    {
+        cached.vertex             = lu.cur_vertex.front();
+        cached.program_name       = program_name;
+        cached.kernel_name        = kernel_name;
+        cached.algorithm_name     = algorithm_name;
+        cached.kernel_source_type = kernel_source_type;
+        cached.arg_list           = arg_list;
+        FusionPlanCache::Get().Insert(cache_key, std::move(cached));
+    }
+
+    SetCompiled(handle);
     return status;
 }
 
+void FusionPlanDescriptor::SetCompiled(const Handle& handle)
+{
+    {
+        std::lock_guard<std::mutex> lock(arg_plan_mutex);
+        arg_plan = MakeArgPlan();
+    }
+
+    const auto& compiled = handle.GetKernelsImpl(algorithm_name, network_config);
+    if(!compiled.empty())
+    {
+        compiled_kernel    = compiled.front();
+        compiled_handle_id = handle.GetId();
+    }
+}
+
+std::string FusionPlanDescriptor::GetCacheKey(const Handle& handle) const
+{
+    // network_config has the lengths and the configs of the operators, the graph vertices the
+    // plan could use stand for the attributes the metadata graph looks at.
+    std::ostringstream key;
+    key << handle.GetDeviceName() << ',' << handle.GetMaxComputeUnits() << ';' << fusion_dir
+        << ';' << network_config << ';';
+    LogRange(key, input_desc.GetStrides(), ",") << ';';
+    LogRange(key, output_desc.GetStrides(), ",") << ';';
+    for(auto&& op : op_map)
+        key << op->kind() << ',';
+    for(auto& kinder : lu.cur_vertex)
+    {
+        key << ';' << (kinder.first == nullptr ? 0 : kinder.first->id) << ','
+            << kinder.second.weight << ','
+            << (kinder.second.has_algo ? static_cast<int>(kinder.second.algo) : -1);
+    }
+    return key.str();
+}
+
+FusionPlanCache& FusionPlanCache::Get()
+{
+    static FusionPlanCache cache{Value(MIOPEN_DEBUG_FUSION_PLAN_CACHE_SIZE{}, 1024)};
+    return cache;
+}
+
+bool FusionPlanCache::Find(const std::string& key, CompiledFusionPlan& plan)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = index.find(key);
+    if(it == index.end())
+        return false;
+    plans.splice(plans.begin(), plans, it->second);
+    plan = it->second->second;
+    return true;
+}
+
+void FusionPlanCache::Insert(const std::string& key, CompiledFusionPlan plan)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = index.find(key);
+    if(it != index.end())
+    {
+        it->second->second = std::move(plan);
+        plans.splice(plans.begin(), plans, it->second);
+        return;
+    }
+
+    if(capacity == 0)
+        return;
+
+    plans.emplace_front(key, std::move(plan));
+    index.emplace(key, plans.begin());
+
+    if(plans.size() > capacity)
+    {
+        index.erase(plans.back().first);
+        plans.pop_back();
+    }
+}
+
+std::size_t FusionPlanCache::GetSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return plans.size();
+}
+
+FusionArgPlan FusionPlanDescriptor::MakeArgPlan() const
+{
+    if(arg_list.empty())
+    {
+        MIOPEN_THROW("Kernel arguments not setup properly");
+    }
+
+    FusionArgPlan plan;
+    plan.args.reserve(arg_list.size());
+
+    for(auto& arg : arg_list)
+    {
+        const auto position = plan.args.size();
+        switch(arg.type)
+        {
+        case Input_Ptr:
+            plan.input_positions.push_back(position);
+            plan.args.emplace_back(OpKernelArg(ConstData_t{nullptr}));
+            break;
+        case Output_Ptr:
+            plan.output_positions.push_back(position);
+            plan.args.emplace_back(OpKernelArg(ConstData_t{nullptr}));
+            break;
+        case Padding: plan.args.emplace_back(OpKernelArg(0, arg.size)); break;
+        case Scalar:
+        case Pointer:
+            plan.op_arg_positions.push_back(position);
+            plan.op_arg_keys.push_back(arg.key);
+            plan.args.push_back(arg.val);
+            break;
+        case Default: plan.args.push_back(arg.val); break;
+        }
+    }
+
+    return plan;
+}
+
 std::vector<Exec_arg_t> FusionPlanDescriptor::CalcArgOrder(const Handle& handle)
 {
     std::vector<Exec_arg_t> arg_keys;
@@ -1305,7 +1471,9 @@ miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
                                              Data_t output,
                                              const OperatorArgs& op_args)
 {
-    if(!isValid() || (lu.GetCurVertex(handle) == nullptr))
+    // The vertex has been checked by Compile for the handle the plan was compiled for.
+    const auto compiled_here = compiled_handle_id == handle.GetId();
+    if(!isValid() || (!compiled_here && lu.GetCurVertex(handle) == nullptr))
     {
         MIOPEN_THROW(miopenStatusBadParm, "Attempting to execute an invalid fusion plan.");
     }
@@ -1319,49 +1487,56 @@ miopenStatus_t FusionPlanDescriptor::Execute(const Handle& handle,
         MIOPEN_THROW(miopenStatusBadParm, "The input descriptors dont match.");
     }
 
-    auto ops_head = op_map[0];
-
-    auto&& kernels = handle.GetKernels(algorithm_name, network_config);
-    MIOPEN_LOG_I(algorithm_name << ',' << network_config);
-    if(kernels.empty())
+    KernelInvoke kernel;
+    if(compiled_here)
     {
-        MIOPEN_THROW(miopenStatusBadParm, "The FusionPlan was not compiled for execution");
+        kernel = handle.Run(compiled_kernel);
     }
-    KernelInvoke kernel = kernels.front();
-
-    std::vector<OpKernelArg> args;
-    if(arg_list.empty())
+    else
     {
-        MIOPEN_THROW("Kernel arguments not setup properly");
+        const auto& kernels = handle.GetKernelsImpl(algorithm_name, network_config);
+        MIOPEN_LOG_I(algorithm_name << ',' << network_config);
+        if(kernels.empty())
+        {
+            MIOPEN_THROW(miopenStatusBadParm, "The FusionPlan was not compiled for execution");
+        }
+        kernel = handle.Run(kernels.front());
     }
-    for(auto& arg : arg_list)
+
+    std::vector<OpKernelArg> args;
     {
-        MIOPEN_LOG_I2("Key: " + arg.key);
-        switch(arg.type)
+        std::lock_guard<std::mutex> lock(arg_plan_mutex);
+        if(arg_plan.args.empty())
         {
-        case Input_Ptr: args.emplace_back(OpKernelArg(input)); break;
-        case Output_Ptr: args.emplace_back(OpKernelArg(output)); break;
-        case Padding: args.emplace_back(OpKernelArg(0, arg.size)); break;
-        case Scalar:
-        case Pointer: {
-            auto it = op_args.args_map.find(arg.key);
-            if(it != op_args.args_map.end())
-            {
-                args.push_back(it->second);
-            }
-            else
+            MIOPEN_THROW("Kernel arguments not setup properly");
+        }
+
+        if(arg_plan.bound_layout != op_args.GetLayoutId())
+        {
+            std::vector<std::size_t> slots;
+            slots.reserve(arg_plan.op_arg_keys.size());
+            for(auto& key : arg_plan.op_arg_keys)
             {
-                MIOPEN_THROW(miopenStatusInternalError, "Argument Not Set: " + arg.key);
+                const auto slot = op_args.FindSlot(key);
+                if(slot < 0)
+                {
+                    MIOPEN_THROW(miopenStatusInternalError, "Argument Not Set: " + key);
+                }
+                slots.push_back(slot);
             }
-            break;
-        }
-        case Default: args.push_back(arg.val); break;
+            arg_plan.bound_slots  = std::move(slots);
+            arg_plan.bound_layout = op_args.GetLayoutId();
         }
+
+        args = arg_plan.args;
+        for(std::size_t i = 0; i < arg_plan.op_arg_positions.size(); ++i)
+            args[arg_plan.op_arg_positions[i]] = op_args.args_vec[arg_plan.bound_slots[i]];
+        for(auto position : arg_plan.input_positions)
+            args[position] = OpKernelArg(input);
+        for(auto position : arg_plan.output_positions)
+            args[position] = OpKernelArg(output);
     }
-    if(args.empty())
-    {
-        MIOPEN_THROW("Operator args not populated properly");
-    }
+
     kernel(args);
     return miopenStatusSuccess;
 }
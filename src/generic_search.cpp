@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/generic_search.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <string>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_STRATEGY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_BUDGET_MS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_MAX_CONFIGS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_SEED)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_COMPARE_EXHAUSTIVE)
+
+namespace miopen {
+namespace solver {
+
+const char* ToString(SearchStrategy strategy)
+{
+    switch(strategy)
+    {
+    case SearchStrategy::Exhaustive: return "exhaustive";
+    case SearchStrategy::Random: return "random";
+    case SearchStrategy::SuccessiveHalving: return "halving";
+    case SearchStrategy::CostModel: return "cost";
+    }
+    return "<unknown>";
+}
+
+namespace {
+
+SearchStrategy GetStrategy()
+{
+    const char* const p = GetStringEnv(MIOPEN_DEBUG_TUNING_STRATEGY{});
+    if(p == nullptr)
+        return SearchStrategy::Exhaustive;
+
+    const std::string name = p;
+    for(const auto strategy : {SearchStrategy::Exhaustive,
+                               SearchStrategy::Random,
+                               SearchStrategy::SuccessiveHalving,
+                               SearchStrategy::CostModel})
+    {
+        if(name == ToString(strategy))
+            return strategy;
+    }
+
+    MIOPEN_LOG_W("Unknown MIOPEN_DEBUG_TUNING_STRATEGY=" << name << ", using exhaustive");
+    return SearchStrategy::Exhaustive;
+}
+
+} // namespace
+
+SearchOptions SearchOptions::FromEnv()
+{
+    SearchOptions options;
+    options.strategy           = GetStrategy();
+    options.budget_ms          = Value(MIOPEN_DEBUG_TUNING_BUDGET_MS{});
+    options.max_configs        = Value(MIOPEN_DEBUG_TUNING_MAX_CONFIGS{});
+    options.seed               = Value(MIOPEN_DEBUG_TUNING_SEED{});
+    options.compare_exhaustive = IsEnabled(MIOPEN_DEBUG_TUNING_COMPARE_EXHAUSTIVE{});
+    return options;
+}
+
+std::ostream& operator<<(std::ostream& os, const SearchOptions& options)
+{
+    os << ToString(options.strategy);
+    if(options.budget_ms != 0)
+        os << ", budget " << options.budget_ms << " ms";
+    if(options.max_configs != 0)
+        os << ", up to " << options.max_configs << " configs";
+    return os;
+}
+
+} // namespace solver
+} // namespace miopen
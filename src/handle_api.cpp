@@ -25,9 +25,13 @@
  *******************************************************************************/
 #include <cstdio>
 #include <miopen/version.h>
+#include <miopen/db_cache.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/find_db.hpp>
 #include <miopen/handle.hpp>
 
+#include <memory>
+
 extern "C" const char* miopenGetErrorString(miopenStatus_t error)
 {
     switch(error)
@@ -70,14 +74,22 @@ extern "C" miopenStatus_t miopenGetVersion(size_t* major, size_t* minor, size_t*
 extern "C" miopenStatus_t miopenCreate(miopenHandle_t* handle)
 {
 
-    return miopen::try_([&] { miopen::deref(handle) = new miopen::Handle(); });
+    return miopen::try_([&] {
+        auto h = std::make_unique<miopen::Handle>();
+        miopen::PrefetchFindDb(*h);
+        miopen::deref(handle) = h.release();
+    });
 }
 
 extern "C" miopenStatus_t miopenCreateWithStream(miopenHandle_t* handle,
                                                  miopenAcceleratorQueue_t stream)
 {
 
-    return miopen::try_([&] { miopen::deref(handle) = new miopen::Handle(stream); });
+    return miopen::try_([&] {
+        auto h = std::make_unique<miopen::Handle>(stream);
+        miopen::PrefetchFindDb(*h);
+        miopen::deref(handle) = h.release();
+    });
 }
 
 extern "C" miopenStatus_t miopenSetStream(miopenHandle_t handle, miopenAcceleratorQueue_t streamID)
@@ -101,7 +113,10 @@ extern "C" miopenStatus_t miopenSetAllocator(miopenHandle_t handle,
 
 extern "C" miopenStatus_t miopenDestroy(miopenHandle_t handle)
 {
-    return miopen::try_([&] { miopen_destroy_object(handle); });
+    return miopen::try_([&] {
+        miopen_destroy_object(handle);
+        miopen::FlushDbWriteBehindQueues();
+    });
 }
 
 extern "C" miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* time)
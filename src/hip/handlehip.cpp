@@ -35,6 +35,7 @@
 #include <miopen/invoker.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/mapped_file.hpp>
 #include <miopen/rocm_features.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
@@ -45,6 +46,7 @@
 #endif
 
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/load_file.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -396,11 +398,51 @@ Program Handle::LoadProgram(const std::string& program_name,
         params += " -mcpu=" + this->GetTargetProperties().Name();
     }
 
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    {
+        const auto mapped = miopen::MapBinary(this->GetTargetProperties(),
+                                              this->GetMaxComputeUnits(),
+                                              program_name,
+                                              params,
+                                              is_kernel_str);
+        if(mapped.IsValid())
+        {
+            try
+            {
+                return HIPOCProgram{program_name, mapped};
+            }
+            catch(const Exception& ex)
+            {
+                MIOPEN_LOG_W("Unable to load the cached binary " << mapped.Path() << ": "
+                                                                 << ex.what());
+                miopen::RemoveMappedBinary(mapped);
+            }
+        }
+    }
+#endif
+
     auto hsaco = miopen::LoadBinary(this->GetTargetProperties(),
                                     this->GetMaxComputeUnits(),
                                     program_name,
                                     params,
                                     is_kernel_str);
+
+    // Held until the binary is saved, so that the others building it wait and then load it.
+    boost::optional<CompileClaim> claim;
+    if(hsaco.empty())
+    {
+        claim.emplace(this->GetTargetProperties(),
+                      this->GetMaxComputeUnits(),
+                      program_name,
+                      params,
+                      is_kernel_str);
+        hsaco = miopen::LoadBinary(this->GetTargetProperties(),
+                                   this->GetMaxComputeUnits(),
+                                   program_name,
+                                   params,
+                                   is_kernel_str);
+    }
+
     if(hsaco.empty())
     {
         CompileTimer ct;
@@ -32,6 +32,7 @@
 #include <miopen/kernel.hpp>
 #include <miopen/kernel_warnings.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/mapped_file.hpp>
 #include <miopen/mlir_build.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
@@ -159,17 +160,22 @@ static hipModulePtr CreateModule(const boost::filesystem::path& hsaco_file)
     return m;
 }
 
-template <typename T> /// intended for std::string and std::vector<char>
-hipModulePtr CreateModuleInMem(const T& blob)
+static hipModulePtr CreateModuleInMem(const void* blob)
 {
     hipModule_t raw_m;
-    auto status = hipModuleLoadData(&raw_m, reinterpret_cast<const void*>(blob.data()));
+    auto status = hipModuleLoadData(&raw_m, blob);
     hipModulePtr m{raw_m};
     if(status != hipSuccess)
         MIOPEN_THROW_HIP_STATUS(status, "Failed loading module");
     return m;
 }
 
+template <typename T> /// intended for std::string and std::vector<char>
+hipModulePtr CreateModuleInMem(const T& blob)
+{
+    return CreateModuleInMem(reinterpret_cast<const void*>(blob.data()));
+}
+
 HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
                                    const boost::filesystem::path& filespec)
     : program(program_name), hsaco_file(filespec)
@@ -186,6 +192,14 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name, const std::s
     module = CreateModuleInMem(blob);
 }
 
+HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name, const MappedFile& blob)
+    : program(program_name)
+{
+    if(nullptr != miopen::GetStringEnv(MIOPEN_DEVICE_ARCH{}))
+        return;
+    module = CreateModuleInMem(static_cast<const void*>(blob.Data()));
+}
+
 HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
                                    std::string params,
                                    bool is_kernel_str,
@@ -347,6 +361,11 @@ HIPOCProgram::HIPOCProgram(const std::string& program_name, const std::string& h
 {
 }
 
+HIPOCProgram::HIPOCProgram(const std::string& program_name, const MappedFile& hsaco)
+    : impl(std::make_shared<HIPOCProgramImpl>(program_name, hsaco))
+{
+}
+
 hipModule_t HIPOCProgram::GetModule() const { return impl->module.get(); }
 
 boost::filesystem::path HIPOCProgram::GetCodeObjectPathname() const
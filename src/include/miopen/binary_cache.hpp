@@ -30,10 +30,14 @@
 #include <miopen/config.h>
 #include <miopen/target_properties.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <memory>
 #include <string>
 
 namespace miopen {
 
+class MappedFile;
+
 boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& name,
                                      const std::string& args,
@@ -41,6 +45,9 @@ boost::filesystem::path GetCacheFile(const std::string& device,
 
 boost::filesystem::path GetCachePath(bool is_system);
 
+/// The binaries are neither loaded from nor saved to the cache, see MIOPEN_DISABLE_CACHE.
+bool IsCacheDisabled();
+
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 boost::filesystem::path LoadBinary(const TargetProperties& target,
                                    std::size_t num_cu,
@@ -53,6 +60,20 @@ void SaveBinary(const boost::filesystem::path& binary_path,
                 const std::string& args,
                 bool is_kernel_str = false);
 #else
+/// Maps the binary from the blob store of the user cache, which SaveBinary and LoadBinary fill,
+/// so it can be loaded without a copy. Returns an invalid mapping if it is not there, or if the
+/// file is damaged, which is removed then. Look the binary up with LoadBinary if this fails.
+/// The blob store is used only when MIOPEN_DEBUG_KERNEL_CACHE_BLOBS is enabled.
+MappedFile MapBinary(const TargetProperties& target,
+                     std::size_t num_cu,
+                     const std::string& name,
+                     const std::string& args,
+                     bool is_kernel_str = false);
+
+/// Removes a binary returned by MapBinary that has failed to load, so that LoadBinary takes it
+/// from the database and writes it anew.
+void RemoveMappedBinary(const MappedFile& file);
+
 std::string LoadBinary(const TargetProperties& target,
                        std::size_t num_cu,
                        const std::string& name,
@@ -67,6 +88,45 @@ void SaveBinary(const std::string& hsaco,
                 bool is_kernel_str = false);
 #endif
 
+/// Keeps a binary missing from the cache from being built by several threads or processes at
+/// the same time.
+///
+/// Create one before building the binary, and keep it until the binary has been saved. If
+/// another thread of the process is building the same binary, the constructor waits for it.
+/// Otherwise it takes a lock file in the user cache directory, waiting for another process that
+/// holds it. Either way, the binary may have been saved to the cache in the meantime, so it
+/// should be loaded again once the claim is taken.
+///
+/// Does nothing when the user cache is disabled, since the others could not find the binary
+/// there anyway.
+class CompileClaim
+{
+    public:
+    CompileClaim(const TargetProperties& target,
+                 std::size_t num_cu,
+                 const std::string& name,
+                 const std::string& args,
+                 bool is_kernel_str = false);
+    CompileClaim(const CompileClaim&) = delete;
+    CompileClaim& operator=(const CompileClaim&) = delete;
+    ~CompileClaim();
+
+    private:
+    struct Flight;
+    struct Flights;
+
+    std::string key;
+    /// Set for the thread that builds the binary, which the others wait for.
+    std::shared_ptr<Flight> flight;
+    boost::interprocess::file_lock file_lock;
+    bool file_locked = false;
+
+    static Flights& GetFlights();
+    static std::shared_ptr<Flight> Join(const std::string& key, bool& is_first);
+    static void Leave(const std::string& key);
+    void LockFile(const std::string& name);
+};
+
 } // namespace miopen
 
 #endif
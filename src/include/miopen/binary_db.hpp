@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BINARY_DB_HPP_
+#define GUARD_MIOPEN_BINARY_DB_HPP_
+
+#include <miopen/db_record.hpp>
+#include <miopen/mapped_file.hpp>
+
+#include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+
+/// Read-only db stored in the precompiled binary format.
+/// The format is produced from a text db at build time (see Convert()), so opening a db is a
+/// memory mapping of the file and a check of its header. Records are looked up in place by an
+/// open addressing hash table stored in the file, and ID:VALUES pairs are stored already split.
+///
+/// Layout (native byte order, the writer and the reader are expected to run on the same kind of
+/// host): Header, then the hash table (uint32, record index plus one, zero marks an empty slot),
+/// then the records sorted by key, then the ID:VALUES pairs of the records, then all strings.
+class BinaryDb
+{
+    public:
+    BinaryDb(const std::string& path, bool warn_if_unreadable = true);
+
+    BinaryDb(const BinaryDb&) = delete;
+    BinaryDb& operator=(const BinaryDb&) = delete;
+
+    static BinaryDb& GetCached(const std::string& path,
+                               bool warn_if_unreadable,
+                               const std::string& arch = "",
+                               std::size_t num_cu      = 0);
+
+    /// Opening a binary db is cheap enough to be done in place.
+    static void StartPrefetch(const std::string& path, bool warn_if_unreadable)
+    {
+        GetCached(path, warn_if_unreadable);
+    }
+
+    /// Converts the text db to the binary format. The first record with a key wins, ill-formed
+    /// lines and pairs are skipped, the same as text dbs do when they are read.
+    static bool Convert(const std::string& text_path, const std::string& binary_path);
+    /// Checks that every record of the text db is found in the binary db with the same contents
+    /// and the binary db has no other records.
+    static bool Verify(const std::string& text_path, const std::string& binary_path);
+
+    bool IsValid() const { return header != nullptr; }
+    std::size_t GetSize() const;
+
+    boost::optional<DbRecord> FindRecord(const std::string& problem) const;
+
+    template <class TProblem>
+    boost::optional<DbRecord> FindRecord(const TProblem& problem) const
+    {
+        const auto key = DbRecord::Serialize(problem);
+        return FindRecord(key);
+    }
+
+    template <class TProblem, class TValue>
+    bool Load(const TProblem& problem, const std::string& id, TValue& value) const
+    {
+        std::string values;
+        if(!FindValues(DbRecord::Serialize(problem), id, values))
+            return false;
+
+        const bool ok = value.Deserialize(values);
+        if(!ok)
+            MIOPEN_LOG_WE("Perf db record is obsolete or corrupt: "
+                          << values << ". Performance may degrade.");
+        return ok;
+    }
+
+    private:
+    struct Header;
+    struct Record;
+    struct Pair;
+
+    std::string db_path;
+    MappedFile file;
+    const Header* header       = nullptr;
+    const std::uint32_t* slots = nullptr;
+    const Record* records      = nullptr;
+    const Pair* pairs          = nullptr;
+    const char* strings        = nullptr;
+
+    static std::uint64_t Hash(boost::string_view key);
+
+    boost::string_view GetString(std::uint32_t offset, std::uint32_t size) const;
+    const Record* Find(boost::string_view key) const;
+    bool FindValues(const std::string& problem, const std::string& id, std::string& values) const;
+    bool Open();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_BINARY_DB_HPP_
@@ -29,6 +29,7 @@
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/convolution.hpp>
 #include <miopen/names.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/sqlite_db.hpp>
 #include <miopen/tensor.hpp>
 
@@ -308,6 +309,9 @@ struct ProblemDescription
 
     void HeuristicUpdateLayouts();
 
+    /// The network config is derived from it, see ProblemKey.
+    ProblemKey BuildProblemKey() const;
+
     void BuildConfKey(std::string& conf_key) const;
 
     NetworkConfig BuildConfKey() const
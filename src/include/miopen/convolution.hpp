@@ -34,6 +34,7 @@
 #include <miopen/solver_id.hpp>
 #include <miopen/names.hpp>
 #include <miopen/invoke_params.hpp>
+#include <miopen/invoker.hpp>
 
 #include <boost/any.hpp>
 
@@ -329,6 +330,16 @@ struct ConvolutionDescriptor : miopenConvolutionDescriptor
                                  std::size_t workSpaceSize,
                                  solver::Id solver_id) const;
 
+    /// Validates the problem and returns the invoker of the solver for it, building the
+    /// kernels if they are not in the handle yet. The tensors are named as in the forward
+    /// direction whatever the direction is, i.e. yDesc describes dy of the backward ones.
+    Invoker PrepareSolution(Handle& handle,
+                            conv::Direction direction,
+                            const TensorDescriptor& xDesc,
+                            const TensorDescriptor& wDesc,
+                            const TensorDescriptor& yDesc,
+                            solver::Id solver_id) const;
+
     std::size_t BackwardWeightsGetWorkSpaceSize(Handle& handle,
                                                 const TensorDescriptor& dyDesc,
                                                 const TensorDescriptor& xDesc,
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COW_REGISTRY_HPP_
+#define GUARD_MIOPEN_COW_REGISTRY_HPP_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+/// Process-wide registry of objects that are looked up much more often than added and are never
+/// removed. Lookups take no lock: they read an immutable map which is published atomically.
+/// Inserts are serialized, copy the current map, add the new entry and publish the copy.
+///
+/// The registry does not own the values. Published maps are kept alive until the registry is
+/// destroyed, because concurrent readers may still use them.
+template <class TValue>
+class CowRegistry
+{
+    using Map = std::unordered_map<std::string, TValue*>;
+
+    public:
+    CowRegistry() = default;
+    CowRegistry(const CowRegistry&) = delete;
+    CowRegistry& operator=(const CowRegistry&) = delete;
+
+    TValue* Find(const std::string& key) const
+    {
+        const auto map = current.load(std::memory_order_acquire);
+        if(map == nullptr)
+            return nullptr;
+        const auto it = map->find(key);
+        return it == map->end() ? nullptr : it->second;
+    }
+
+    /// Returns the value under the key. If there is none, TFactory is called under the insert
+    /// lock to create it. TFactory shall return TValue*.
+    template <class TFactory>
+    TValue& GetOrInsert(const std::string& key, TFactory&& factory)
+    {
+        if(const auto found = Find(key))
+            return *found;
+
+        const std::lock_guard<std::mutex> lock{mutex};
+
+        if(const auto found = Find(key))
+            return *found;
+
+        auto next        = snapshots.empty() ? std::make_unique<Map>()
+                                             : std::make_unique<Map>(*snapshots.back());
+        const auto value = factory();
+        next->emplace(key, value);
+        current.store(next.get(), std::memory_order_release);
+        snapshots.push_back(std::move(next));
+        return *value;
+    }
+
+    private:
+    std::atomic<const Map*> current{nullptr};
+    std::mutex mutex;
+    std::vector<std::unique_ptr<const Map>> snapshots;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COW_REGISTRY_HPP_
@@ -35,6 +35,7 @@
 
 #include <chrono>
 #include <string>
+#include <utility>
 
 namespace boost {
 namespace filesystem {
@@ -46,6 +47,7 @@ namespace miopen {
 
 struct RecordPositions;
 class LockFile;
+class PlainTextDbIndex;
 
 /// No instance of this class should be used from several threads at the same time.
 class PlainTextDb
@@ -100,6 +102,13 @@ class PlainTextDb
 
     bool Remove(const std::string& key, const std::string& id);
 
+    /// Rewrites the db file dropping records superseded by later updates. Normally this is done
+    /// automatically in background, once the superseded records take a noticeable part of the
+    /// file.
+    ///
+    /// Returns true if compaction was successful, false otherwise.
+    bool Compact();
+
     template <class T>
     inline bool RemoveRecord(const T& problem_config)
     {
@@ -144,6 +153,7 @@ class PlainTextDb
     private:
     std::string filename;
     LockFile& lock_file;
+    PlainTextDbIndex& index;
     const bool warn_if_unreadable;
 
     boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, RecordPositions* pos);
@@ -151,6 +161,7 @@ class PlainTextDb
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
+    void ScheduleCompactionIfNeeded();
 
     template <class T>
     inline boost::optional<DbRecord> FindRecordUnsafe(const T& problem_config)
@@ -287,6 +298,15 @@ class MultiFileDb
 #endif
     }
 
+#if !MIOPEN_DISABLE_USERDB
+    /// Groups the changes into one transaction if the user db supports it.
+    template <class TDb = TUser>
+    auto BeginBatch() -> decltype(std::declval<TDb&>().BeginBatch())
+    {
+        return _user.BeginBatch();
+    }
+#endif
+
     private:
     template <class TDb, class TRet = decltype(TDb::GetCached("", true, "", 0))>
     static TRet GetDbInstance(rank<1>,
@@ -0,0 +1,454 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_CACHE_HPP_
+#define GUARD_MIOPEN_DB_CACHE_HPP_
+
+#include <miopen/config.h>
+#include <miopen/cow_registry.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/rank.hpp>
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Bounded LRU cache of the results of FindRecord, keyed by the serialized problem config.
+/// Absence of a record is cached too. There is one cache per db, shared by the whole process.
+class DbRecordCache
+{
+    public:
+    struct Stats
+    {
+        std::uint64_t hits;
+        std::uint64_t misses;
+    };
+
+    DbRecordCache(std::size_t capacity_) : capacity(capacity_) {}
+    DbRecordCache(const DbRecordCache&) = delete;
+    DbRecordCache& operator=(const DbRecordCache&) = delete;
+
+    /// Returns the cache for the db identified by the key. The capacity is set by
+    /// MIOPEN_DEBUG_PERFDB_CACHE_SIZE (1024 records by default, 0 disables caching).
+    static DbRecordCache& Get(const std::string& db_key);
+
+    /// Generation of the cache. A record found in the db may only be inserted if no
+    /// invalidation has happened since the generation was taken.
+    std::uint64_t Generation() const { return generation.load(std::memory_order_acquire); }
+
+    bool Find(const std::string& key, boost::optional<DbRecord>& record);
+    void Insert(const std::string& key, const boost::optional<DbRecord>& record, std::uint64_t gen);
+    void Invalidate(const std::string& key);
+    void Clear();
+
+    bool Enabled() const { return capacity != 0; }
+    Stats GetStats() const { return {hits.load(), misses.load()}; }
+
+    private:
+    using Entry = std::pair<std::string, boost::optional<DbRecord>>;
+
+    const std::size_t capacity;
+    std::mutex mutex;
+    /// Most recently used first.
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::atomic<std::uint64_t> generation{0};
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+};
+
+class DbWriteBehindQueueBase
+{
+    public:
+    virtual ~DbWriteBehindQueueBase() = default;
+    /// Waits until all the changes queued so far are written.
+    virtual void Flush() = 0;
+    /// Writes the pending changes and stops the background thread. Changes queued after that
+    /// are not accepted.
+    virtual void Stop() = 0;
+};
+
+/// Set by MIOPEN_PERFDB_WRITE_BEHIND.
+bool IsDbWriteBehindEnabled();
+/// Registers the queue for FlushDbWriteBehindQueues() and for stopping at exit.
+void RegisterDbWriteBehindQueue(DbWriteBehindQueueBase& queue);
+/// Writes the pending changes of all the write-behind queues of the process.
+void FlushDbWriteBehindQueues();
+
+/// Queue of changes to be written to a db by a background thread. Changes of the same ID under
+/// the same key are coalesced: only the last one is written. All the changes collected during
+/// one round are written in a single batch when the db supports batches.
+template <class TInnerDb>
+class DbWriteBehindQueue : public DbWriteBehindQueueBase
+{
+    public:
+    using Write = std::function<void(TInnerDb&)>;
+
+    template <class... TArgs>
+    DbWriteBehindQueue(DbRecordCache& cache_, const TArgs&... args) : db(args...), cache(cache_)
+    {
+    }
+
+    ~DbWriteBehindQueue() override { Stop(); }
+
+    /// Returns the queue for the db identified by the key, creating it from the args if needed.
+    template <class... TArgs>
+    static DbWriteBehindQueue& Get(const std::string& db_key,
+                                   DbRecordCache& cache,
+                                   const TArgs&... args)
+    {
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static auto instances = std::vector<std::unique_ptr<DbWriteBehindQueue>>{};
+        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+        static CowRegistry<DbWriteBehindQueue> registry;
+
+        // The factory runs under the registry insert lock, which also guards instances.
+        return registry.GetOrInsert(db_key, [&]() {
+            instances.push_back(std::make_unique<DbWriteBehindQueue>(cache, args...));
+            RegisterDbWriteBehindQueue(*instances.back());
+            return instances.back().get();
+        });
+    }
+
+    /// Returns false if the queue is stopped, so the change shall be written by the caller.
+    bool Push(const std::string& key, const std::string& id, std::string values, Write write)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            if(stopping)
+                return false;
+            if(!thread.joinable())
+                thread = std::thread{[this]() { Work(); }};
+            pending[key][id] = {std::move(values), std::move(write)};
+        }
+        has_work.notify_one();
+        return true;
+    }
+
+    /// Applies the changes which are not written yet to a record read from the db.
+    void Overlay(const std::string& key, boost::optional<DbRecord>& record) const
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        Overlay(in_flight, key, record);
+        Overlay(pending, key, record);
+    }
+
+    void Flush() override
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        flush_requested = true;
+        has_work.notify_one();
+        written.wait(lock, [&]() { return pending.empty() && in_flight.empty(); });
+    }
+
+    void Stop() override
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        has_work.notify_one();
+        if(thread.joinable())
+            thread.join();
+    }
+
+    private:
+    struct Change
+    {
+        std::string values;
+        Write write;
+    };
+
+    using Changes = std::unordered_map<std::string, std::map<std::string, Change>>;
+
+    TInnerDb db;
+    DbRecordCache& cache;
+    mutable std::mutex mutex;
+    std::condition_variable has_work;
+    std::condition_variable written;
+    Changes pending;
+    /// Changes being written at the moment. These are still visible to Overlay().
+    Changes in_flight;
+    bool flush_requested = false;
+    bool stopping        = false;
+    std::thread thread;
+
+    static void
+    Overlay(const Changes& changes, const std::string& key, boost::optional<DbRecord>& record)
+    {
+        const auto it = changes.find(key);
+        if(it == changes.end())
+            return;
+        if(!record)
+            record = DbRecord{key};
+        for(const auto& change : it->second)
+            record->SetValues(change.first, change.second.values);
+    }
+
+    template <class TDb>
+    static auto BeginBatch(rank<1>, TDb& db) -> decltype(db.BeginBatch())
+    {
+        return db.BeginBatch();
+    }
+
+    template <class TDb>
+    static int BeginBatch(rank<0>, TDb&)
+    {
+        return 0;
+    }
+
+    void Work()
+    {
+        // Changes arriving within this time are written together.
+        constexpr auto coalescing_time = std::chrono::milliseconds{100};
+        std::unique_lock<std::mutex> lock{mutex};
+
+        while(true)
+        {
+            has_work.wait(lock, [&]() { return stopping || !pending.empty(); });
+            if(pending.empty())
+                return;
+
+            has_work.wait_for(lock, coalescing_time, [&]() { return stopping || flush_requested; });
+            flush_requested = false;
+            in_flight.swap(pending);
+            lock.unlock();
+
+            {
+                const auto batch = BeginBatch(rank<1>{}, db);
+                for(const auto& record : in_flight)
+                {
+                    for(const auto& change : record.second)
+                    {
+                        try
+                        {
+                            change.second.write(db);
+                        }
+                        catch(const std::exception& ex)
+                        {
+                            MIOPEN_LOG_E("Failed to write a db record in background: "
+                                         << ex.what());
+                        }
+                    }
+                }
+            }
+
+            for(const auto& record : in_flight)
+                cache.Invalidate(record.first);
+
+            lock.lock();
+            in_flight.clear();
+            written.notify_all();
+        }
+    }
+};
+
+/// Caches the records found in the inner db, so repeated lookups for the same problem config
+/// do not query the underlying files. Changes made through any CachedDb for the same db
+/// invalidate the affected record. Changes made by other processes are not seen until the
+/// record is evicted.
+///
+/// If write-behind is enabled, Update() only queues the change, and it is written later by a
+/// background thread. The queued changes are visible to the lookups in this process. Other
+/// changes wait until the queue is written.
+template <class TInnerDb>
+class CachedDb
+{
+    public:
+    CachedDb(const std::string& installed_path,
+             const std::string& user_path,
+             const std::string& arch  = "",
+             const std::size_t num_cu = 0)
+        : inner(installed_path, user_path, arch, num_cu)
+    {
+        const auto db_key =
+            installed_path + '\n' + user_path + '\n' + arch + '\n' + std::to_string(num_cu);
+        cache = &DbRecordCache::Get(db_key);
+#if !MIOPEN_DISABLE_USERDB
+        if(IsDbWriteBehindEnabled())
+            queue = &DbWriteBehindQueue<TInnerDb>::Get(
+                db_key, *cache, installed_path, user_path, arch, num_cu);
+#endif
+    }
+
+    template <class T>
+    boost::optional<DbRecord> FindRecord(const T& problem_config)
+    {
+        if(!cache->Enabled() && queue == nullptr)
+            return inner.FindRecord(problem_config);
+
+        const auto key = KeyOf(problem_config);
+        auto record    = boost::optional<DbRecord>{};
+
+        if(!cache->Find(key, record))
+        {
+            const auto gen = cache->Generation();
+            record         = inner.FindRecord(problem_config);
+            cache->Insert(key, record, gen);
+        }
+
+        if(queue != nullptr)
+            queue->Overlay(key, record);
+        return record;
+    }
+
+    template <class T, class V>
+    bool Load(const T& problem_config, const std::string& id, V& values)
+    {
+        if(!cache->Enabled() && queue == nullptr)
+            return inner.Load(problem_config, id, values);
+
+        const auto record = FindRecord(problem_config);
+        return record && record->GetValues(id, values);
+    }
+
+    template <typename... U>
+    auto StoreRecord(U&... args)
+    {
+        Flush();
+        const auto key = KeyOf(args...);
+        auto ret       = inner.StoreRecord(args...);
+        cache->Invalidate(key);
+        return ret;
+    }
+
+    template <typename... U>
+    auto UpdateRecord(U&... args)
+    {
+        Flush();
+        const auto key = KeyOf(args...);
+        auto ret       = inner.UpdateRecord(args...);
+        cache->Invalidate(key);
+        return ret;
+    }
+
+    template <typename... U>
+    auto RemoveRecord(const U&... args)
+    {
+        Flush();
+        const auto key = KeyOf(args...);
+        auto ret       = inner.RemoveRecord(args...);
+        cache->Invalidate(key);
+        return ret;
+    }
+
+    template <class T, class V>
+    auto Update(const T& problem_config, const std::string& id, const V& values)
+    {
+        using Result   = decltype(inner.Update(problem_config, id, values));
+        const auto key = KeyOf(problem_config);
+
+        if(queue != nullptr)
+        {
+            auto serialized  = DbRecord::Serialize(values);
+            const auto write = [problem_config, id, values](TInnerDb& db) {
+                db.Update(problem_config, id, values);
+            };
+
+            if(queue->Push(key, id, serialized, write))
+                return QueuedResult(static_cast<Result*>(nullptr), key, id, serialized);
+        }
+
+        auto ret = inner.Update(problem_config, id, values);
+        cache->Invalidate(key);
+        return ret;
+    }
+
+    template <typename... U>
+    auto Remove(const U&... args)
+    {
+        Flush();
+        const auto key = KeyOf(args...);
+        auto ret       = inner.Remove(args...);
+        cache->Invalidate(key);
+        return ret;
+    }
+
+    DbRecordCache::Stats GetCacheStats() const { return cache->GetStats(); }
+
+    /// Waits until the changes queued for write-behind are written.
+    void Flush()
+    {
+        if(queue != nullptr)
+            queue->Flush();
+    }
+
+    private:
+    TInnerDb inner;
+    DbRecordCache* cache                = nullptr;
+    DbWriteBehindQueue<TInnerDb>* queue = nullptr;
+
+    static const std::string& KeyOf(const DbRecord& record) { return record.GetKey(); }
+    static const std::string& KeyOf(const std::string& key) { return key; }
+
+    template <class T>
+    static std::string KeyOf(const T& problem_config)
+    {
+        return DbRecord::Serialize(problem_config);
+    }
+
+    template <class T, class U, class... Us>
+    static auto KeyOf(const T& problem_config, const U&, const Us&...)
+    {
+        return KeyOf(problem_config);
+    }
+
+    static bool
+    QueuedResult(const bool*, const std::string&, const std::string&, const std::string&)
+    {
+        return true;
+    }
+
+    static boost::optional<DbRecord> QueuedResult(const boost::optional<DbRecord>*,
+                                                  const std::string& key,
+                                                  const std::string& id,
+                                                  const std::string& values)
+    {
+        auto record = DbRecord{key};
+        record.SetValues(id, values);
+        return record;
+    }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_CACHE_HPP_
@@ -30,11 +30,14 @@
 
 #include <miopen/logger.hpp>
 
+#include <boost/utility/string_view.hpp>
+
 #include <cassert>
-#include <istream>
+#include <cstdint>
+#include <ostream>
 #include <sstream>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace miopen {
 
@@ -68,40 +71,49 @@ namespace miopen {
 /// All operations are MP- and MT-safe.
 class DbRecord
 {
+    private:
+    /// Location of an ID:VALUES pair in the buffer.
+    struct Entry
+    {
+        std::uint32_t id_offset;
+        std::uint32_t id_size;
+        std::uint32_t values_offset;
+        std::uint32_t values_size;
+    };
+
     public:
     template <class TValue>
     class Iterator : public std::iterator<std::input_iterator_tag, std::pair<std::string, TValue>>
     {
         friend class DbRecord;
 
-        using Container     = std::unordered_map<std::string, std::string>;
-        using InnerIterator = Container::const_iterator;
+        using InnerIterator = std::vector<Entry>::const_iterator;
 
         public:
         using Value = std::pair<std::string, TValue>;
 
         Value operator*() const
         {
-            assert(it != container->end());
+            assert(it != record->entries.end());
             return value;
         }
 
         const Value* operator->() const
         {
-            assert(it != container->end());
+            assert(it != record->entries.end());
             return &value;
         }
 
         Value* operator->()
         {
-            assert(it != container->end());
+            assert(it != record->entries.end());
             return &value;
         }
 
         Iterator& operator++()
         {
             ++it;
-            value = GetValue(it, container);
+            value = GetValue(it, record);
             return *this;
         }
 
@@ -117,22 +129,22 @@ class DbRecord
 
         private:
         InnerIterator it;
-        const Container* container;
+        const DbRecord* record;
         Value value;
 
-        Iterator(const InnerIterator it_, const Container* container_)
-            : it(it_), container(container_), value(GetValue(it_, container))
+        Iterator(const InnerIterator it_, const DbRecord* record_)
+            : it(it_), record(record_), value(GetValue(it_, record))
         {
         }
 
-        static Value GetValue(const InnerIterator& it, const Container* container)
+        static Value GetValue(const InnerIterator& it, const DbRecord* record)
         {
-            if(it == container->end())
+            if(it == record->entries.end())
                 return {};
 
             auto value = TValue{};
-            value.Deserialize(it->second);
-            return {it->first, value};
+            value.Deserialize(record->Values(*it).to_string());
+            return {record->Id(*it).to_string(), value};
         }
     };
 
@@ -140,8 +152,8 @@ class DbRecord
     class IterationHelper
     {
         public:
-        Iterator<TValue> begin() const { return {record.map.begin(), &record.map}; }
-        Iterator<TValue> end() const { return {record.map.end(), &record.map}; }
+        Iterator<TValue> begin() const { return {record.entries.begin(), &record}; }
+        Iterator<TValue> end() const { return {record.entries.end(), &record}; }
 
         private:
         IterationHelper(const DbRecord& record_) : record(record_) {}
@@ -152,7 +164,12 @@ class DbRecord
 
     private:
     std::string key;
-    std::unordered_map<std::string, std::string> map;
+    /// IDs and VALUES of the record. Replaced and erased ones are left in place until there are
+    /// too many of them.
+    std::string buffer;
+    /// Sorted by ID.
+    std::vector<Entry> entries;
+    std::size_t unused = 0;
 
     template <class T>
     static // 'static' is for calling from ctor
@@ -164,19 +181,28 @@ class DbRecord
         return ss.str();
     }
 
-    bool ParseContents(std::istream& contents);
-    void WriteContents(std::ostream& stream) const;
+    boost::string_view Id(const Entry& entry) const
+    {
+        return {buffer.data() + entry.id_offset, entry.id_size};
+    }
+
+    boost::string_view Values(const Entry& entry) const
+    {
+        return {buffer.data() + entry.values_offset, entry.values_size};
+    }
+
+    std::vector<Entry>::const_iterator Find(boost::string_view id) const;
+    Entry Append(boost::string_view id, boost::string_view values);
+    void Compact();
+    /// Adds the pair unless there is one with the same ID. Does not log.
+    bool Emplace(boost::string_view id, boost::string_view values);
+    bool HasSameContents(const DbRecord& other) const;
+
     bool SetValues(const std::string& id, const std::string& values);
     bool GetValues(const std::string& id, std::string& values) const;
 
     DbRecord(const std::string& key_) : key(key_) {}
 
-    bool ParseContents(const std::string& contents)
-    {
-        auto ss = std::istringstream(contents);
-        return ParseContents(ss);
-    }
-
     public:
     DbRecord() : key(""){};
     /// T shall provide a db KEY by means of the "void Serialize(std::ostream&) const" member
@@ -186,7 +212,16 @@ class DbRecord
     {
     }
 
-    auto GetSize() const { return map.size(); }
+    auto GetSize() const { return entries.size(); }
+
+    /// Replaces the contents with ID:VALUES pairs parsed from the contents of a db line, i.e.
+    /// the part after "KEY=". Ill-formed pairs are skipped, of the pairs with the same ID only
+    /// the first one is kept.
+    ///
+    /// Returns false if no pair was found.
+    bool ParseContents(boost::string_view contents);
+    /// Writes the record as a db line, unless it is empty. IDs are written in sorted order.
+    void WriteContents(std::ostream& stream) const;
 
     const std::string& GetKey() const { return key; }
 
@@ -242,6 +277,11 @@ class DbRecord
     friend class PlainTextDb;
     friend class SQLitePerfDb;
     friend class ReadonlyRamDb;
+    friend class BinaryDb;
+    template <class TInnerDb>
+    friend class CachedDb;
+    template <class TInnerDb>
+    friend class DbWriteBehindQueue;
 };
 
 } // namespace miopen
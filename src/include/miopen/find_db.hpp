@@ -27,6 +27,7 @@
 #ifndef GUARD_MIOPEN_FIND_DB_HPP_
 #define GUARD_MIOPEN_FIND_DB_HPP_
 
+#include <miopen/binary_db.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_path.hpp>
 #include <miopen/db_record.hpp>
@@ -40,16 +41,20 @@
 #include <vector>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DISABLE_FIND_DB)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_DB_PREFETCH)
 
 namespace miopen {
 
 struct Handle;
-struct NetworkConfig;
+class ProblemKey;
 
 template <class TDb>
 class FindDbRecord_t;
 
-#if MIOPEN_DEBUG_FIND_DB_CACHING
+#if MIOPEN_DEBUG_FIND_DB_CACHING && MIOPEN_USE_BINARY_FIND_DB
+using SystemFindDb = BinaryDb;
+using UserFindDb   = PlainTextDb;
+#elif MIOPEN_DEBUG_FIND_DB_CACHING
 using SystemFindDb = ReadonlyRamDb;
 using UserFindDb   = PlainTextDb;
 #else
@@ -68,6 +73,10 @@ testing_find_db_path_override(); /// \todo Remove when #1723 is resolved.
 
 bool CheckInvokerSupport(const std::string& algo);
 
+/// Starts loading the System Find-Db used with the handle in background, so the first Find()
+/// or Immediate mode call does not have to wait for it. Enabled by MIOPEN_FIND_DB_PREFETCH.
+void PrefetchFindDb(Handle& handle);
+
 template <class TDb>
 class FindDbRecord_t
 {
@@ -140,9 +149,9 @@ class FindDbRecord_t
         auto ret = std::vector<PerfField>{};
         FindDbRecord_t<TDb> record{handle, problem};
 
-        const auto network_config = problem.BuildConfKey();
+        const auto problem_key = problem.BuildProblemKey();
 
-        if(record.in_sync && !record.Validate(handle, network_config))
+        if(record.in_sync && !record.Validate(handle, problem_key))
         {
             record.CopyTo(ret);
             return ret;
@@ -170,8 +179,10 @@ class FindDbRecord_t
     static std::string GetInstalledPath(Handle& handle);
     static std::string GetUserPath(Handle& handle);
 
+    friend void PrefetchFindDb(Handle& handle);
+
     // Returns true if rebuild is required
-    bool Validate(Handle& handle, const NetworkConfig& config) const;
+    bool Validate(Handle& handle, const ProblemKey& problem_key) const;
     void CopyTo(std::vector<PerfField>& to) const;
 
     void LogFindDbItem(const std::pair<std::string, FindDbData>& pair,
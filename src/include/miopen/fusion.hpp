@@ -52,10 +52,19 @@ enum FusionKernelSourceType
 struct OperatorArgs : miopenOperatorArgs
 {
     OperatorArgs();
+    /// Sets the argument, replacing the value if it has been set before.
     void ins_arg(std::string name, OpKernelArg v);
+    /// Index of the argument in args_vec or -1 if it has not been set.
+    int FindSlot(const std::string& name) const;
+    /// Changes whenever an argument is added, so slots found for one layout id stay valid
+    /// for as long as it is the same.
+    std::size_t GetLayoutId() const { return layout_id; }
     friend std::ostream& operator<<(std::ostream& stream, const OperatorArgs& x);
     std::vector<OpKernelArg> args_vec;
-    std::unordered_map<std::string, OpKernelArg> args_map;
+    std::unordered_map<std::string, std::size_t> args_slots;
+
+    private:
+    std::size_t layout_id;
 };
 
 struct FusionOpDescriptor : miopenFusionOpDescriptor
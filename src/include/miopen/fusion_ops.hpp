@@ -27,8 +27,10 @@
 #ifndef MIOPEN_GUARD_MLOPEN_FUSION_OPS_HPP
 #define MIOPEN_GUARD_MLOPEN_FUSION_OPS_HPP
 
+#include <functional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <boost/any.hpp>
 
@@ -74,6 +76,69 @@ std::ostream& operator<<(std::ostream& stream, const boost::any& a);
 // using FusionMDGraph_Op_Map       = std::unordered_map<std::string, EdgeOp>;
 using FusionMDGraph_Edge_Map     = std::unordered_map<std::string, std::vector<std::string>>;
 using FusionMDGraph_Edge_Map_Vec = std::vector<FusionMDGraph_Edge_Map>;
+
+/// Values of the symbols used by the edge constraints while an operator is matched. Symbols
+/// are referred to by their index in the symbol table of the graph.
+struct MDGraph_symbols
+{
+    MDGraph_symbols(const std::vector<std::string>& symbol_names)
+        : names(symbol_names), attrs(symbol_names.size()), has_attr(symbol_names.size())
+    {
+    }
+
+    const std::vector<std::string>& names;
+    /// Attributes of the operator, tensors and the device.
+    std::vector<int> attrs;
+    std::vector<char> has_attr;
+    /// Symbols assigned by the constraints of the edge being matched, in the order of assignment.
+    std::vector<std::pair<int, int>> assigned;
+
+    bool GetAssigned(int symbol, int& val) const;
+};
+
+/// Edge constraint expression parsed once when the graph is compiled.
+struct MDGraph_expr
+{
+    enum NodeKind
+    {
+        Constant,
+        Symbol,
+        Binary,
+    };
+
+    struct Node
+    {
+        NodeKind kind;
+        MDGraph_op_t op;
+        /// The constant or the symbol index.
+        int value;
+        int lhs;
+        int rhs;
+    };
+
+    struct Result
+    {
+        int res    = 0;
+        bool b_res = false;
+        /// Symbol that has neither an attribute nor an assigned value, -1 if none.
+        int unresolved = -1;
+    };
+
+    /// Nodes in the evaluation order, the root is the last one.
+    std::vector<Node> nodes;
+    std::string source;
+
+    /// Parses the expression, intern returns the index of a symbol.
+    static MDGraph_expr Parse(const std::string& src,
+                              const std::function<int(const std::string&)>& intern);
+    /// Throws on access to an unresolved symbol, the same way the tree_visit does.
+    Result Eval(MDGraph_symbols& syms) const;
+    /// Appends the indices of all the symbols used by the expression.
+    void GetSymbols(std::vector<int>& symbols) const;
+
+    private:
+    Result Eval(MDGraph_symbols& syms, int node) const;
+};
 } // namespace miopen
 
 #endif
@@ -6,6 +6,14 @@
 #include <miopen/tensor.hpp>
 #include <miopen/fusion.hpp>
 #include <miopen/md_graph.hpp>
+#include <miopen/kernel.hpp>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
@@ -35,6 +43,65 @@ struct Exec_arg_t
     }
 };
 
+/// Kernel arguments of a compiled fusion plan in the kernel order. The values known at compile
+/// time are stored in args, the tensor pointers and the operator arguments are put over them
+/// at the recorded positions on every execution.
+struct FusionArgPlan
+{
+    std::vector<OpKernelArg> args;
+    std::vector<std::size_t> input_positions;
+    std::vector<std::size_t> output_positions;
+    std::vector<std::size_t> op_arg_positions;
+    std::vector<std::string> op_arg_keys;
+    /// Slots of op_arg_keys in the OperatorArgs with the layout id bound_layout.
+    std::size_t bound_layout = 0;
+    std::vector<std::size_t> bound_slots;
+};
+
+/// What Compile finds for a fusion plan: the graph vertex and the solver, the kernel with its
+/// build parameters and the argument order.
+struct CompiledFusionPlan
+{
+    std::pair<MDGraph_vertex_ptr, MDGraph_path_state> vertex;
+    FusionKernelSourceType kernel_source_type = OpenclText;
+    std::string program_name;
+    std::string kernel_name;
+    std::string algorithm_name;
+    std::string compile_config;
+    std::vector<size_t> vld;
+    std::vector<size_t> vgd;
+    std::vector<Exec_arg_t> arg_list;
+};
+
+/// Process-wide cache of the compiled fusion plans, so that the plans with the same operators,
+/// descriptors and device, e.g. the identical blocks of a model, are compiled once. Other
+/// handles build the kernel from the cached parameters, without the solver search.
+/// The least recently used plans are dropped once the capacity is reached.
+class FusionPlanCache
+{
+    public:
+    FusionPlanCache(std::size_t capacity_) : capacity(capacity_) {}
+    FusionPlanCache(const FusionPlanCache&) = delete;
+    FusionPlanCache& operator=(const FusionPlanCache&) = delete;
+
+    /// The capacity is set by MIOPEN_DEBUG_FUSION_PLAN_CACHE_SIZE (1024 plans by default,
+    /// 0 disables caching).
+    static FusionPlanCache& Get();
+
+    bool Find(const std::string& key, CompiledFusionPlan& plan);
+    void Insert(const std::string& key, CompiledFusionPlan plan);
+    std::size_t GetSize() const;
+
+    private:
+    using Entry = std::pair<std::string, CompiledFusionPlan>;
+
+    const std::size_t capacity;
+    mutable std::mutex mutex;
+    /// Most recently used first.
+    std::list<Entry> plans;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+};
+
 struct FusionPlanDescriptor : miopenFusionPlanDescriptor
 {
     FusionPlanDescriptor(miopenFusionDirection_t dir, const TensorDescriptor& inDesc);
@@ -68,6 +135,9 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     auto GetLocalWGSz();
     auto GetGlobalWGSz();
     std::vector<Exec_arg_t> CalcArgOrder(const Handle& handle);
+    FusionArgPlan MakeArgPlan() const;
+    void SetCompiled(const Handle& handle);
+    std::string GetCacheKey(const Handle& handle) const;
     bool GetEnumVal(const std::string& sym, int& val) const;
     OpKernelArg GetDevAttribute(const std::string& k, const Handle& handle) const;
     OpKernelArg GetTensorAttr(const std::string& sym) const;
@@ -90,6 +160,11 @@ struct FusionPlanDescriptor : miopenFusionPlanDescriptor
     std::string network_config;
     miopenDataType_t data_type;
     std::vector<Exec_arg_t> arg_list;
+    FusionArgPlan arg_plan;
+    std::mutex arg_plan_mutex;
+    /// Id of the handle the plan was compiled for and runs compiled_kernel on, 0 if none.
+    std::size_t compiled_handle_id = 0;
+    Kernel compiled_kernel;
 };
 
 } // namespace miopen
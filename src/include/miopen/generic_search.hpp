@@ -32,7 +32,20 @@
 #include <miopen/handle.hpp>
 #include <miopen/invoke_params.hpp>
 #include <miopen/env.hpp>
+#include <miopen/par_for.hpp>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <cstdlib>
 #include <limits>
@@ -45,6 +58,7 @@
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/timer.hpp>
+#include <miopen/tuning_checkpoint.hpp>
 
 namespace miopen {
 namespace solver {
@@ -212,6 +226,220 @@ class HeartBeat
     }
 };
 
+/// Ways for GenericSearch to pick the configs to time.
+enum class SearchStrategy
+{
+    /// Times the configs in the order of enumeration.
+    Exhaustive,
+    /// Times the configs in random order.
+    Random,
+    /// Times each config once, then repeatedly keeps the fastest quarter and times it again
+    /// with twice as many runs, until one config is left.
+    SuccessiveHalving,
+    /// Times the configs in the order of the cost estimated by the solver, cheapest first.
+    /// Solvers without EstimateCost() are searched in the order of enumeration.
+    CostModel,
+};
+
+/// Name of the strategy in MIOPEN_DEBUG_TUNING_STRATEGY.
+const char* ToString(SearchStrategy strategy);
+
+/// Settings of GenericSearch, taken from the environment:
+/// - MIOPEN_DEBUG_TUNING_STRATEGY: exhaustive (default), random, halving or cost.
+/// - MIOPEN_DEBUG_TUNING_BUDGET_MS: no new configs are timed after that many milliseconds.
+/// - MIOPEN_DEBUG_TUNING_MAX_CONFIGS: at most that many configs are timed.
+/// - MIOPEN_DEBUG_TUNING_SEED: seed of the random order.
+/// - MIOPEN_DEBUG_TUNING_COMPARE_EXHAUSTIVE: when the search is not exhaustive, run the
+///   exhaustive one as well and report how far the result is from the optimum.
+struct SearchOptions
+{
+    SearchStrategy strategy = SearchStrategy::Exhaustive;
+    /// Zero means no limit.
+    std::size_t budget_ms   = 0;
+    std::size_t max_configs = 0;
+    unsigned seed           = 0;
+    bool compare_exhaustive = false;
+
+    static SearchOptions FromEnv();
+
+    bool IsExhaustive() const
+    {
+        return strategy == SearchStrategy::Exhaustive && budget_ms == 0 && max_configs == 0;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const SearchOptions& options);
+};
+
+/// Prepares the candidates of GenericSearch ahead of their timing.
+///
+/// A producer thread walks the configs in batches, computes the solutions of a batch in
+/// parallel and builds the kernels they need, while the caller times the batches that are
+/// already prepared. At most max_ready batches wait for the caller, so that the programs do not
+/// pile up when the timing is the bottleneck.
+///
+/// The program cache of the handle is only touched by the caller: the producer builds the
+/// programs without adding them, as PrecompileKernels does, and Next() adds them.
+template <typename PerformanceConfig>
+class SearchPipeline
+{
+    public:
+    struct Candidate
+    {
+        PerformanceConfig config;
+        ConvSolution solution;
+        /// Thrown by GetSolution for the config.
+        std::exception_ptr error;
+    };
+
+    template <class GetSolution>
+    SearchPipeline(const Handle& h_,
+                   std::vector<PerformanceConfig> configs,
+                   GetSolution get_solution,
+                   std::size_t batch_size_ = 16,
+                   std::size_t max_ready_  = 2)
+        : h(h_), batch_size(std::max<std::size_t>(batch_size_, 1)), max_ready(max_ready_)
+    {
+        producer = std::thread([this, configs = std::move(configs), get_solution]() {
+            Produce(configs, get_solution);
+        });
+    }
+
+    SearchPipeline(const SearchPipeline&) = delete;
+    SearchPipeline& operator=(const SearchPipeline&) = delete;
+
+    ~SearchPipeline()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        changed.notify_all();
+        producer.join();
+    }
+
+    /// Waits for the next batch, in the order of the configs, and adds its programs to the
+    /// handle. Returns false once all the configs have been taken.
+    bool Next(std::vector<Candidate>& candidates)
+    {
+        Batch batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]() { return !ready.empty() || done; });
+
+            if(ready.empty())
+            {
+                if(error)
+                    std::rethrow_exception(error);
+                return false;
+            }
+
+            batch = std::move(ready.front());
+            ready.pop_front();
+        }
+        changed.notify_all();
+
+        for(std::size_t i = 0; i < batch.kernels.size(); ++i)
+        {
+            const auto& k = batch.kernels[i];
+            if(batch.programs[i] && !h.HasProgram(k.kernel_file, k.comp_options))
+                h.AddProgram(*batch.programs[i], k.kernel_file, k.comp_options);
+        }
+
+        candidates = std::move(batch.candidates);
+        return true;
+    }
+
+    private:
+    struct Batch
+    {
+        std::vector<Candidate> candidates;
+        /// Kernels first used by the batch and their programs, empty if the build failed.
+        std::vector<KernelInfo> kernels;
+        std::vector<boost::optional<Program>> programs;
+    };
+
+    const Handle& h;
+    const std::size_t batch_size;
+    const std::size_t max_ready;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Batch> ready;
+    bool stopping = false;
+    bool done     = false;
+    std::exception_ptr error;
+    std::thread producer;
+
+    bool IsStopping()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stopping;
+    }
+
+    template <class GetSolution>
+    void Produce(const std::vector<PerformanceConfig>& configs, const GetSolution& get_solution)
+    {
+        try
+        {
+            // Kernels requested by the previous batches. The handle can not be asked, as the
+            // caller adds programs to it concurrently.
+            std::set<std::pair<std::string, std::string>> requested;
+            auto it = configs.begin();
+
+            while(it != configs.end() && !IsStopping())
+            {
+                Batch batch;
+                for(; it != configs.end() && batch.candidates.size() < batch_size; ++it)
+                {
+                    batch.candidates.emplace_back();
+                    batch.candidates.back().config = *it;
+                }
+
+                par_for(batch.candidates.size(), min_grain{1}, [&](auto i) {
+                    auto& candidate = batch.candidates[i];
+                    try
+                    {
+                        candidate.solution = get_solution(candidate.config);
+                    }
+                    catch(...)
+                    {
+                        candidate.error = std::current_exception();
+                    }
+                });
+
+                for(const auto& candidate : batch.candidates)
+                {
+                    if(candidate.error)
+                        continue;
+                    for(const auto& kernel : candidate.solution.construction_params)
+                        if(requested.emplace(kernel.kernel_file, kernel.comp_options).second)
+                            batch.kernels.push_back(kernel);
+                }
+
+                batch.programs = TryPrecompileKernels(h, batch.kernels);
+
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [&]() { return stopping || ready.size() < max_ready; });
+                if(stopping)
+                    break;
+                ready.push_back(std::move(batch));
+                changed.notify_all();
+            }
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        changed.notify_all();
+    }
+};
+
 inline void InitRandomly(std::vector<float>& vec, const double offset, const double factor)
 {
     float* p = vec.data();
@@ -298,175 +526,487 @@ using RunAndMeasure_t =
                                                           std::declval<ConvSolution>(),
                                                           std::declval<float&>()));
 
-template <class Solver, class Context>
-auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParams& invoke_ctx_)
-    -> decltype(s.GetPerformanceConfig(context_))
+template <class Solver, class Context, class PerformanceConfig>
+using EstimateCost_t = decltype(std::declval<const Solver&>().EstimateCost(
+    std::declval<const Context&>(), std::declval<const PerformanceConfig&>()));
+
+/// Outcome of timing the configs of a solver.
+template <class PerformanceConfig>
+struct SearchResult
 {
-    static_assert(
-        !(is_detected<RunAndMeasure_t, Solver, ConstData_t, Data_t>{} ||
-          is_detected<RunAndMeasure_t, Solver, Data_t, ConstData_t>{}),
-        "RunAndMeasure is obsolete. Solvers should implement auto-tune evaluation in invoker");
+    PerformanceConfig config;
+    float time       = std::numeric_limits<float>::max();
+    bool is_passed   = false; // left false only if all iterations failed.
+    size_t n_timed   = 0;
+    size_t n_failed  = 0;
+    size_t n_best    = 0;
+    float elapsed_ms = 0.0f;
+};
 
-    auto context                  = context_;
-    context.is_for_generic_search = true;
+/// Times the configs of a solver with the strategy chosen by SearchOptions.
+template <class Solver, class Context, class PerformanceConfig>
+class SearchSession
+{
+    public:
+    using Result = SearchResult<PerformanceConfig>;
 
-    using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
-    PerformanceConfig best_config;
-    const auto default_solution = s.GetSolution(context, s.GetPerformanceConfig(context));
-    const auto invoke_ctx       = [invoke_ctx_]() {
-        auto copy = invoke_ctx_;
-        copy.SetInvokeType(InvokeType::AutoTune);
-        return copy;
-    }();
+    SearchSession(const Solver& s_,
+                  const Context& context_,
+                  const AnyInvokeParams& invoke_ctx_,
+                  const ConvSolution& default_solution_)
+        : s(s_), context(context_), invoke_ctx(invoke_ctx_), default_solution(default_solution_)
+    {
+    }
 
-    auto& profile_h = context.GetStream();
-    AutoEnableProfiling enableProfiling{profile_h};
+    /// Configs recorded in the checkpoint are not timed again, and the new ones are added to it.
+    Result Run(std::vector<PerformanceConfig> configs,
+               const SearchOptions& options,
+               TuningCheckpoint* checkpoint = nullptr) const
+    {
+        Timer timer;
+        timer.start();
 
-    const ComputedContainer<PerformanceConfig, Context> main(context);
-    const int main_size = std::distance(main.begin(), main.end());
-    const ComputedContainer<PerformanceConfig, Context> spare(context, true);
-    const int spare_size = std::distance(spare.begin(), spare.end());
-    const bool useSpare  = (main_size == 0);
+        const auto n_total = configs.size();
+        Order(configs, options);
+        if(options.max_configs != 0 && configs.size() > options.max_configs)
+            configs.resize(options.max_configs);
 
-    const ComputedContainer<PerformanceConfig, Context> all_configs = useSpare ? spare : main;
-    const int n_runs_total = useSpare ? spare_size : main_size;
-    MIOPEN_LOG_W(SolverDbId(s) << ": Searching the best solution among " << n_runs_total
-                               << (useSpare ? " (spare)" : "") << "...");
-
-    bool is_passed  = false; // left false only if all iterations failed.
-    float best_time = std::numeric_limits<float>::max();
-    size_t n_failed = 0;
-    size_t n_best   = 0;
-    HeartBeat<PerformanceConfig> heartbeat;
-    heartbeat.Start();
-
-// PrecompileKernels call saves to binary_cache, this needs to be escaped if KERN_CACHE is not on.
-#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-    std::vector<KernelInfo> kernels;
-    for(const auto& current_config : all_configs)
+        auto result = options.strategy == SearchStrategy::SuccessiveHalving
+                          ? Halving(configs, options, n_total, checkpoint)
+                          : Exhaustive(configs, options, n_total, checkpoint);
+        result.elapsed_ms = timer.elapsed_ms();
+        return result;
+    }
+
+    private:
+    const Solver& s;
+    const Context& context;
+    const AnyInvokeParams& invoke_ctx;
+    const ConvSolution& default_solution;
+
+    void Order(std::vector<PerformanceConfig>& configs, const SearchOptions& options) const
     {
-        ConvSolution current_solution = s.GetSolution(context, current_config, true);
-        for(auto&& kernel : current_solution.construction_params)
+        switch(options.strategy)
         {
-            if(profile_h.HasProgram(kernel.kernel_file, kernel.comp_options))
-                continue;
-            kernels.push_back(kernel);
+        case SearchStrategy::Random:
+            std::shuffle(configs.begin(), configs.end(), std::mt19937{options.seed});
+            break;
+        case SearchStrategy::CostModel:
+            SortByCost(configs,
+                       is_detected<EstimateCost_t, Solver, Context, PerformanceConfig>{});
+            break;
+        case SearchStrategy::Exhaustive:
+        case SearchStrategy::SuccessiveHalving: break;
         }
     }
-    std::ignore = PrecompileKernels(profile_h, kernels);
-#endif
 
-    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+    void SortByCost(std::vector<PerformanceConfig>& configs, std::true_type) const
+    {
+        std::vector<std::pair<float, std::size_t>> costs;
+        costs.reserve(configs.size());
+        for(std::size_t i = 0; i < configs.size(); ++i)
+            costs.emplace_back(s.EstimateCost(context, configs[i]), i);
+        std::stable_sort(costs.begin(), costs.end(), [](const auto& l, const auto& r) {
+            return l.first < r.first;
+        });
+
+        std::vector<PerformanceConfig> sorted;
+        sorted.reserve(configs.size());
+        for(const auto& cost : costs)
+            sorted.push_back(configs[cost.second]);
+        configs = std::move(sorted);
+    }
+
+    void SortByCost(std::vector<PerformanceConfig>&, std::false_type) const
+    {
+        MIOPEN_LOG_I(SolverDbId(s) << ": no cost model, the configs are timed in order");
+    }
+
+    static std::string SerializeConfig(const PerformanceConfig& config)
     {
+        std::ostringstream ss;
+        config.Serialize(ss);
+        return ss.str();
+    }
+
+    /// Prepares the configs and times their first run, in order, until the budget is out.
+    /// Calls on_timed(config, invoker, time, n) for each config that has been run, which
+    /// returns the record to keep in the checkpoint, and on_restored(config, record, n) for
+    /// each config that the checkpoint has a record of, instead of running it again.
+    template <class OnTimed, class OnRestored>
+    void TimeFirstRuns(const std::vector<PerformanceConfig>& configs,
+                       const SearchOptions& options,
+                       size_t n_runs_total,
+                       TuningCheckpoint* checkpoint,
+                       Result& result,
+                       OnTimed on_timed,
+                       OnRestored on_restored) const
+    {
+        auto& profile_h = context.GetStream();
+        Timer timer;
+        timer.start();
+        HeartBeat<PerformanceConfig> heartbeat;
+        heartbeat.Start();
+
         size_t n_current = 0;
-        for(const auto& current_config : all_configs)
+        std::vector<PerformanceConfig> pending;
+        for(const auto& config : configs)
         {
-            float elapsed_time = 0.0f;
-            int ret            = 0;
-            MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
-                              << current_config);
+            const auto record =
+                checkpoint != nullptr ? checkpoint->Find(SerializeConfig(config)) : nullptr;
+            if(record == nullptr)
+            {
+                pending.push_back(config);
+                continue;
+            }
 
-            ConvSolution current_solution;
-            Invoker invoker;
+            if(record->status == TuningCheckpoint::Record::Status::Failed)
+                ++result.n_failed;
+            else
+                on_restored(config, *record, n_current);
+            result.n_timed = ++n_current;
+        }
+
+        if(n_current != 0)
+            MIOPEN_LOG_W("Resuming the search: " << n_current << '/' << result.n_failed << '/'
+                                                 << n_runs_total << " restored, best "
+                                                 << result.time << ' ' << result.config);
+
+        SearchPipeline<PerformanceConfig> pipeline(
+            profile_h, pending, [&](const PerformanceConfig& config) {
+                return s.GetSolution(context, config, true);
+            });
+        std::vector<typename SearchPipeline<PerformanceConfig>::Candidate> batch;
 
-            try
+        while(pipeline.Next(batch))
+        {
+            for(auto& candidate : batch)
             {
-                current_solution = s.GetSolution(context, current_config, true);
-                if(default_solution.workspce_sz != current_solution.workspce_sz)
+                if(options.budget_ms != 0 && timer.elapsed_ms() > options.budget_ms)
                 {
-                    ret = -2;
-                    MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                     << "Workspace size should not depend on PerformanceConfig: "
-                                     << default_solution.workspce_sz
-                                     << " != " << current_solution.workspce_sz);
+                    MIOPEN_LOG_I("Tuning budget of " << options.budget_ms << " ms is out after "
+                                                     << n_current << " configs");
+                    return;
                 }
 
-                invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
-                                                   current_solution.construction_params);
-                invoker(profile_h, invoke_ctx);
-                elapsed_time = profile_h.GetKernelTime();
-            }
-            catch(...)
-            {
-                ret = 1;
+                const auto& current_config   = candidate.config;
+                const auto& current_solution = candidate.solution;
+                float elapsed_time           = 0.0f;
+                int ret                      = 0;
+                MIOPEN_LOG_I2('#' << n_current << '/' << result.n_failed << '/' << n_runs_total
+                                  << ' ' << current_config);
+
+                Invoker invoker;
+
+                try
+                {
+                    if(candidate.error)
+                        std::rethrow_exception(candidate.error);
+                    if(default_solution.workspce_sz != current_solution.workspce_sz)
+                    {
+                        ret = -2;
+                        MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                                         << "Workspace size should not depend on "
+                                            "PerformanceConfig: "
+                                         << default_solution.workspce_sz
+                                         << " != " << current_solution.workspce_sz);
+                    }
+
+                    invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
+                                                       current_solution.construction_params);
+                    invoker(profile_h, invoke_ctx);
+                    elapsed_time = profile_h.GetKernelTime();
+                }
+                catch(...)
+                {
+                    ret = 1;
+                }
+
+                MIOPEN_LOG_T("##"
+                             << "(n_current, n_failed, n_runs_total):  " << n_current << '/'
+                             << result.n_failed << '/' << n_runs_total
+                             << " elapsed_time: " << elapsed_time
+                             << ", best_time: " << result.time << ", " << current_config);
+
+                auto record = TuningCheckpoint::Record{};
+                if(ret == 0)
+                {
+                    record = on_timed(current_config, invoker, elapsed_time, n_current);
+                    if(record.status == TuningCheckpoint::Record::Status::Failed)
+                        ret = 1;
+                }
+                if(checkpoint != nullptr)
+                    checkpoint->Add(SerializeConfig(current_config), record);
+
+                if(ret != 0)
+                {
+                    MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                                     << " Failed rc=" << ret);
+                    ++result.n_failed;
+                }
+                heartbeat.Monitor(ret != 0,
+                                  elapsed_time,
+                                  n_current,
+                                  result.time,
+                                  result.n_failed,
+                                  n_runs_total,
+                                  current_config);
+                ++n_current;
+                result.n_timed = n_current;
             }
+        }
+    }
+
+    Result Exhaustive(const std::vector<PerformanceConfig>& configs,
+                      const SearchOptions& options,
+                      size_t n_runs_total,
+                      TuningCheckpoint* checkpoint) const
+    {
+        using Record = TuningCheckpoint::Record;
 
-            MIOPEN_LOG_T("##"
-                         << "(n_current, n_failed, n_runs_total):  " << n_current << '/' << n_failed
-                         << '/' << n_runs_total << " elapsed_time: " << elapsed_time
-                         << ", best_time: " << best_time << ", " << current_config);
+        auto& profile_h = context.GetStream();
+        Result result;
 
-            if(ret == 0)
+        const auto update_best = [&](const PerformanceConfig& config, float time, size_t n) {
+            result.is_passed = true;
+            if(time < result.time)
             {
+                MIOPEN_LOG_I('#' << n << '/' << result.n_failed << '/' << n_runs_total << ' '
+                                 << time << " < " << result.time << ' ' << config);
+                result.config = config;
+                result.time   = time;
+                result.n_best = n;
+                return true;
+            }
+            return false;
+        };
+
+        TimeFirstRuns(
+            configs,
+            options,
+            n_runs_total,
+            checkpoint,
+            result,
+            [&](const PerformanceConfig& current_config,
+                const Invoker& invoker,
+                float elapsed_time,
+                size_t n_current) {
                 // Smooth the jitter of measurements:
                 // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
                 // then re-run it 4 times more and compute average time,
                 // and decide using average of all 5 attempts vs. the best.
-                if(elapsed_time / best_time < 1.05f)
-                {
-                    MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time
-                                                          << " = " << (elapsed_time / best_time));
+                if(elapsed_time / result.time >= 1.05f)
+                    return Record{Record::Status::Timed, elapsed_time};
 
-                    try
+                MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << result.time
+                                                      << " = " << (elapsed_time / result.time));
+
+                try
+                {
+                    for(int i = 0; i < 4; ++i)
                     {
-                        for(int i = 0; i < 4; ++i)
-                        {
-                            invoker(profile_h, invoke_ctx);
-                            elapsed_time += profile_h.GetKernelTime();
-                        }
+                        invoker(profile_h, invoke_ctx);
+                        elapsed_time += profile_h.GetKernelTime();
                     }
-                    catch(...)
+                }
+                catch(...)
+                {
+                    return Record{};
+                }
+
+                elapsed_time /= 5;
+                if(!update_best(current_config, elapsed_time, n_current))
+                {
+                    MIOPEN_LOG_I2("Average is not better: " << elapsed_time
+                                                            << " >= " << result.time);
+                }
+                return Record{Record::Status::Averaged, elapsed_time};
+            },
+            [&](const PerformanceConfig& config, const Record& record, size_t n) {
+                if(record.status == Record::Status::Averaged)
+                    update_best(config, record.time, n);
+            });
+
+        return result;
+    }
+
+    Result Halving(const std::vector<PerformanceConfig>& configs,
+                   const SearchOptions& options,
+                   size_t n_runs_total,
+                   TuningCheckpoint* checkpoint) const
+    {
+        using Record = TuningCheckpoint::Record;
+
+        struct Contender
+        {
+            PerformanceConfig config;
+            /// Empty for the configs restored from the checkpoint.
+            Invoker invoker;
+            size_t n;
+            float total_time;
+            int runs;
+
+            float Average() const { return total_time / static_cast<float>(runs); }
+        };
+
+        auto& profile_h = context.GetStream();
+        Result result;
+        std::vector<Contender> contenders;
+
+        TimeFirstRuns(
+            configs,
+            options,
+            n_runs_total,
+            checkpoint,
+            result,
+            [&](const PerformanceConfig& current_config,
+                const Invoker& invoker,
+                float elapsed_time,
+                size_t n_current) {
+                contenders.push_back({current_config, invoker, n_current, elapsed_time, 1});
+                result.time = std::min(result.time, elapsed_time);
+                return Record{Record::Status::Timed, elapsed_time};
+            },
+            [&](const PerformanceConfig& config, const Record& record, size_t n) {
+                contenders.push_back({config, Invoker{}, n, record.time, 1});
+                result.time = std::min(result.time, record.time);
+            });
+
+        for(int runs = 2; contenders.size() > 1; runs *= 2)
+        {
+            std::stable_sort(contenders.begin(),
+                             contenders.end(),
+                             [](const Contender& l, const Contender& r) {
+                                 return l.Average() < r.Average();
+                             });
+            contenders.resize((contenders.size() + 3) / 4);
+
+            for(auto& contender : contenders)
+            {
+                try
+                {
+                    if(!contender.invoker)
                     {
-                        ret = 1;
+                        const auto solution = s.GetSolution(context, contender.config, true);
+                        contender.invoker   = profile_h.PrepareInvoker(
+                            *solution.invoker_factory, solution.construction_params);
                     }
-
-                    if(ret == 0)
+                    for(int i = 0; i < runs; ++i)
                     {
-                        is_passed = true;
-                        elapsed_time /= 5;
-                        if(elapsed_time < best_time)
-                        {
-                            MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                             << ' ' << elapsed_time << " < " << best_time << ' '
-                                             << current_config);
-                            best_config = current_config;
-                            best_time   = elapsed_time;
-                            n_best      = n_current;
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_I2("Average is not better: " << elapsed_time
-                                                                    << " >= " << best_time);
-                        }
+                        contender.invoker(profile_h, invoke_ctx);
+                        contender.total_time += profile_h.GetKernelTime();
                     }
+                    contender.runs += runs;
+                }
+                catch(...)
+                {
+                    MIOPEN_LOG_E('#' << contender.n << " (" << n_runs_total << ") "
+                                     << " Failed to re-run");
+                    contender.runs = 0;
+                    ++result.n_failed;
                 }
             }
 
-            if(ret != 0)
-            {
-                MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                                 << " Failed rc=" << ret);
-                ++n_failed;
-            }
-            heartbeat.Monitor(ret != 0,
-                              elapsed_time,
-                              n_current,
-                              best_time,
-                              n_failed,
-                              n_runs_total,
-                              current_config);
-            ++n_current;
+            contenders.erase(std::remove_if(contenders.begin(),
+                                            contenders.end(),
+                                            [](const Contender& c) { return c.runs == 0; }),
+                             contenders.end());
+            MIOPEN_LOG_I2("Successive halving: " << contenders.size() << " configs left after "
+                                                 << runs << " more runs");
         }
+
+        if(!contenders.empty())
+        {
+            const auto& best = contenders.front();
+            result.is_passed = true;
+            result.config    = best.config;
+            result.time      = best.Average();
+            result.n_best    = best.n;
+        }
+        return result;
     }
-    else
+};
+
+template <class Solver, class Context>
+auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParams& invoke_ctx_)
+    -> decltype(s.GetPerformanceConfig(context_))
+{
+    static_assert(
+        !(is_detected<RunAndMeasure_t, Solver, ConstData_t, Data_t>{} ||
+          is_detected<RunAndMeasure_t, Solver, Data_t, ConstData_t>{}),
+        "RunAndMeasure is obsolete. Solvers should implement auto-tune evaluation in invoker");
+
+    auto context                  = context_;
+    context.is_for_generic_search = true;
+
+    using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
+
+    const auto default_solution = s.GetSolution(context, s.GetPerformanceConfig(context));
+    const auto invoke_ctx       = [invoke_ctx_]() {
+        auto copy = invoke_ctx_;
+        copy.SetInvokeType(InvokeType::AutoTune);
+        return copy;
+    }();
+
+    auto& profile_h = context.GetStream();
+    AutoEnableProfiling enableProfiling{profile_h};
+
+    const ComputedContainer<PerformanceConfig, Context> main(context);
+    const int main_size = std::distance(main.begin(), main.end());
+    const ComputedContainer<PerformanceConfig, Context> spare(context, true);
+    const int spare_size = std::distance(spare.begin(), spare.end());
+    const bool useSpare  = (main_size == 0);
+
+    const ComputedContainer<PerformanceConfig, Context> all_configs = useSpare ? spare : main;
+    const int n_runs_total = useSpare ? spare_size : main_size;
+    const std::vector<PerformanceConfig> configs(all_configs.begin(), all_configs.end());
+    const auto options = SearchOptions::FromEnv();
+    MIOPEN_LOG_W(SolverDbId(s) << ": Searching the best solution among " << n_runs_total
+                               << (useSpare ? " (spare)" : "") << " (" << options << ")...");
+
+    if(IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
     {
+        // Nothing to time, but the kernels are still built and saved to the binary cache.
+        SearchPipeline<PerformanceConfig> pipeline(
+            profile_h, configs, [&](const PerformanceConfig& config) {
+                return s.GetSolution(context, config, true);
+            });
+        std::vector<typename SearchPipeline<PerformanceConfig>::Candidate> batch;
+        while(pipeline.Next(batch)) {}
         MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
                      "Running kernels on GPU is disabled. Search skipped");
     }
 
-    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
-                          << n_best << ' ' << best_time << ' ' << best_config);
-    if(!is_passed)
+    std::ostringstream problem;
+    context.Serialize(problem);
+    const auto checkpoint =
+        TuningCheckpoint::Open(context, problem.str(), SolverDbId(s), ToString(options.strategy));
+
+    const SearchSession<Solver, Context, PerformanceConfig> session(
+        s, context, invoke_ctx, default_solution);
+    const auto result = session.Run(configs, options, checkpoint.get());
+    if(checkpoint)
+        checkpoint->Remove();
+
+    MIOPEN_LOG_W("Done: " << result.n_timed << '/' << result.n_failed << '/' << n_runs_total
+                          << ", best #" << result.n_best << ' ' << result.time << ' '
+                          << result.config << ", " << result.elapsed_ms << " ms");
+
+    if(options.compare_exhaustive && !options.IsExhaustive())
+    {
+        const auto optimum = session.Run(configs, {});
+        MIOPEN_LOG_W("Exhaustive: " << optimum.n_timed << '/' << optimum.n_failed << '/'
+                                    << n_runs_total << ", best #" << optimum.n_best << ' '
+                                    << optimum.time << ' ' << optimum.config << ", "
+                                    << optimum.elapsed_ms << " ms");
+        if(result.is_passed && optimum.is_passed)
+            MIOPEN_LOG_W("..." << options << " found " << (optimum.time / result.time)
+                               << " of the optimal speed in "
+                               << (result.elapsed_ms / optimum.elapsed_ms)
+                               << " of the exhaustive search time");
+    }
+
+    if(!result.is_passed)
         MIOPEN_THROW("Search failed");
     // Run once with the default config and show score.
 
@@ -474,10 +1014,10 @@ auto GenericSearch(const Solver s, const Context& context_, const AnyInvokeParam
                                                    default_solution.construction_params);
     invoker(profile_h, invoke_ctx);
     const auto default_time = profile_h.GetKernelTime();
-    const auto score        = (best_time > 0.0f) ? default_time / best_time : 0.0f;
+    const auto score        = (result.time > 0.0f) ? default_time / result.time : 0.0f;
     MIOPEN_LOG_W("...Score: " << score << " (default time " << default_time << ')');
 
-    return best_config;
+    return result.config;
 }
 
 } // namespace solver
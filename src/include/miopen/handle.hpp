@@ -34,6 +34,7 @@
 #include <miopen/miopen.h>
 #include <miopen/names.hpp>
 #include <miopen/object.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/allocator.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/solver_id.hpp>
@@ -42,6 +43,7 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <ios>
@@ -156,6 +158,10 @@ struct Handle : miopenHandle
     std::string GetDeviceName() const;
     const TargetProperties& GetTargetProperties() const;
 
+    /// Identifies the handle among the handles of the process. Unlike the address of the handle,
+    /// it is not reused by the handles created after this one is destroyed.
+    std::size_t GetId() const { return id; }
+
     private:
     std::string GetDeviceNameImpl() const;
 
@@ -223,16 +229,16 @@ struct Handle : miopenHandle
                            const std::vector<solver::KernelInfo>& kernels) const;
 
     void RegisterInvoker(const Invoker& invoker,
-                         const NetworkConfig& config,
+                         const ProblemKey& problem,
                          const std::string& solver,
                          const AlgorithmName& algo)
     {
-        invokers.Register({config, solver}, invoker);
-        invokers.SetAsFound1_0(config, algo, solver);
+        invokers.Register(problem, solver, invoker);
+        invokers.SetAsFound1_0(problem, algo.ToString(), solver);
     }
 
     boost::optional<const Invoker&>
-    GetInvoker(const NetworkConfig& config,
+    GetInvoker(const ProblemKey& problem,
                const boost::optional<solver::Id>& solver,
                const boost::optional<AlgorithmName>& algo = boost::none) const
     {
@@ -240,13 +246,13 @@ struct Handle : miopenHandle
         assert(!(solver && algo));
         if(solver)
         {
-            MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and solver "
+            MIOPEN_LOG_I2("Returning an invoker for problem " << problem << " and solver "
                                                               << solver->ToString());
-            return invokers[std::make_pair(config.ToString(), solver->ToString())];
+            return invokers.GetInvoker(problem, *solver);
         }
-        MIOPEN_LOG_I2("Returning an invoker for problem " << config.ToString() << " and algorithm "
+        MIOPEN_LOG_I2("Returning an invoker for problem " << problem << " and algorithm "
                                                           << algo->ToString());
-        return invokers.GetFound1_0(config, *algo);
+        return invokers.GetFound1_0(problem, algo->ToString());
     }
 
 #if MIOPEN_USE_ROCBLAS
@@ -259,6 +265,13 @@ struct Handle : miopenHandle
     private:
 #endif
     InvokerCache invokers;
+    std::size_t id = NextId();
+
+    static std::size_t NextId()
+    {
+        static std::atomic<std::size_t> next{0};
+        return ++next;
+    }
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Handle& handle) { return handle.Print(os); }
@@ -35,6 +35,7 @@
 
 namespace miopen {
 
+class MappedFile;
 struct HIPOCProgramImpl;
 struct HIPOCProgram
 {
@@ -52,6 +53,8 @@ struct HIPOCProgram
                  const std::string& kernel_src);
     HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco);
     HIPOCProgram(const std::string& program_name, const std::string& hsaco);
+    /// Loads the module right from the mapping, which is not needed afterwards.
+    HIPOCProgram(const std::string& program_name, const MappedFile& hsaco);
     std::shared_ptr<HIPOCProgramImpl> impl;
     hipModule_t GetModule() const;
     /// \return Pathname of CO file, if it resides on the filesystem.
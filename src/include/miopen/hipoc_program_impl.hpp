@@ -35,6 +35,8 @@
 
 namespace miopen {
 
+class MappedFile;
+
 using hipModulePtr = MIOPEN_MANAGE_PTR(hipModule_t, hipModuleUnload);
 struct HIPOCProgramImpl
 {
@@ -43,6 +45,8 @@ struct HIPOCProgramImpl
 
     HIPOCProgramImpl(const std::string& program_name, const std::string& blob);
 
+    HIPOCProgramImpl(const std::string& program_name, const MappedFile& blob);
+
     HIPOCProgramImpl(const std::string& program_name,
                      std::string params,
                      bool is_kernel_str,
@@ -28,44 +28,76 @@
 
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/problem_key.hpp>
+#include <miopen/solver_id.hpp>
 
 #include <boost/optional.hpp>
 
-#include <map>
-#include <memory>
+#include <cstdint>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace miopen {
 
+/// Invokers by problem and solver, and the find 1.0 winners.
+///
+/// Safe to share between threads. The problems are spread over shards by their hash, each with
+/// its own mutex, so that threads working on different problems rarely wait for each other.
+/// Invokers are never replaced or removed, so the references returned stay valid after the
+/// shard is unlocked.
 class InvokerCache
 {
     public:
-    // network_config, solver_id
-    using Key = std::pair<std::string, std::string>;
+    InvokerCache();
 
-    boost::optional<const Invoker&> operator[](const Key& key) const;
+    boost::optional<const Invoker&> GetInvoker(const ProblemKey& problem,
+                                               const solver::Id& solver) const;
     // For find 1.0
-    boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
+    boost::optional<const Invoker&> GetFound1_0(const ProblemKey& problem,
                                                 const std::string& algorithm) const;
-    void Register(const Key& key, const Invoker& invoker);
+    void Register(const ProblemKey& problem, const std::string& solver_id, const Invoker& invoker);
     // For find 1.0
-    void SetAsFound1_0(const std::string& network_config,
+    void SetAsFound1_0(const ProblemKey& problem,
                        const std::string& algorithm,
                        const std::string& solver_id);
 
     private:
+    static constexpr std::size_t shards_count = 16;
+
+    struct Entry
+    {
+        std::string solver_id;
+        /// solver::Id value, compared instead of the string when the solver is registered.
+        uint64_t solver_value;
+        Invoker invoker;
+    };
+
     struct Item
     {
-        // algorithm -> solver_id
-        // for find 1.0
-        std::map<std::string, std::string> found_1_0;
-        // solver_id -> invoker
-        std::map<std::string, Invoker> invokers;
+        // A few solvers per network config, searched linearly.
+        // Only appended to, which keeps the references to the elements valid.
+        std::deque<Entry> invokers;
+        // algorithm -> invoker of the winner, for find 1.0
+        std::vector<std::pair<std::string, const Invoker*>> found_1_0;
+
+        const Entry* Find(const std::string& solver_id) const;
     };
 
-    // network_config -> Item
-    std::map<std::string, Item> invokers;
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        std::unordered_map<ProblemKey, Item, ProblemKeyHash> items;
+    };
+
+    /// In a vector to keep the cache movable.
+    std::vector<Shard> shards;
+
+    const Shard& GetShard(const ProblemKey& problem) const;
+    Shard& GetShard(const ProblemKey& problem);
 };
 
 } // namespace miopen
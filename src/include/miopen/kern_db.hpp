@@ -32,6 +32,7 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
+#include <miopen/lz.hpp>
 #include <miopen/md5.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
@@ -69,6 +70,7 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`codec` INT NOT NULL DEFAULT 0"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
@@ -84,23 +86,49 @@ struct KernelConfig
     }
 };
 
+/// Compression of the kernel blobs. The values are stored in the `codec` column of each row,
+/// so they must never change. Rows of the databases created before the column was added are
+/// bzip2.
+enum class KernDbCodec
+{
+    Bzip2 = 0,
+    None  = 1,
+    Lz    = 2,
+};
+
+const char* ToString(KernDbCodec codec);
+
+/// The codec new kernels are stored with, MIOPEN_KERNEL_CACHE_CODEC or the build default.
+KernDbCodec GetKernDbCodec();
+
 class KernDb : public SQLiteBase<KernDb>
 {
+    KernDbCodec codec;
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
+    /// Read-only databases of the former layout have no codec column.
+    bool has_codec_column = false;
+
+    std::string Decompress(KernDbCodec row_codec, std::string blob, unsigned int size) const;
 
     public:
     KernDb(const std::string& filename_,
            bool is_system,
            const std::string& arch,
            std::size_t num_cu);
-    // This constructor is only intended for testing
+    KernDb(const std::string& filename_,
+           bool is_system,
+           const std::string& arch,
+           std::size_t num_cu,
+           KernDbCodec codec_);
+    // This constructor is only intended for testing. The functions replace the ones of codec.
     KernDb(const std::string& filename_,
            bool _is_system,
            const std::string& _arch,
            std::size_t _num_cu,
            std::function<std::string(std::string, bool*)> _compress_fn,
-           std::function<std::string(std::string, unsigned int)> _decompress_fn);
+           std::function<std::string(std::string, unsigned int)> _decompress_fn,
+           KernDbCodec codec_ = KernDbCodec::Bzip2);
     template <typename T>
     bool RemoveRecordUnsafe(const T& problem_config)
     {
@@ -125,8 +153,9 @@ class KernDb : public SQLiteBase<KernDb>
         if(filename.empty())
             return boost::none;
         // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
+        auto select_query = std::string{"SELECT kernel_blob, kernel_hash, uncompressed_size"} +
+                            (has_codec_column ? ", codec" : "") + " FROM " + T::table_name() +
+                            " WHERE " + problem_config.Where() + ";";
         auto stmt = SQLite::Statement{sql, select_query};
         // only one result field
         // assert one row
@@ -136,10 +165,13 @@ class KernDb : public SQLiteBase<KernDb>
             auto compressed_blob           = stmt.ColumnBlob(0);
             auto md5_hash                  = stmt.ColumnText(1);
             auto uncompressed_size         = stmt.ColumnInt64(2);
+            auto row_codec                 = has_codec_column
+                                                 ? static_cast<KernDbCodec>(stmt.ColumnInt64(3))
+                                                 : KernDbCodec::Bzip2;
             std::string& decompressed_blob = compressed_blob;
             if(uncompressed_size != 0)
             {
-                decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
+                decompressed_blob = Decompress(row_codec, compressed_blob, uncompressed_size);
             }
             auto new_md5 = md5(decompressed_blob);
             if(new_md5 != md5_hash)
@@ -160,7 +192,7 @@ class KernDb : public SQLiteBase<KernDb>
             return boost::none;
         auto insert_query = "INSERT OR IGNORE INTO " + T::table_name() +
                             "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
+                            "uncompressed_size, codec) VALUES(?, ?, ?, ?, ?, ?);";
         auto md5_sum           = md5(problem_config.kernel_blob);
         auto uncompressed_size = problem_config.kernel_blob.size();
         bool success           = false;
@@ -172,11 +204,13 @@ class KernDb : public SQLiteBase<KernDb>
         {
             stmt.BindBlob(3, problem_config.kernel_blob);
             stmt.BindInt64(5, 0);
+            stmt.BindInt64(6, static_cast<int64_t>(KernDbCodec::None));
         }
         else
         {
             stmt.BindBlob(3, compressed_blob);
             stmt.BindInt64(5, uncompressed_size);
+            stmt.BindInt64(6, static_cast<int64_t>(codec));
         }
         stmt.BindText(4, md5_sum);
 
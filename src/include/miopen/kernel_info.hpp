@@ -32,6 +32,8 @@
 #include <vector>
 #include <miopen/kernel.hpp>
 
+#include <boost/optional.hpp>
+
 namespace miopen {
 
 struct Handle;
@@ -52,6 +54,11 @@ struct KernelInfo
 
 std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels);
 
+/// Same as PrecompileKernels, but a kernel that fails to build is left empty instead of
+/// failing the whole set. Like PrecompileKernels, does not add the programs to the handle.
+std::vector<boost::optional<Program>> TryPrecompileKernels(const Handle& h,
+                                                           const std::vector<KernelInfo>& kernels);
+
 } // namespace solver
 } // namespace miopen
 
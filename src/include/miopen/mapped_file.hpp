@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MAPPED_FILE_HPP_
+#define GUARD_MIOPEN_MAPPED_FILE_HPP_
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+
+/// Identity of a file on disk. Two stamps of the same path compare equal only if the file has
+/// not been replaced, resized or modified in between.
+struct FileStamp
+{
+    std::uint64_t device = 0;
+    std::uint64_t inode  = 0;
+    std::uint64_t size   = 0;
+    std::int64_t mtime   = 0; // Nanoseconds where available.
+
+    /// Returns none if the file does not exist or cannot be accessed.
+    static boost::optional<FileStamp> Get(const std::string& path);
+
+    friend bool operator==(const FileStamp& l, const FileStamp& r)
+    {
+        return l.device == r.device && l.inode == r.inode && l.size == r.size &&
+               l.mtime == r.mtime;
+    }
+    friend bool operator!=(const FileStamp& l, const FileStamp& r) { return !(l == r); }
+};
+
+/// Read-only memory mapping of a whole file.
+/// Remembers the stamp of the file at the moment of mapping, so users can cheaply detect that the
+/// mapped contents are outdated.
+class MappedFile
+{
+    public:
+    MappedFile() = default;
+    /// Maps the file if it exists and is readable. Check IsValid() for the result.
+    MappedFile(const std::string& path_);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&)                 = default;
+    MappedFile& operator=(MappedFile&&) = default;
+
+    bool IsValid() const { return valid; }
+    const char* Data() const { return static_cast<const char*>(region.get_address()); }
+    std::size_t Size() const { return size; }
+    const std::string& Path() const { return path; }
+
+    /// Leaves the last n bytes of the file out of Data() and Size(), e.g. a trailer that has
+    /// been checked already.
+    void DropTail(std::size_t n) { size = n < size ? size - n : 0; }
+
+    /// Returns true if the file on disk differs from the mapped one, i.e. it has been modified,
+    /// replaced, created or removed since it has been mapped.
+    bool IsOutdated() const { return FileStamp::Get(path) != stamp; }
+
+    private:
+    std::string path;
+    boost::optional<FileStamp> stamp;
+    boost::interprocess::file_mapping mapping;
+    boost::interprocess::mapped_region region;
+    std::size_t size = 0;
+    bool valid       = false;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MAPPED_FILE_HPP_
@@ -32,7 +32,13 @@
 #include <miopen/fusion.hpp>
 #include <miopen/any_solver.hpp>
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace miopen {
 
@@ -82,7 +88,66 @@ struct MDGraph_vertex
 };
 
 using MDGraph_vertex_ptr = std::shared_ptr<MDGraph_vertex>;
-using cur_vertex_map     = std::unordered_map<std::string, boost::any>;
+
+/// State of a path through the graph that matches the operators added so far.
+struct MDGraph_path_state
+{
+    int weight = 0;
+    /// Set when the last operator is a convolution.
+    bool has_algo                 = false;
+    miopenConvFwdAlgorithm_t algo = miopenConvolutionFwdAlgoGEMM;
+    solver::AnySolver solver;
+};
+
+/// The metadata graph with the edge constraints parsed and the symbols replaced by indices.
+/// It is built once for each first operator and shared by all the fusion plans, and remembers
+/// the results of Advance for the combinations of the paths, the operator and the values of
+/// the attributes it has seen.
+struct MDGraph_automaton
+{
+    struct Edge
+    {
+        MDGraph_vertex_ptr dst;
+        std::vector<MDGraph_expr> constraints;
+    };
+
+    struct Step
+    {
+        std::vector<std::pair<MDGraph_vertex_ptr, MDGraph_path_state>> cur_vertex;
+        std::set<miopenConvFwdAlgorithm_t> conv_algo_set;
+    };
+
+    using EdgeList =
+        std::unordered_map<MDGraph_vertex_ptr,
+                           std::unordered_map<MDGraph_vertex_ptr, FusionMDGraph_Edge_Map_Vec>>;
+
+    MDGraph_automaton(const EdgeList& edge_list);
+
+    static std::shared_ptr<MDGraph_automaton> Get(miopenFusionOp_t op);
+
+    int GetSymbol(const std::string& name) const;
+    /// The edges from src, the edges to the same vertex follow each other.
+    const std::vector<Edge>& GetEdges(const MDGraph_vertex_ptr& src) const;
+    const std::unordered_map<MDGraph_vertex_ptr, std::vector<Edge>>& GetAllEdges() const
+    {
+        return edges;
+    }
+    /// Indices of the symbols used by the edges from src to the vertices of the operator.
+    const std::vector<int>& GetSymbols(const MDGraph_vertex_ptr& src, miopenFusionOp_t op) const;
+
+    bool FindStep(const std::string& key, Step& step) const;
+    void AddStep(const std::string& key, const Step& step);
+
+    std::vector<std::string> symbols;
+
+    private:
+    std::unordered_map<std::string, int> symbol_ids;
+    std::unordered_map<MDGraph_vertex_ptr, std::vector<Edge>> edges;
+    std::map<std::pair<MDGraph_vertex_ptr, miopenFusionOp_t>, std::vector<int>> edge_symbols;
+
+    mutable std::mutex steps_mutex;
+    std::unordered_map<std::string, Step> steps;
+};
 
 struct FusionMDGraph
 {
@@ -97,9 +162,7 @@ struct FusionMDGraph
                  std::function<bool(const std::string& sym, int& val)> attr_fun);
     void AddEdge(MDGraph_vertex_ptr src, MDGraph_vertex_ptr dst, FusionMDGraph_Edge_Map& map);
 
-    bool CmpOpKey(const FusionMDGraph_Edge_Map& edge_val,
-                  std::function<bool(const std::string& sym, int& val)> attr_fun,
-                  std::unordered_map<std::string, int>& syms) const;
+    bool CmpOpKey(const MDGraph_automaton::Edge& edge, MDGraph_symbols& syms) const;
     MDGraph_vertex_ptr GetCurVertex(const Handle& handle);
     std::string GetProgramName(const Handle& handle);
     std::string GetKernelName(const Handle& handle);
@@ -110,12 +173,14 @@ struct FusionMDGraph
     std::vector<solver::AnySolver> GetSolvers();
     void WriteToFile(std::string filename = "");
 
-    std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> cur_vertex;
+    std::vector<std::pair<MDGraph_vertex_ptr, MDGraph_path_state>> cur_vertex;
     std::set<miopenConvFwdAlgorithm_t> conv_algo_set;
 
     std::unordered_map<MDGraph_vertex_ptr,
                        std::unordered_map<MDGraph_vertex_ptr, FusionMDGraph_Edge_Map_Vec>>
         edge_list;
+    /// Compiled from edge_list on the first Advance unless it was set by Init.
+    std::shared_ptr<MDGraph_automaton> automaton;
 };
 
 } // namespace miopen
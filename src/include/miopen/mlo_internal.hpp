@@ -68,6 +68,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #else
 #include <miopen/db.hpp>
 #endif
+#include <miopen/db_cache.hpp>
 #include <miopen/conv/context.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/problem_description.hpp>
@@ -157,9 +158,9 @@ class StaticContainer
 };
 
 #if MIOPEN_ENABLE_SQLITE
-using PerformanceDb = DbTimer<MultiFileDb<SQLitePerfDb, SQLitePerfDb, true>>;
+using PerformanceDb = DbTimer<CachedDb<MultiFileDb<SQLitePerfDb, SQLitePerfDb, true>>>;
 #else
-using PerformanceDb = DbTimer<MultiFileDb<PlainTextDb, PlainTextDb, true>>;
+using PerformanceDb = DbTimer<CachedDb<MultiFileDb<PlainTextDb, PlainTextDb, true>>>;
 #endif
 miopen::PerformanceDb GetDb(const miopen::ExecutionContext& ctx);
 
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_PREPARED_CONVOLUTION_HPP_
+#define GUARD_MIOPEN_PREPARED_CONVOLUTION_HPP_
+
+#include <miopen/common.hpp>
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/invoker.hpp>
+#include <miopen/miopen.h>
+#include <miopen/object.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace miopen {
+
+struct Handle;
+struct ConvolutionDescriptor;
+
+/// Convolution problem with the invoker of the solution chosen for it. The descriptors are
+/// validated and the invoker is looked up once, on construction, so running it takes neither
+/// a ConvolutionContext nor a network config.
+struct PreparedConvolution : miopenPreparedConvolution
+{
+    /// The tensors are named as in the forward direction, see
+    /// ConvolutionDescriptor::PrepareSolution.
+    PreparedConvolution(Handle& handle,
+                        const ConvolutionDescriptor& convDesc,
+                        conv::Direction direction_,
+                        const TensorDescriptor& wDesc_,
+                        const TensorDescriptor& xDesc_,
+                        const TensorDescriptor& yDesc_,
+                        solver::Id solver_id_);
+
+    void Run(const Handle& handle,
+             Data_t w,
+             Data_t x,
+             Data_t y,
+             Data_t workSpace,
+             std::size_t workSpaceSize) const;
+
+    friend std::ostream& operator<<(std::ostream& stream, const PreparedConvolution& prepared);
+
+    private:
+    /// Id of the handle the invoker has been prepared with, which is the only one it runs on.
+    std::size_t handle_id;
+    conv::Direction direction;
+    /// Transpose convolutions are run as the opposite data direction with x and y swapped.
+    bool swap_xy;
+    TensorDescriptor wDesc;
+    TensorDescriptor xDesc;
+    TensorDescriptor yDesc;
+    solver::Id solver_id;
+    Invoker invoker;
+};
+
+} // namespace miopen
+
+MIOPEN_DEFINE_OBJECT(miopenPreparedConvolution, miopen::PreparedConvolution);
+
+#endif // GUARD_MIOPEN_PREPARED_CONVOLUTION_HPP_
@@ -333,6 +333,8 @@ struct ProblemDescription
 
     int mloBuildConf_Key(std::string& conf_key) const;
 
+    ProblemKey BuildProblemKey() const { return conv_problem.BuildProblemKey(); }
+
     NetworkConfig BuildConfKey() const
     {
         std::string ret;
@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/names.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace miopen {
+
+/// Identity of a problem in the in-memory caches.
+///
+/// A network config is a long string formatted with a stream, so each cache lookup by it used
+/// to format and hash one. A key built from a problem description holds its parameters as fixed
+/// width fields instead and hashes them once, on construction. The network config is derived
+/// from the fields only when it is needed, for db I/O and logs. Problems without a binary
+/// description are keyed by their network config string, hashed once as well.
+class ProblemKey
+{
+    public:
+    using Field                             = std::int64_t;
+    static constexpr std::size_t max_fields = 32;
+    /// Writes the network config of a key described by the fields.
+    using Formatter = void (*)(std::ostream& stream, const Field* fields);
+
+    ProblemKey() = default;
+    explicit ProblemKey(const NetworkConfig& config_);
+
+    template <std::size_t N>
+    ProblemKey(Formatter formatter_, const std::array<Field, N>& fields_)
+        : ProblemKey(formatter_, fields_.data(), N)
+    {
+        static_assert(N <= max_fields, "Too many fields for a problem key");
+    }
+
+    std::uint64_t GetHash() const { return hash; }
+
+    /// Formats the network config on each call, so keep it out of the hot paths.
+    std::string ToString() const;
+    NetworkConfig ToNetworkConfig() const { return NetworkConfig{ToString()}; }
+
+    friend bool operator==(const ProblemKey& left, const ProblemKey& right);
+    friend bool operator!=(const ProblemKey& left, const ProblemKey& right)
+    {
+        return !(left == right);
+    }
+    friend std::ostream& operator<<(std::ostream& stream, const ProblemKey& key);
+
+    /// Packs a short string, e.g. a tensor layout, into a field. Throws if it does not fit.
+    static Field PackString(const std::string& str);
+    static std::string UnpackString(Field field);
+
+    private:
+    Formatter formatter      = nullptr;
+    std::size_t fields_count = 0;
+    std::array<Field, max_fields> fields{};
+    std::string config;
+    std::uint64_t hash = 0;
+
+    ProblemKey(Formatter formatter_, const Field* fields_, std::size_t count);
+};
+
+struct ProblemKeyHash
+{
+    std::size_t operator()(const ProblemKey& key) const
+    {
+        return static_cast<std::size_t>(key.GetHash());
+    }
+};
+
+} // namespace miopen
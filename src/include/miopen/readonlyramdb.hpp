@@ -27,47 +27,48 @@
 #define MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 
 #include <miopen/db_record.hpp>
+#include <miopen/mapped_file.hpp>
 
 #include <boost/optional.hpp>
+#include <boost/utility/string_view.hpp>
 
-#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <sstream>
+#include <vector>
 
 namespace miopen {
 
+/// Read-only db which is loaded into memory once per process.
+/// The file is memory-mapped (or the embedded blob is used directly), and the records are
+/// referenced in place by an open addressing hash table. The payload of a record is parsed on
+/// the first access and then reused.
 class ReadonlyRamDb
 {
     public:
     ReadonlyRamDb(std::string path) : db_path(path) {}
+    ~ReadonlyRamDb();
+
+    ReadonlyRamDb(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = delete;
 
     static ReadonlyRamDb& GetCached(const std::string& path,
                                     bool warn_if_unreadable,
                                     const std::string& arch = "",
                                     std::size_t num_cu      = 0);
 
+    /// Starts loading the db in a background thread unless it is loaded already.
+    /// GetCached() calls for the same db wait for the load to complete instead of repeating it.
+    static void StartPrefetch(const std::string& path, bool warn_if_unreadable);
+
     boost::optional<DbRecord> FindRecord(const std::string& problem) const
     {
-        MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        const auto it = cache.find(problem);
-
-        if(it == cache.end())
+        const auto record = FindParsed(problem);
+        if(record == nullptr)
             return boost::none;
-
-        auto record = DbRecord{problem};
-
-        MIOPEN_LOG_I2("Key match: " << problem);
-        MIOPEN_LOG_I2("Contents found: " << it->second.content);
-
-        if(!record.ParseContents(it->second.content))
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: "
-                         << problem << " form file " << db_path << "#" << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
-            return boost::none;
-        }
-
-        return record;
+        return *record;
     }
 
     template <class TProblem>
@@ -80,8 +81,8 @@ class ReadonlyRamDb
     template <class TProblem, class TValue>
     bool Load(const TProblem& problem, const std::string& id, TValue& value) const
     {
-        const auto record = FindRecord(problem);
-        if(!record)
+        const auto record = FindParsed(DbRecord::Serialize(problem));
+        if(record == nullptr)
             return false;
         return record->GetValues(id, value);
     }
@@ -89,21 +90,32 @@ class ReadonlyRamDb
     private:
     struct CacheItem
     {
+        boost::string_view key;
+        boost::string_view content;
+        std::size_t hash;
         int line;
-        std::string content;
     };
 
-    std::string db_path;
-    std::unordered_map<std::string, CacheItem> cache;
-
-    ReadonlyRamDb(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb(ReadonlyRamDb&&)      = default;
-    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
+    struct Chunk;
 
+    std::string db_path;
+    MappedFile file;
+    std::vector<CacheItem> items;
+    /// Open addressing (linear probing) table of indices into items, shifted by one, so zero
+    /// marks an empty slot. The size is a power of two.
+    std::vector<std::uint32_t> slots;
+    /// Parsed records, filled on demand.
+    std::unique_ptr<std::atomic<const DbRecord*>[]> parsed;
+    std::once_flag prefetched;
+
+    static std::size_t Hash(boost::string_view key);
+    static void ParseChunk(Chunk& chunk);
+
+    const CacheItem* Find(boost::string_view key) const;
+    const DbRecord* FindParsed(const std::string& problem) const;
     void Prefetch(const std::string& path, bool warn_if_unreadable);
-    void
-    ParseAndLoadDb(std::istream& input_stream, const std::string& path, bool warn_if_unreadable);
+    void ParseAndLoadDb(const char* begin, const char* end);
+    void BuildTable();
 };
 
 } // namespace miopen
@@ -1165,6 +1165,9 @@ struct ConvHipImplicitGemmForwardV4R4Xdlops : SolverBase<ConvolutionContext>
     ConvSolution GetSolution(const ConvolutionContext& ctx,
                              const PerformanceImplicitGemmForwardV4R4Xdlops& config,
                              bool disableConfigOverrideFromEnv = false) const;
+    /// Relative estimate of the kernel time, used by the cost search strategy.
+    float EstimateCost(const ConvolutionContext& ctx,
+                       const PerformanceImplicitGemmForwardV4R4Xdlops& config) const;
 
     PerformanceImplicitGemmForwardV4R4Xdlops Search(const ConvolutionContext&,
                                                     const AnyInvokeParams& invoke_ctx) const;
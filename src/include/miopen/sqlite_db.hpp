@@ -29,6 +29,7 @@
 
 #if MIOPEN_ENABLE_SQLITE
 
+#include <miopen/cow_registry.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/errors.hpp>
@@ -42,12 +43,14 @@
 #include <boost/thread.hpp>
 #include <boost/thread/thread_time.hpp>
 #include "sqlite3.h"
+#include <memory>
 #include <mutex>
 #include <thread>
 
 #include <string>
 #include <chrono>
 #include <unordered_map>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -173,10 +176,20 @@ class SQLite
         std::unique_ptr<impl> pImpl;
 
         public:
+        struct Cached
+        {
+        };
+
         Statement(const SQLite& sql, const std::string& query);
         Statement(const SQLite& sql,
                   const std::string& query,
                   const std::vector<std::string>& vals);
+        /// The statement is prepared once per connection and reused for the same query, which
+        /// shall pass all the values as parameters.
+        Statement(const SQLite& sql,
+                  const std::string& query,
+                  const std::vector<std::string>& vals,
+                  Cached);
         Statement();
         ~Statement();
         Statement(Statement&&) noexcept;
@@ -204,6 +217,9 @@ class SQLite
     int Retry(std::function<int()>) const;
     static int Retry(std::function<int()> f, std::string filename);
     std::string ErrorMessage() const;
+    /// Nested batches join the outermost one, which is a single transaction.
+    void BeginBatch() const;
+    void EndBatch() const;
 };
 
 template <typename Derived>
@@ -303,6 +319,41 @@ class SQLiteBase
         }
         return AllFound;
     }
+    /// Groups all the changes made to the db during its lifetime into one transaction, so bulk
+    /// updates do not commit each change separately. Batches may be nested, and changes made by
+    /// other threads through the same db object join the batch. The db is locked for writing by
+    /// other connections until the outermost batch is destroyed.
+    class Batch
+    {
+        public:
+        Batch() = default;
+        Batch(const SQLite& sql_) : sql(&sql_) { sql->BeginBatch(); }
+        Batch(Batch&& other) noexcept : sql(other.sql) { other.sql = nullptr; }
+        Batch(const Batch&) = delete;
+        Batch& operator=(const Batch&) = delete;
+        Batch& operator=(Batch&&) = delete;
+
+        ~Batch()
+        {
+            if(sql == nullptr)
+                return;
+
+            try
+            {
+                sql->EndBatch();
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_E("Failed to commit a batch of changes to the database: " << ex.what());
+            }
+        }
+
+        private:
+        const SQLite* sql = nullptr;
+    };
+
+    Batch BeginBatch() const { return dbInvalid ? Batch{} : Batch{sql}; }
+
     template <typename... U>
     inline auto FindRecord(U&... args)
     {
@@ -353,18 +404,15 @@ Derived& SQLiteBase<Derived>::GetCached(const std::string& path,
                                         const size_t num_cu)
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
-    std::lock_guard<std::mutex> lock{mutex};
-
+    static auto instances = std::vector<std::unique_ptr<Derived>>{};
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static auto instances = std::map<std::string, Derived>{};
-    const auto it         = instances.find(path);
+    static CowRegistry<Derived> registry;
 
-    if(it != instances.end())
-        return it->second;
-
-    instances.emplace(path, Derived{path, is_system, arch, num_cu});
-    return instances.at(path);
+    // The factory runs under the registry insert lock, which also guards instances.
+    return registry.GetOrInsert(path, [&]() {
+        instances.push_back(std::make_unique<Derived>(path, is_system, arch, num_cu));
+        return instances.back().get();
+    });
 }
 
 class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
@@ -382,7 +430,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
         std::string clause;
         std::vector<std::string> vals;
         std::tie(clause, vals) = prob_desc.InsertQuery();
-        auto stmt              = SQLite::Statement{sql, clause, vals};
+        auto stmt              = SQLite::Statement{sql, clause, vals, SQLite::Statement::Cached{}};
         auto rc                = stmt.Step(sql);
         if(rc != SQLITE_DONE)
             MIOPEN_THROW(miopenStatusInternalError,
@@ -397,7 +445,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
         std::vector<std::string> vals;
         std::tie(clause, vals) = prob_desc.WhereClause();
         auto query = "SELECT id FROM " + prob_desc.table_name() + " WHERE ( " + clause + " );";
-        auto stmt  = SQLite::Statement{sql, query, vals};
+        auto stmt  = SQLite::Statement{sql, query, vals, SQLite::Statement::Cached{}};
         while(true)
         {
             auto rc = stmt.Step(sql);
@@ -425,10 +473,12 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "ON perf_db.config = " + problem_config.table_name() +".id "
             "WHERE "
             "( " + clause + " )"
-            "AND (arch = '" + arch + "' ) "
-            "AND (num_cu = '" + std::to_string(num_cu) + "');";
+            "AND (arch = ? ) "
+            "AND (num_cu = ? );";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, select_query, values};
+        values.push_back(arch);
+        values.push_back(std::to_string(num_cu));
+        auto stmt = SQLite::Statement{sql, select_query, values, SQLite::Statement::Cached{}};
         DbRecord rec;
         while(true)
         {
@@ -464,9 +514,10 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "WHERE config IN ("
             "SELECT id FROM config WHERE ( "
             + clause + " ) )"
-            "AND solver == '" +  id + "' ;";
+            "AND solver == ? ;";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, query, values};
+        values.push_back(id);
+        auto stmt = SQLite::Statement{sql, query, values, SQLite::Statement::Cached{}};
         auto rc   = stmt.Step(sql);
         if(rc == SQLITE_DONE)
             return true;
@@ -487,18 +538,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
         if(dbInvalid)
             return boost::none;
         // UPSERT the value
-        {
-            std::string clause;
-            std::vector<std::string> vals;
-            std::tie(clause, vals) = problem_config.InsertQuery();
-            auto stmt              = SQLite::Statement{sql, clause, vals};
-            auto rc                = stmt.Step(sql);
-            if(rc != SQLITE_DONE)
-                MIOPEN_THROW(miopenStatusInternalError,
-                             "Failed to insert config: " + sql.ErrorMessage());
-            auto cnt = sql.Changes();
-            MIOPEN_LOG_I2(cnt << " rows updated");
-        }
+        InsertConfig(problem_config);
 
         // UPSERT perf values
         {
@@ -520,7 +560,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             vals.push_back(params.str());
             vals.push_back(arch);
             vals.push_back(std::to_string(num_cu));
-            auto stmt = SQLite::Statement{sql, query, vals};
+            auto stmt = SQLite::Statement{sql, query, vals, SQLite::Statement::Cached{}};
             auto rc   = stmt.Step(sql);
             if(rc != SQLITE_DONE)
             {
@@ -560,7 +600,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
             "SELECT id FROM config WHERE ( "
             + clause + " ))";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, query, values};
+        auto stmt = SQLite::Statement{sql, query, values, SQLite::Statement::Cached{}};
         auto rc   = stmt.Step(sql);
         if(rc != SQLITE_DONE)
         {
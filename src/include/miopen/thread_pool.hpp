@@ -0,0 +1,88 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_THREAD_POOL_HPP_
+#define GUARD_MIOPEN_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef __MINGW32__
+#include <mingw.thread.h>
+#else
+#include <thread>
+#endif
+
+namespace miopen {
+
+/// Process-wide set of worker threads executing parallel loops.
+///
+/// Each loop is split evenly between its participants. A participant runs its own range in
+/// chunks that shrink as the range gets smaller and, when it is out of work, steals half of
+/// the largest range left to another participant. The calling thread always participates, so
+/// a loop completes even if all the workers are busy, which makes nested loops safe.
+class ThreadPool
+{
+    public:
+    using Body = std::function<void(std::size_t begin, std::size_t end)>;
+
+    ThreadPool(std::size_t workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// The pool with a worker per hardware thread, except the calling one. Started on first use.
+    static ThreadPool& Get();
+
+    std::size_t GetWorkersCount() const { return threads.size(); }
+
+    /// Calls body for subranges of [0, n) using up to max_threads threads, including the
+    /// calling one. Returns once the whole range is done. If body throws, the ranges that have
+    /// not been started yet are dropped and the first exception is rethrown here.
+    void ParallelFor(std::size_t n, std::size_t max_threads, const Body& body);
+
+    private:
+    struct Loop;
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::deque<std::shared_ptr<Loop>> loops;
+    bool stopping = false;
+
+    void WorkerMain();
+    void Remove(const std::shared_ptr<Loop>& loop);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_THREAD_POOL_HPP_
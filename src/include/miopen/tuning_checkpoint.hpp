@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_TUNING_CHECKPOINT_HPP_
+#define GUARD_MIOPEN_TUNING_CHECKPOINT_HPP_
+
+#include <boost/filesystem/path.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+struct ExecutionContext;
+
+namespace solver {
+
+/// Configs timed by GenericSearch, kept on disk, so that an interrupted search can be resumed
+/// without timing them again.
+///
+/// The records of a problem and solver are appended to a text file in the "tuning"
+/// subdirectory of the user perf-db directory as soon as they are known, one line per config.
+/// The file is removed once the search completes, since its result goes to the perf-db then.
+class TuningCheckpoint
+{
+    public:
+    struct Record
+    {
+        enum class Status
+        {
+            Failed,
+            /// Timed once, too slow to be averaged.
+            Timed,
+            /// Averaged over a few runs, a candidate for the best.
+            Averaged,
+        };
+
+        Status status = Status::Failed;
+        float time    = 0.0f;
+    };
+
+    /// Returns nullptr when the user perf-db is disabled or MIOPEN_DEBUG_TUNING_CHECKPOINT is
+    /// disabled. Loads the records left by an interrupted search of the same problem, solver
+    /// and search strategy on the same device. The strategies time the configs differently,
+    /// e.g. successive halving never averages them, so their records are kept apart.
+    static std::unique_ptr<TuningCheckpoint> Open(const ExecutionContext& ctx,
+                                                  const std::string& problem,
+                                                  const std::string& solver,
+                                                  const std::string& strategy);
+
+    /// Loads the records of the file, unless it has been written for another key.
+    TuningCheckpoint(boost::filesystem::path path_, std::string key_);
+
+    std::size_t Size() const { return records.size(); }
+    const Record* Find(const std::string& config) const;
+    void Add(const std::string& config, const Record& record);
+    /// Drops the records and the file.
+    void Remove();
+
+    private:
+    boost::filesystem::path path;
+    /// Problem, solver and device the records belong to. The first line of the file.
+    std::string key;
+    std::unordered_map<std::string, Record> records;
+    /// The last line of the file has been left incomplete.
+    bool needs_newline = false;
+
+    void Load();
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TUNING_CHECKPOINT_HPP_
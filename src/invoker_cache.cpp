@@ -27,81 +27,138 @@
 #include <miopen/invoker_cache.hpp>
 #include <miopen/logger.hpp>
 
+#include <algorithm>
+
 namespace miopen {
 
-boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
+InvokerCache::InvokerCache() : shards(shards_count) {}
+
+// The high bits choose the shard, the low ones are left to the buckets of the shard's map.
+const InvokerCache::Shard& InvokerCache::GetShard(const ProblemKey& problem) const
+{
+    return shards[(problem.GetHash() >> 32) % shards.size()];
+}
+
+InvokerCache::Shard& InvokerCache::GetShard(const ProblemKey& problem)
+{
+    return shards[(problem.GetHash() >> 32) % shards.size()];
+}
+
+const InvokerCache::Entry* InvokerCache::Item::Find(const std::string& solver_id) const
+{
+    const auto entry = std::find_if(invokers.begin(), invokers.end(), [&](const Entry& e) {
+        return e.solver_id == solver_id;
+    });
+    return entry == invokers.end() ? nullptr : &*entry;
+}
+
+boost::optional<const Invoker&> InvokerCache::GetInvoker(const ProblemKey& problem,
+                                                         const solver::Id& solver) const
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
+    const auto& shard = GetShard(problem);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto item = shard.items.find(problem);
+    if(item == shard.items.end())
         return boost::none;
+
     const auto& item_invokers = item->second.invokers;
-    const auto invoker        = item_invokers.find(key.second);
-    if(invoker == item_invokers.end())
+    if(solver.IsValid())
+    {
+        const auto entry =
+            std::find_if(item_invokers.begin(), item_invokers.end(), [&](const Entry& e) {
+                return e.solver_value == solver.Value();
+            });
+        if(entry == item_invokers.end())
+            return boost::none;
+        return entry->invoker;
+    }
+
+    const auto entry = item->second.Find(solver.ToString());
+    if(entry == nullptr)
         return boost::none;
-    return invoker->second;
+    return entry->invoker;
 }
 
-boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
+boost::optional<const Invoker&> InvokerCache::GetFound1_0(const ProblemKey& problem,
                                                           const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    const auto& shard = GetShard(problem);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto item = shard.items.find(problem);
+    if(item == shard.items.end())
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
+        MIOPEN_LOG_I2("No invokers found for " << problem);
         return boost::none;
     }
-    if(item->second.found_1_0.empty())
+    const auto& found_1_0 = item->second.found_1_0;
+    if(found_1_0.empty())
     {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
+        MIOPEN_LOG_I2("Invokers found for " << problem << " but there is no find 1.0 result.");
         return boost::none;
     }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
+    const auto winner = std::find_if(found_1_0.begin(), found_1_0.end(), [&](const auto& w) {
+        return w.first == algorithm;
+    });
+    if(winner == found_1_0.end())
     {
         MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
+                      << problem << " but there is no one with an algorithm " << algorithm);
         return boost::none;
     }
-    const auto invoker = item_invokers.find(found_1_0_id->second);
-    if(invoker == item_invokers.end())
-        MIOPEN_THROW("No invoker with solver_id of " + found_1_0_id->second +
-                     " was registered for " + network_config);
-    return invoker->second;
+    return *winner->second;
 }
 
-void InvokerCache::Register(const Key& key, const Invoker& invoker)
+void InvokerCache::Register(const ProblemKey& problem,
+                            const std::string& solver_id,
+                            const Invoker& invoker)
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-        it->second.invokers.insert({key.second, invoker});
-    auto& item = invokers.insert({key.first, Item{}}).first->second;
-    item.invokers.insert({key.second, invoker});
-    MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
+    // Looked up in the solver registry before locking.
+    const auto solver = solver::Id{solver_id};
+
+    {
+        auto& shard = GetShard(problem);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto& item = shard.items[problem];
+        if(item.Find(solver_id) == nullptr)
+            item.invokers.push_back({solver_id, solver.Value(), invoker});
+    }
+
+    MIOPEN_LOG_I2("Invoker registered for algorithm " << problem << " and solver " << solver_id);
 }
 
-void InvokerCache::SetAsFound1_0(const std::string& network_config,
+void InvokerCache::SetAsFound1_0(const ProblemKey& problem,
                                  const std::string& algorithm,
                                  const std::string& solver_id)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
-        MIOPEN_THROW("No invoker was registered for " + network_config);
-
     {
+        auto& shard = GetShard(problem);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        const auto item = shard.items.find(problem);
+        if(item == shard.items.end())
+            MIOPEN_THROW("No invoker was registered for " + problem.ToString());
+
         // Validating at find time
-        const auto& item_invokers = item->second.invokers;
-        const auto invoker        = item_invokers.find(solver_id);
-        if(invoker == item_invokers.end())
+        const auto entry = item->second.Find(solver_id);
+        if(entry == nullptr)
             MIOPEN_THROW("No invoker with solver_id of " + solver_id + " was registered for " +
-                         network_config);
+                         problem.ToString());
+
+        auto& found_1_0   = item->second.found_1_0;
+        const auto winner = std::find_if(found_1_0.begin(), found_1_0.end(), [&](const auto& w) {
+            return w.first == algorithm;
+        });
+        if(winner != found_1_0.end())
+            winner->second = &entry->invoker;
+        else
+            found_1_0.emplace_back(algorithm, &entry->invoker);
     }
 
-    item->second.found_1_0[algorithm] = solver_id;
     MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
-                            << " in " << network_config);
+                            << " in " << problem);
 }
 
 } // namespace miopen
@@ -24,13 +24,108 @@
  *
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
+#include <miopen/env.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_KERNEL_CACHE_CODEC)
 
 namespace miopen {
+
+namespace {
+
+std::string StoreUncompressed(std::string blob, bool* compressed)
+{
+    *compressed = false;
+    return blob;
+}
+
+std::string DecompressUncompressed(std::string, unsigned int)
+{
+    MIOPEN_THROW(miopenStatusInternalError, "Uncompressed kernel blob with a compressed size");
+}
+
+std::function<std::string(std::string, bool*)> GetCompressFn(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::Bzip2: return compress;
+    case KernDbCodec::Lz: return lz_compress;
+    case KernDbCodec::None: break;
+    }
+    return StoreUncompressed;
+}
+
+std::function<std::string(std::string, unsigned int)> GetDecompressFn(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::Bzip2: return decompress;
+    case KernDbCodec::Lz: return lz_decompress;
+    case KernDbCodec::None: break;
+    }
+    return DecompressUncompressed;
+}
+
+boost::optional<KernDbCodec> ParseCodec(const std::string& name)
+{
+    for(const auto codec : {KernDbCodec::Lz, KernDbCodec::Bzip2, KernDbCodec::None})
+    {
+        if(name == ToString(codec))
+            return codec;
+    }
+    return boost::none;
+}
+
+} // namespace
+
+const char* ToString(KernDbCodec codec)
+{
+    switch(codec)
+    {
+    case KernDbCodec::Bzip2: return "bz2";
+    case KernDbCodec::None: return "none";
+    case KernDbCodec::Lz: return "lz";
+    }
+    return "<unknown>";
+}
+
+KernDbCodec GetKernDbCodec()
+{
+    static const auto codec = []() {
+        const auto fallback =
+            ParseCodec(MIOPEN_DEFAULT_KERNEL_CACHE_CODEC).value_or(KernDbCodec::Lz);
+        const char* const p = GetStringEnv(MIOPEN_KERNEL_CACHE_CODEC{});
+        if(p == nullptr)
+            return fallback;
+
+        const auto parsed = ParseCodec(p);
+        if(!parsed)
+            MIOPEN_LOG_W("Unknown MIOPEN_KERNEL_CACHE_CODEC=" << p << ", using "
+                                                              << ToString(fallback));
+        return parsed.value_or(fallback);
+    }();
+    return codec;
+}
+
 KernDb::KernDb(const std::string& filename_,
                bool is_system,
                const std::string& arch_,
                const std::size_t num_cu_)
-    : KernDb(filename_, is_system, arch_, num_cu_, compress, decompress)
+    : KernDb(filename_, is_system, arch_, num_cu_, GetKernDbCodec())
+{
+}
+
+KernDb::KernDb(const std::string& filename_,
+               bool is_system,
+               const std::string& arch_,
+               const std::size_t num_cu_,
+               KernDbCodec codec_)
+    : KernDb(filename_,
+             is_system,
+             arch_,
+             num_cu_,
+             GetCompressFn(codec_),
+             GetDecompressFn(codec_),
+             codec_)
 {
 }
 
@@ -39,8 +134,10 @@ KernDb::KernDb(const std::string& filename_,
                const std::string& _arch,
                std::size_t _num_cu,
                std::function<std::string(std::string, bool*)> _compress_fn,
-               std::function<std::string(std::string, unsigned int)> _decompress_fn)
+               std::function<std::string(std::string, unsigned int)> _decompress_fn,
+               KernDbCodec codec_)
     : SQLiteBase(filename_, is_system, _arch, _num_cu),
+      codec(codec_),
       compress_fn(_compress_fn),
       decompress_fn(_decompress_fn)
 {
@@ -65,7 +162,45 @@ KernDb::KernDb(const std::string& filename_,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
+    }
+
+    has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+    if(!has_codec_column && !is_system)
+    {
+        try
+        {
+            sql.Exec("ALTER TABLE `" + KernelConfig::table_name() +
+                     "` ADD COLUMN `codec` INT NOT NULL DEFAULT 0;");
+        }
+        catch(const Exception&)
+        {
+            // Another process could have added it meanwhile, which is checked below.
+        }
+        has_codec_column = CheckTableColumns(KernelConfig::table_name(), {"codec"});
+        if(!has_codec_column)
+        {
+            MIOPEN_LOG_W("Unable to add the codec column, disabling access to " << filename);
+            dbInvalid = true;
+        }
+    }
+}
+
+std::string KernDb::Decompress(KernDbCodec row_codec, std::string blob, unsigned int size) const
+{
+    if(row_codec == codec)
+        return decompress_fn(std::move(blob), size);
+
+    switch(row_codec)
+    {
+    case KernDbCodec::Bzip2:
+    case KernDbCodec::Lz:
+    case KernDbCodec::None: return GetDecompressFn(row_codec)(std::move(blob), size);
     }
+
+    MIOPEN_THROW(miopenStatusInternalError,
+                 "Unknown kernel codec " + std::to_string(static_cast<int>(row_codec)) +
+                     ", the database may be written by a newer version");
 }
 
 } // namespace miopen
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/lz.hpp>
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+
+// The limits the LZ4 block format puts on the sequences, so that the blobs stay readable by
+// the reference decoder.
+constexpr std::size_t min_match     = 4;
+constexpr std::size_t last_literals = 5;
+constexpr std::size_t match_limit   = 12;
+constexpr std::size_t max_offset    = 65535;
+constexpr int hash_log              = 16;
+
+std::uint32_t Read32(const char* p)
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+std::size_t Hash(std::uint32_t value) { return (value * 2654435761u) >> (32 - hash_log); }
+
+/// Writes the part of a length that did not fit into its 4 bits of the token.
+void WriteLength(std::string& out, std::size_t length)
+{
+    for(; length >= 255; length -= 255)
+        out.push_back(static_cast<char>(255));
+    out.push_back(static_cast<char>(length));
+}
+
+void WriteLiterals(std::string& out, const char* literals, std::size_t count, unsigned match_bits)
+{
+    out.push_back(static_cast<char>((std::min<std::size_t>(count, 15) << 4) | match_bits));
+    if(count >= 15)
+        WriteLength(out, count - 15);
+    out.append(literals, count);
+}
+
+void WriteSequence(std::string& out,
+                   const char* literals,
+                   std::size_t count,
+                   std::size_t offset,
+                   std::size_t match)
+{
+    const auto extra = match - min_match;
+    WriteLiterals(out, literals, count, std::min<std::size_t>(extra, 15));
+    out.push_back(static_cast<char>(offset & 0xFF));
+    out.push_back(static_cast<char>(offset >> 8));
+    if(extra >= 15)
+        WriteLength(out, extra - 15);
+}
+
+} // namespace
+
+std::string lz_compress(const std::string& s, bool* compressed)
+{
+    const auto n        = s.size();
+    const auto* const p = s.data();
+    std::string out;
+    out.reserve(n);
+    std::size_t anchor = 0;
+
+    if(n > match_limit)
+    {
+        std::vector<std::uint32_t> table(std::size_t{1} << hash_log, 0);
+        const auto last_match_start = n - match_limit;
+        const auto match_end_limit  = n - last_literals;
+        std::size_t ip              = 0;
+
+        while(ip <= last_match_start && out.size() < n)
+        {
+            const auto h          = Hash(Read32(p + ip));
+            const std::size_t ref = table[h];
+            table[h]              = static_cast<std::uint32_t>(ip);
+
+            if(ref >= ip || ip - ref > max_offset || Read32(p + ref) != Read32(p + ip))
+            {
+                // Step faster through the data that does not compress.
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            auto start = ip;
+            auto from  = ref;
+            while(start > anchor && from > 0 && p[start - 1] == p[from - 1])
+            {
+                --start;
+                --from;
+            }
+
+            auto end = ip + min_match;
+            while(end < match_end_limit && p[end] == p[from + (end - start)])
+                ++end;
+
+            WriteSequence(out, p + anchor, start - anchor, start - from, end - start);
+            ip     = end;
+            anchor = end;
+        }
+    }
+
+    if(out.size() < n)
+        WriteLiterals(out, p + anchor, n - anchor, 0);
+
+    const auto success = out.size() < n;
+    if(compressed != nullptr)
+        *compressed = success;
+    return success ? out : s;
+}
+
+std::string lz_decompress(const std::string& s, unsigned int size)
+{
+    const auto n  = s.size();
+    const auto* p = reinterpret_cast<const unsigned char*>(s.data());
+    std::string result(size, 0);
+    auto* const out = &result[0];
+    std::size_t ip  = 0;
+    std::size_t op  = 0;
+
+    const auto read_length = [&](std::size_t length) {
+        if(length != 15)
+            return length;
+        while(true)
+        {
+            if(ip >= n)
+                MIOPEN_THROW(miopenStatusInternalError, "lz_decompress: truncated length");
+            const auto byte = p[ip++];
+            length += byte;
+            if(byte != 255)
+                return length;
+        }
+    };
+
+    while(true)
+    {
+        if(ip >= n)
+            MIOPEN_THROW(miopenStatusInternalError, "lz_decompress: truncated sequence");
+
+        const auto token    = p[ip++];
+        const auto literals = read_length(token >> 4);
+        if(literals > n - ip || literals > size - op)
+            MIOPEN_THROW(miopenStatusInternalError, "lz_decompress: literals out of bounds");
+        std::memcpy(out + op, p + ip, literals);
+        ip += literals;
+        op += literals;
+
+        // The last sequence has no match.
+        if(ip == n)
+            break;
+
+        if(n - ip < 2)
+            MIOPEN_THROW(miopenStatusInternalError, "lz_decompress: truncated offset");
+        const std::size_t offset = p[ip] | (p[ip + 1] << 8);
+        ip += 2;
+        const auto match = read_length(token & 15) + min_match;
+        if(offset == 0 || offset > op || match > size - op)
+            MIOPEN_THROW(miopenStatusInternalError, "lz_decompress: match out of bounds");
+
+        if(offset >= match)
+        {
+            std::memcpy(out + op, out + op - offset, match);
+        }
+        else
+        {
+            // Overlapping copy repeats the last offset bytes.
+            for(std::size_t i = 0; i < match; ++i)
+                out[op + i] = out[op - offset + i];
+        }
+        op += match;
+    }
+
+    if(op != size)
+        MIOPEN_THROW(miopenStatusInternalError, "lz_decompress: size mismatch");
+    return result;
+}
+
+} // namespace miopen
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2021 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/mapped_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/exceptions.hpp>
+
+#ifdef __linux__
+#include <sys/stat.h>
+#endif
+
+namespace miopen {
+
+boost::optional<FileStamp> FileStamp::Get(const std::string& path)
+{
+#ifdef __linux__
+    struct stat st;
+    if(::stat(path.c_str(), &st) != 0)
+        return boost::none;
+
+    auto ret   = FileStamp{};
+    ret.device = st.st_dev;
+    ret.inode  = st.st_ino;
+    ret.size   = st.st_size;
+    ret.mtime  = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    return ret;
+#else
+    auto ec         = boost::system::error_code{};
+    const auto size = boost::filesystem::file_size(path, ec);
+    if(ec)
+        return boost::none;
+    const auto mtime = boost::filesystem::last_write_time(path, ec);
+    if(ec)
+        return boost::none;
+
+    auto ret  = FileStamp{};
+    ret.size  = size;
+    ret.mtime = mtime;
+    return ret;
+#endif
+}
+
+MappedFile::MappedFile(const std::string& path_) : path(path_), stamp(FileStamp::Get(path_))
+{
+    if(!stamp)
+        return;
+
+    size = stamp->size;
+
+    if(size == 0)
+    {
+        // Empty files cannot be mapped, but these are perfectly valid.
+        valid = true;
+        return;
+    }
+
+    try
+    {
+        mapping = boost::interprocess::file_mapping(path.c_str(), boost::interprocess::read_only);
+        region  = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only);
+        // The file could be changed between stat and mmap.
+        size  = region.get_size();
+        valid = true;
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_I2("Unable to map file: " << path << ", " << ex.what());
+        stamp = boost::none;
+        size  = 0;
+    }
+}
+
+} // namespace miopen
@@ -33,6 +33,9 @@
 #endif
 #include <miopen/db.hpp>
 
+#include <algorithm>
+#include <sstream>
+
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_AMD_FUSED_WINOGRAD)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GCN_ASM_KERNELS)
 
@@ -80,9 +83,9 @@ MDGraph_vertex_ptr FusionMDGraph::GetCurVertex(const Handle& handle)
         // Empty inidicates any arch is supported (say OpenCL kernels)
         bool arch_sup =
             cur.first->supported_arch.empty() || (it != cur.first->supported_arch.end());
-        if((boost::any_cast<int>(cur.second["weight"]) > weight) && arch_sup)
+        if((cur.second.weight > weight) && arch_sup)
         {
-            weight = boost::any_cast<int>(cur.second["weight"]);
+            weight = cur.second.weight;
             ptr    = cur.first;
         }
     }
@@ -94,19 +97,18 @@ std::vector<solver::AnySolver> FusionMDGraph::GetSolvers()
     // sort according to the edge weight
     std::sort(cur_vertex.begin(),
               cur_vertex.end(),
-              [&](const std::pair<MDGraph_vertex_ptr, cur_vertex_map>& a,
-                  const std::pair<MDGraph_vertex_ptr, cur_vertex_map>& b) {
-                  return boost::any_cast<int>(a.second.at("weight")) >
-                         boost::any_cast<int>(b.second.at("weight"));
+              [&](const std::pair<MDGraph_vertex_ptr, MDGraph_path_state>& a,
+                  const std::pair<MDGraph_vertex_ptr, MDGraph_path_state>& b) {
+                  return a.second.weight > b.second.weight;
               });
 
     // return a vector of just the solvers
     std::vector<solver::AnySolver> res;
     for(auto& cur : cur_vertex)
     {
-        if(cur.second.find("solver") != cur.second.end())
+        if(!cur.second.solver.IsEmpty())
         {
-            res.push_back(boost::any_cast<solver::AnySolver>(cur.second.at("solver")));
+            res.push_back(cur.second.solver);
         }
     }
     return res;
@@ -191,15 +193,14 @@ bool FusionMDGraph::SetConvAlgo(miopenConvFwdAlgorithm_t algo)
         MIOPEN_THROW(miopenStatusBadParm,
                      "The last convolution operator does not support the requested algorithm");
     }
-    std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> new_list;
+    std::vector<std::pair<MDGraph_vertex_ptr, MDGraph_path_state>> new_list;
 
     for(auto& kinder : cur_vertex)
     {
         auto& cur_map = kinder.second;
-        if(cur_map.find("algo") != cur_map.end())
+        if(cur_map.has_algo)
         {
-            miopenConvFwdAlgorithm_t a = boost::any_cast<miopenConvFwdAlgorithm_t>(cur_map["algo"]);
-            if(a == algo)
+            if(cur_map.algo == algo)
             {
                 new_list.emplace_back(kinder.first, cur_map);
             }
@@ -218,19 +219,7 @@ bool FusionMDGraph::SetConvAlgo(miopenConvFwdAlgorithm_t algo)
 
 void FusionMDGraph::Init(FusionMDGraph& g, miopenFusionOp_t op)
 {
-    switch(op)
-    {
-    case miopenFusionOpConvForward: InitConv(g); break;
-    case miopenFusionOpBatchNormInference: InitBN(g); break;
-    case miopenFusionOpBatchNormFwdTrain: InitBNFwd(g); break;
-    case miopenFusionOpBatchNormBwdTrain: InitBNBwd(g); break;
-    case miopenFusionOpActivForward:
-    case miopenFusionOpActivBackward:
-    case miopenFusionOpBiasForward:
-        MIOPEN_THROW(
-            miopenStatusNotImplemented,
-            "Operators Activ and Bias are not supported as first ops in a Fusion Plan (yet)");
-    }
+    g.automaton = MDGraph_automaton::Get(op);
 }
 
 static std::vector<DefaultKernelArg> BNFwdArgs(miopenBatchNormMode_t mode)
@@ -1002,47 +991,137 @@ void FusionMDGraph::AddEdge(MDGraph_vertex_ptr src,
     }
 }
 
-bool FusionMDGraph::CmpOpKey(const FusionMDGraph_Edge_Map& edge_val,
-                             std::function<bool(const std::string& sym, int& val)> attr_fun,
-                             std::unordered_map<std::string, int>& syms) const
+MDGraph_automaton::MDGraph_automaton(const EdgeList& edge_list)
 {
-    for(auto& kv : edge_val)
+    const auto intern = [&](const std::string& name) {
+        const auto it = symbol_ids.find(name);
+        if(it != symbol_ids.end())
+            return it->second;
+        const auto id = static_cast<int>(symbols.size());
+        symbols.push_back(name);
+        symbol_ids.emplace(name, id);
+        return id;
+    };
+
+    // Always present, Advance looks them up
+    intern("weight");
+    intern("algo");
+
+    for(auto& src : edge_list)
     {
-        if(kv.first == "constraints")
+        auto& src_edges = edges[src.first];
+        for(auto& dst : src.second)
         {
-            tree_visit v(attr_fun);
-            for(auto& edg_op : kv.second)
+            auto& used = edge_symbols[std::make_pair(src.first, dst.first->op)];
+            for(auto& edg_map : dst.second)
             {
-                using It = std::string::const_iterator;
-                It f(edg_op.begin()), l(edg_op.end());
-                MDGExprParser p;
-                boost::spirit::utree e;
-                auto parse_success =
-                    boost::spirit::qi::phrase_parse(f, l, p, boost::spirit::ascii::space, e);
-                if(!parse_success)
-                {
-                    MIOPEN_LOG_I2(
-                        "Remaining unparsed: " << std::string(edg_op.begin(), edg_op.end()));
-                    MIOPEN_THROW(miopenStatusInternalError,
-                                 "Unable to parse graph constraint expression");
-                }
-                visit_res r = boost::spirit::utree::visit(e, v);
-                v.tabl.insert(r.tabl.begin(), r.tabl.end());
-                syms = v.tabl;
-                if(r.b_res)
-                {
-                    MIOPEN_LOG_I2("Constraint satisfied: " + edg_op);
-                }
-                else
+                Edge edge;
+                edge.dst = dst.first;
+                for(auto& kv : edg_map)
                 {
-                    MIOPEN_LOG_I("Condition unsuccessful while matching graph: " + edg_op);
-                    return false;
+                    if(kv.first != "constraints")
+                    {
+                        assert(false);
+                        continue;
+                    }
+                    for(auto& edg_op : kv.second)
+                    {
+                        edge.constraints.push_back(MDGraph_expr::Parse(edg_op, intern));
+                        edge.constraints.back().GetSymbols(used);
+                    }
                 }
+                src_edges.push_back(std::move(edge));
             }
+            std::sort(used.begin(), used.end());
+            used.erase(std::unique(used.begin(), used.end()), used.end());
+        }
+    }
+}
+
+std::shared_ptr<MDGraph_automaton> MDGraph_automaton::Get(miopenFusionOp_t op)
+{
+    static std::mutex mutex;
+    static std::map<miopenFusionOp_t, std::shared_ptr<MDGraph_automaton>> graphs;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& graph = graphs[op];
+    if(graph == nullptr)
+    {
+        FusionMDGraph g;
+        switch(op)
+        {
+        case miopenFusionOpConvForward: FusionMDGraph::InitConv(g); break;
+        case miopenFusionOpBatchNormInference: FusionMDGraph::InitBN(g); break;
+        case miopenFusionOpBatchNormFwdTrain: FusionMDGraph::InitBNFwd(g); break;
+        case miopenFusionOpBatchNormBwdTrain: FusionMDGraph::InitBNBwd(g); break;
+        case miopenFusionOpActivForward:
+        case miopenFusionOpActivBackward:
+        case miopenFusionOpBiasForward:
+            MIOPEN_THROW(
+                miopenStatusNotImplemented,
+                "Operators Activ and Bias are not supported as first ops in a Fusion Plan (yet)");
+        }
+        graph = std::make_shared<MDGraph_automaton>(g.edge_list);
+    }
+    return graph;
+}
+
+int MDGraph_automaton::GetSymbol(const std::string& name) const
+{
+    const auto it = symbol_ids.find(name);
+    return it != symbol_ids.end() ? it->second : -1;
+}
+
+const std::vector<MDGraph_automaton::Edge>&
+MDGraph_automaton::GetEdges(const MDGraph_vertex_ptr& src) const
+{
+    static const std::vector<Edge> none;
+    const auto it = edges.find(src);
+    return it != edges.end() ? it->second : none;
+}
+
+const std::vector<int>& MDGraph_automaton::GetSymbols(const MDGraph_vertex_ptr& src,
+                                                      miopenFusionOp_t op) const
+{
+    static const std::vector<int> none;
+    const auto it = edge_symbols.find(std::make_pair(src, op));
+    return it != edge_symbols.end() ? it->second : none;
+}
+
+bool MDGraph_automaton::FindStep(const std::string& key, Step& step) const
+{
+    std::lock_guard<std::mutex> lock(steps_mutex);
+    const auto it = steps.find(key);
+    if(it == steps.end())
+        return false;
+    step = it->second;
+    return true;
+}
+
+void MDGraph_automaton::AddStep(const std::string& key, const Step& step)
+{
+    // Every distinct layer shape adds a few entries, the limit is only a safety net
+    const std::size_t max_steps = 1 << 16;
+
+    std::lock_guard<std::mutex> lock(steps_mutex);
+    if(steps.size() >= max_steps)
+        steps.clear();
+    steps.emplace(key, step);
+}
+
+bool FusionMDGraph::CmpOpKey(const MDGraph_automaton::Edge& edge, MDGraph_symbols& syms) const
+{
+    syms.assigned.clear();
+    for(auto& constraint : edge.constraints)
+    {
+        if(constraint.Eval(syms).b_res)
+        {
+            MIOPEN_LOG_I2("Constraint satisfied: " + constraint.source);
         }
         else
         {
-            assert(false);
+            MIOPEN_LOG_I("Condition unsuccessful while matching graph: " + constraint.source);
+            return false;
         }
     }
     return true;
@@ -1052,12 +1131,55 @@ bool FusionMDGraph::Advance(std::shared_ptr<FusionOpDescriptor> op,
                             std::function<bool(const std::string& sym, int& val)> attr_fun)
 {
     MIOPEN_LOG_I("Adding Op: " << *op);
-    std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> new_list;
+    if(automaton == nullptr)
+        automaton = std::make_shared<MDGraph_automaton>(edge_list);
+
+    // Only the symbols the edges can look at take part in the matching, so the paths, the
+    // operator and the values of these symbols determine the result.
+    MDGraph_symbols syms{automaton->symbols};
+    std::ostringstream key;
+    key << op->kind();
+    for(auto& kinder : cur_vertex)
+    {
+        auto& state = kinder.second;
+        key << ';' << (kinder.first == nullptr ? 0 : kinder.first->id) << ',' << state.weight
+            << ',' << (state.has_algo ? static_cast<int>(state.algo) : -1) << ','
+            << (state.solver.IsEmpty() ? "" : state.solver.Type().name());
+    }
+    key << '|';
+    for(auto& kinder : cur_vertex)
+    {
+        for(auto symbol : automaton->GetSymbols(kinder.first, op->kind()))
+        {
+            if(syms.has_attr[symbol] != 0)
+                continue;
+            int val = 0;
+            if(attr_fun(syms.names[symbol], val))
+            {
+                syms.attrs[symbol]    = val;
+                syms.has_attr[symbol] = 1;
+                key << symbol << '=' << val << ',';
+            }
+        }
+    }
+
+    MDGraph_automaton::Step step;
+    if(automaton->FindStep(key.str(), step))
+    {
+        MIOPEN_LOG_I2("Reusing the graph match for: " << key.str());
+        cur_vertex    = std::move(step.cur_vertex);
+        conv_algo_set = std::move(step.conv_algo_set);
+        return (!cur_vertex.empty());
+    }
+
+    const auto weight_sym = automaton->GetSymbol("weight");
+    const auto algo_sym   = automaton->GetSymbol("algo");
+    std::vector<std::pair<MDGraph_vertex_ptr, MDGraph_path_state>> new_list;
     std::set<miopenConvFwdAlgorithm_t> new_set;
     // iterate over the list of current vertices
     for(auto& kinder : cur_vertex)
     {
-        MDGraph_vertex_ptr& cur_vertex_ptr = kinder.first;
+        const MDGraph_vertex_ptr& cur_vertex_ptr = kinder.first;
         if(cur_vertex_ptr == nullptr)
         {
             MIOPEN_LOG_I2("Current vertex: nullptr");
@@ -1066,77 +1188,69 @@ bool FusionMDGraph::Advance(std::shared_ptr<FusionOpDescriptor> op,
         {
             MIOPEN_LOG_I2("Current vertex: " << *cur_vertex_ptr);
         }
-        // get the children of the cur_vertex
-        auto& ch = edge_list[cur_vertex_ptr];
+        MIOPEN_LOG_I2("Current path weight: " << kinder.second.weight);
+        // The edges to a child follow each other, and each one that matches adds its weight to
+        // the state left by the previous matches of the edges to the same child.
+        MDGraph_vertex_ptr cur_child;
+        auto cur_map = kinder.second;
         // if op is in the children and the edge key satisfies update cur_vertex
-        for(auto& ch_it : ch)
+        for(auto& edge : automaton->GetEdges(cur_vertex_ptr))
         {
-            auto cur_map = kinder.second;
-            MIOPEN_LOG_I2("Current path weight: " << boost::any_cast<int>(cur_map["weight"]));
-            MIOPEN_LOG_I2("Child: " << *ch_it.first);
-            std::set<miopenConvFwdAlgorithm_t> cur_path_set;
-            if(ch_it.first->op == op->kind())
+            if(edge.dst->op != op->kind())
+                continue;
+
+            MIOPEN_LOG_I2("Child: " << *edge.dst);
+            if(edge.dst != cur_child)
+            {
+                cur_child = edge.dst;
+                cur_map   = kinder.second;
+            }
+            if(CmpOpKey(edge, syms))
             {
-                for(auto& edg_map : ch_it.second)
+                MIOPEN_LOG_I2("Key Match Successfull");
+                int weight = 0;
+                if(syms.GetAssigned(weight_sym, weight))
+                {
+                    cur_map.weight += weight;
+                }
+                else
+                {
+                    MIOPEN_LOG_I2("Weight not found, assuming zero");
+                }
+
+                // Update the algo set
+                if(op->kind() == miopenFusionOpConvForward)
                 {
-                    int weight = boost::any_cast<int>(cur_map["weight"]);
-                    std::unordered_map<std::string, int> syms;
-                    if(CmpOpKey(edg_map, attr_fun, syms))
+                    int algo = 0;
+                    if(syms.GetAssigned(algo_sym, algo))
                     {
-                        MIOPEN_LOG_I2("Key Match Successfull");
-                        if(syms.count("weight") != 0)
-                        {
-                            weight += syms.at("weight");
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_I2("Weight not found, assuming zero");
-                        }
-                        cur_map["weight"] = weight;
-
-                        // Update the algo set
-                        if(op->kind() == miopenFusionOpConvForward)
-                        {
-                            if(syms.count("algo") != 0)
-                            {
-                                auto algo = static_cast<miopenConvFwdAlgorithm_t>(syms.at("algo"));
-                                MIOPEN_LOG_I2("Operator Matched: Convolution: Algo: " +
-                                              std::to_string(algo));
-                                cur_path_set.insert(algo);
-
-                                new_set.insert(cur_path_set.begin(), cur_path_set.end());
-                                assert(cur_path_set.size() == 1);
-                                cur_map["algo"] =
-                                    *cur_path_set.begin(); // there should be only one algo
-                                cur_map.erase("solver");
-                                if(!ch_it.first->solver.IsEmpty())
-                                {
-                                    cur_map.insert(std::pair<std::string, solver::AnySolver>(
-                                        "solver", ch_it.first->solver));
-                                }
-                            }
-                            else
-                            {
-                                MIOPEN_THROW(miopenStatusInternalError,
-                                             "algo is not provided for "
-                                             "a convolution oeprator in "
-                                             "the metadata graph");
-                            }
-                        }
-                        else
-                        {
-                            MIOPEN_LOG_I2("Operator Matched: " + std::to_string(op->kind()));
-                            cur_map.erase("algo");
-                        }
-                        new_list.emplace_back(ch_it.first, cur_map);
+                        MIOPEN_LOG_I2("Operator Matched: Convolution: Algo: " +
+                                      std::to_string(algo));
+                        new_set.insert(static_cast<miopenConvFwdAlgorithm_t>(algo));
+                        cur_map.has_algo = true;
+                        cur_map.algo     = static_cast<miopenConvFwdAlgorithm_t>(algo);
+                        cur_map.solver   = edge.dst->solver;
                     }
                     else
                     {
-                        MIOPEN_LOG_I2("Key Map Match unsuccessful");
+                        MIOPEN_THROW(miopenStatusInternalError,
+                                     "algo is not provided for "
+                                     "a convolution oeprator in "
+                                     "the metadata graph");
                     }
                 }
+                else
+                {
+                    MIOPEN_LOG_I2("Operator Matched: " + std::to_string(op->kind()));
+                    cur_map.has_algo = false;
+                }
+                MIOPEN_LOG_I2("Current path final weight: " << cur_map.weight);
+                new_list.emplace_back(edge.dst, cur_map);
+            }
+            else
+            {
+                MIOPEN_LOG_I2("Key Map Match unsuccessful");
             }
-            MIOPEN_LOG_I2("Current path final weight: " << boost::any_cast<int>(cur_map["weight"]));
         }
     }
     cur_vertex = new_list;
@@ -1149,22 +1263,21 @@ bool FusionMDGraph::Advance(std::shared_ptr<FusionOpDescriptor> op,
         conv_algo_set.clear();
     }
     // sort according to the edge weight
-    std::sort(cur_vertex.begin(),
-              cur_vertex.end(),
-              [&](const std::pair<MDGraph_vertex_ptr, cur_vertex_map>& a,
-                  const std::pair<MDGraph_vertex_ptr, cur_vertex_map>& b) {
-                  return boost::any_cast<int>(a.second.at("weight")) >
-                         boost::any_cast<int>(b.second.at("weight"));
-              });
-
+    std::stable_sort(cur_vertex.begin(),
+                     cur_vertex.end(),
+                     [&](const std::pair<MDGraph_vertex_ptr, MDGraph_path_state>& a,
+                         const std::pair<MDGraph_vertex_ptr, MDGraph_path_state>& b) {
+                         return a.second.weight > b.second.weight;
+                     });
+
+    automaton->AddStep(key.str(), {cur_vertex, conv_algo_set});
     return (!cur_vertex.empty());
 }
 
 void FusionMDGraph::Reset()
 {
     cur_vertex.clear();
-    cur_vertex_map empty_map = {{"weight", 0}};
-    cur_vertex.emplace_back(nullptr, empty_map);
+    cur_vertex.emplace_back(nullptr, MDGraph_path_state{});
 }
 
 // guard for debug only
@@ -1220,12 +1333,15 @@ void FusionMDGraph::WriteToFile(std::string filename)
     std::stringstream dot_graph;
     dot_file.open(filename);
 
-    for(auto& edge : edge_list)
+    if(automaton == nullptr)
+        automaton = std::make_shared<MDGraph_automaton>(edge_list);
+
+    for(auto& src : automaton->GetAllEdges())
     {
-        nodes.insert(edge.first);
-        for(auto& edge2 : edge.second)
+        nodes.insert(src.first);
+        for(auto& edge : src.second)
         {
-            nodes.insert(edge2.first);
+            nodes.insert(edge.dst);
         }
     }
 
@@ -1243,33 +1359,19 @@ void FusionMDGraph::WriteToFile(std::string filename)
         }
     }
 
-    int src_id, dst_id;
-
-    for(auto& edge : edge_list)
+    for(auto& src : automaton->GetAllEdges())
     {
-        if(edge.first != nullptr)
-            src_id = edge.first->id;
-        else
-            src_id = 0;
-        for(auto& edge2 : edge.second)
+        const auto src_id = src.first != nullptr ? src.first->id : 0;
+        for(auto& edge : src.second)
         {
-            if(edge2.first != nullptr)
-                dst_id = edge2.first->id;
-            else
-                dst_id = 0;
-            for(auto& edg_map : edge2.second)
+            const auto dst_id = edge.dst != nullptr ? edge.dst->id : 0;
+            std::stringstream edge_label;
+            for(auto& constraint : edge.constraints)
             {
-                std::stringstream edge_label;
-                for(auto& edg_ops : edg_map)
-                {
-                    for(auto& e : edg_ops.second)
-                    {
-                        edge_label << e << "\\n";
-                    }
-                }
-                dot_graph << src_id << "->" << dst_id << "[label=\"" << edge_label.str() << "\"];"
-                          << std::endl;
+                edge_label << constraint.source << "\\n";
             }
+            dot_graph << src_id << "->" << dst_id << "[label=\"" << edge_label.str() << "\"];"
+                      << std::endl;
         }
     }
 
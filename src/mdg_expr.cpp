@@ -1,5 +1,9 @@
 #include <miopen/mdg_expr.hpp>
 
+#include <cmath>
+#include <string>
+#include <vector>
+
 namespace miopen {
 
 MDGExprParser::MDGExprParser() : MDGExprParser::base_type(expression)
@@ -50,4 +54,215 @@ MDGExprParser::MDGExprParser() : MDGExprParser::base_type(expression)
     BOOST_SPIRIT_DEBUG_NODE(variable);
 }
 
+namespace {
+
+struct tree_compile
+{
+    using result_type = int;
+
+    MDGraph_expr& expr;
+    const std::function<int(const std::string&)>& intern;
+
+    tree_compile(MDGraph_expr& e, const std::function<int(const std::string&)>& f)
+        : expr(e), intern(f)
+    {
+    }
+
+    int Add(MDGraph_expr::NodeKind kind,
+            int value,
+            MDGraph_op_t op = OpAny,
+            int lhs         = -1,
+            int rhs         = -1)
+    {
+        expr.nodes.push_back({kind, op, value, lhs, rhs});
+        return static_cast<int>(expr.nodes.size()) - 1;
+    }
+
+    int operator()(spirit::utree::invalid_type) { return Add(MDGraph_expr::Constant, 0); }
+
+    int operator()(spirit::utree::nil_type) { return Add(MDGraph_expr::Constant, 0); }
+
+    int operator()(double d) { return Add(MDGraph_expr::Constant, static_cast<int>(d)); }
+
+    int operator()(int i) { return Add(MDGraph_expr::Constant, i); }
+
+    int operator()(bool) { return Add(MDGraph_expr::Constant, 0); }
+
+    template <typename T>
+    int operator()(T /*val*/)
+    {
+        return Add(MDGraph_expr::Constant, 0);
+    }
+
+    int operator()(spirit::binary_range_type const& /*b*/)
+    {
+        return Add(MDGraph_expr::Constant, 0);
+    }
+
+    int operator()(spirit::utf8_string_range_type const& str)
+    {
+        return Add(MDGraph_expr::Symbol, intern(std::string(str.begin(), str.end())));
+    }
+
+    int operator()(spirit::utf8_symbol_range_type const& /*str*/)
+    {
+        MIOPEN_THROW(miopenStatusInternalError, "Parsing error: Operator without operands");
+    }
+
+    template <typename Iterator>
+    int operator()(boost::iterator_range<Iterator> const& range)
+    {
+        std::vector<spirit::utree> v(range.begin(), range.end());
+        assert(v.size() == 3);
+        tree_visit op_visit;
+        const auto op  = boost::spirit::utree::visit(v[0], op_visit).op;
+        const auto lhs = boost::spirit::utree::visit(v[1], *this);
+        const auto rhs = boost::spirit::utree::visit(v[2], *this);
+        return Add(MDGraph_expr::Binary, 0, op, lhs, rhs);
+    }
+
+    int operator()(spirit::any_ptr const&) { return Add(MDGraph_expr::Constant, 0); }
+
+    int operator()(spirit::function_base const&) { return Add(MDGraph_expr::Constant, 0); }
+};
+
+} // namespace
+
+bool MDGraph_symbols::GetAssigned(int symbol, int& val) const
+{
+    for(auto& kinder : assigned)
+    {
+        if(kinder.first == symbol)
+        {
+            val = kinder.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+MDGraph_expr MDGraph_expr::Parse(const std::string& src,
+                                 const std::function<int(const std::string&)>& intern)
+{
+    using It = std::string::const_iterator;
+    It f(src.begin()), l(src.end());
+    MDGExprParser p;
+    boost::spirit::utree e;
+    auto parse_success = boost::spirit::qi::phrase_parse(f, l, p, boost::spirit::ascii::space, e);
+    if(!parse_success)
+    {
+        MIOPEN_LOG_I2("Remaining unparsed: " << src);
+        MIOPEN_THROW(miopenStatusInternalError, "Unable to parse graph constraint expression");
+    }
+
+    MDGraph_expr expr;
+    expr.source = src;
+    tree_compile compile{expr, intern};
+    boost::spirit::utree::visit(e, compile);
+    return expr;
+}
+
+MDGraph_expr::Result MDGraph_expr::Eval(MDGraph_symbols& syms) const
+{
+    return Eval(syms, static_cast<int>(nodes.size()) - 1);
+}
+
+MDGraph_expr::Result MDGraph_expr::Eval(MDGraph_symbols& syms, int node) const
+{
+    const auto& n = nodes[node];
+    Result r;
+
+    if(n.kind == Constant)
+    {
+        r.res = n.value;
+        return r;
+    }
+
+    if(n.kind == Symbol)
+    {
+        if(syms.has_attr[n.value] != 0)
+            r.res = syms.attrs[n.value];
+        else if(!syms.GetAssigned(n.value, r.res))
+            r.unresolved = n.value;
+        return r;
+    }
+
+    if(n.op == OpAssign)
+    {
+        const auto& target = nodes[n.lhs];
+        const auto rhs     = Eval(syms, n.rhs);
+        if(target.kind != Symbol || syms.has_attr[target.value] != 0)
+        {
+            const auto name = target.kind == Symbol ? syms.names[target.value] : source;
+            MIOPEN_THROW("Invalid variable assignment: " + name);
+        }
+
+        int val = 0;
+        if(!syms.GetAssigned(target.value, val))
+        {
+            MIOPEN_LOG_I2(" Adding variable: " + syms.names[target.value]);
+            syms.assigned.emplace_back(target.value, rhs.res);
+        }
+        r.b_res = true;
+        return r;
+    }
+
+    const auto lhs = Eval(syms, n.lhs);
+    const auto rhs = Eval(syms, n.rhs);
+
+    if(lhs.unresolved >= 0)
+    {
+        MIOPEN_THROW("Invalid variable access: " + syms.names[lhs.unresolved]);
+    }
+
+    switch(n.op)
+    {
+    // Arith ops
+    case OpAdd: r.res = lhs.res + rhs.res; break;
+    case OpSub: r.res = lhs.res - rhs.res; break;
+    case OpMul: r.res = lhs.res * rhs.res; break;
+    case OpDiv: r.res = lhs.res / rhs.res; break;
+    case OpModulo: r.res = lhs.res % rhs.res; break;
+    case OpPow: r.res = static_cast<int>(std::pow(lhs.res, rhs.res)); break;
+    case OpCeil:
+        r.res = (lhs.res % rhs.res != 0) ? (lhs.res / rhs.res + 1) * rhs.res : lhs.res;
+        break;
+    // Logical ops
+    case OpEqual: r.b_res = lhs.res == rhs.res; break;
+    case OpNotEqual: r.b_res = lhs.res != rhs.res; break;
+    case OpGTE: r.b_res = lhs.res >= rhs.res; break;
+    case OpLTE: r.b_res = lhs.res <= rhs.res; break;
+    case OpGT: r.b_res = lhs.res > rhs.res; break;
+    case OpLT: r.b_res = lhs.res < rhs.res; break;
+    case OpAnd: r.b_res = lhs.b_res && rhs.b_res; break;
+    case OpOr: r.b_res = lhs.b_res || rhs.b_res; break;
+    case OpAssign:
+    case OpAny:
+    case OpEval: MIOPEN_THROW("Unsupported op");
+    }
+
+    switch(n.op)
+    {
+    case OpEqual:
+    case OpNotEqual:
+    case OpGTE:
+    case OpLTE:
+    case OpGT:
+    case OpLT:
+    case OpAnd:
+    case OpOr: r.res = static_cast<int>(r.b_res); break;
+    default: break;
+    }
+    return r;
+}
+
+void MDGraph_expr::GetSymbols(std::vector<int>& symbols) const
+{
+    for(auto& n : nodes)
+    {
+        if(n.kind == Symbol)
+            symbols.push_back(n.value);
+    }
+}
+
 } // namespace miopen
@@ -68,10 +68,10 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
         return tmp;
     }();
 
-    const auto algo           = AlgorithmName{"miopenActivationForward"};
-    const auto network_config = problem.MakeNetworkConfig();
+    const auto algo        = AlgorithmName{"miopenActivationForward"};
+    const auto problem_key = ProblemKey{problem.MakeNetworkConfig()};
 
-    if(const auto invoker = handle.GetInvoker(network_config, boost::none, algo))
+    if(const auto invoker = handle.GetInvoker(problem_key, boost::none, algo))
     {
         (*invoker)(handle, invoke_params);
         return miopenStatusSuccess;
@@ -89,7 +89,7 @@ miopenStatus_t ActivationDescriptor::Forward(Handle& handle,
     if(!sln.invoker_factory)
         MIOPEN_THROW(miopenStatusInternalError, "Invoker missing in solver " + sln.solver_id);
     const auto invoker = handle.PrepareInvoker(*sln.invoker_factory, sln.construction_params);
-    handle.RegisterInvoker(invoker, network_config, sln.solver_id, algo);
+    handle.RegisterInvoker(invoker, problem_key, sln.solver_id, algo);
     invoker(handle, invoke_params);
     return miopenStatusSuccess;
 }
@@ -139,10 +139,10 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
         return tmp;
     }();
 
-    const auto algo           = AlgorithmName{"miopenActivationBackward"};
-    const auto network_config = problem.MakeNetworkConfig();
+    const auto algo        = AlgorithmName{"miopenActivationBackward"};
+    const auto problem_key = ProblemKey{problem.MakeNetworkConfig()};
 
-    if(const auto invoker = handle.GetInvoker(network_config, boost::none, algo))
+    if(const auto invoker = handle.GetInvoker(problem_key, boost::none, algo))
     {
         (*invoker)(handle, invoke_params);
         return miopenStatusSuccess;
@@ -159,7 +159,7 @@ miopenStatus_t ActivationDescriptor::Backward(Handle& handle,
     if(!sln.invoker_factory)
         MIOPEN_THROW(miopenStatusInternalError, "Invoker missing in solver " + sln.solver_id);
     const auto invoker = handle.PrepareInvoker(*sln.invoker_factory, sln.construction_params);
-    handle.RegisterInvoker(invoker, network_config, sln.solver_id, algo);
+    handle.RegisterInvoker(invoker, problem_key, sln.solver_id, algo);
     invoker(handle, invoke_params);
     return miopenStatusSuccess;
 }
@@ -264,7 +264,7 @@ template <class InvokeParams>
 static void EvaluateInvokers(Handle& handle,
                              const std::vector<solver::ConvSolution>& solutions,
                              const AlgorithmName& algorithm_name,
-                             const NetworkConfig& network_config,
+                             const ProblemKey& problem_key,
                              const InvokeParams& invoke_ctx,
                              DbRecord& record)
 {
@@ -323,7 +323,7 @@ static void EvaluateInvokers(Handle& handle,
 
     if(selected.Succeeded())
     {
-        handle.RegisterInvoker(best_invoker, network_config, selected.solver_id, algorithm_name);
+        handle.RegisterInvoker(best_invoker, problem_key, selected.solver_id, algorithm_name);
         MIOPEN_LOG_I("Selected: " << selected << ": " << best
                                   << ", workspce_sz = " << selected.workspce_sz);
         record.SetValues(algorithm_name,
@@ -361,8 +361,8 @@ static void DirConvFindCore(Handle& handle,
     AutoEnableProfiling enableProfiling{handle};
     ValidateGroupCount(xDesc, wDesc, conv);
 
-    const auto network_config = ctx.BuildConfKey();
-    const auto invoke_ctx     = conv::DataInvokeParams{
+    const auto problem_key = ctx.BuildProblemKey();
+    const auto invoke_ctx  = conv::DataInvokeParams{
         InvokeType::Evaluate, {xDesc, x, wDesc, w, yDesc, y}, workSpace, workSpaceSize};
 
     // Find solutions
@@ -403,31 +403,31 @@ static void DirConvFindCore(Handle& handle,
     EvaluateInvokers(handle,
                      gemm,
                      AlgorithmName{"miopenConvolutionFwdAlgoGEMM"},
-                     network_config,
+                     problem_key,
                      invoke_ctx,
                      record);
     EvaluateInvokers(handle,
                      winograd,
                      AlgorithmName{"miopenConvolutionFwdAlgoWinograd"},
-                     network_config,
+                     problem_key,
                      invoke_ctx,
                      record);
     EvaluateInvokers(handle,
                      direct,
                      AlgorithmName{"miopenConvolutionFwdAlgoDirect"},
-                     network_config,
+                     problem_key,
                      invoke_ctx,
                      record);
     EvaluateInvokers(handle,
                      igemm,
                      AlgorithmName{"miopenConvolutionFwdAlgoImplicitGEMM"},
-                     network_config,
+                     problem_key,
                      invoke_ctx,
                      record);
     EvaluateInvokers(handle,
                      fft,
                      AlgorithmName{"miopenConvolutionFwdAlgoFFT"},
-                     network_config,
+                     problem_key,
                      invoke_ctx,
                      record);
 }
@@ -537,27 +537,34 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                          << ", " << perf_db[0].time);
 }
 
-void ValidateConvTensors(const ConvTensors& tensors)
+static bool ConvTensorDescriptorsMatch(const TensorDescriptor& xDesc,
+                                       const TensorDescriptor& wDesc,
+                                       const TensorDescriptor& yDesc)
 {
-    const auto invalid_buffers =
-        tensors.x == nullptr || tensors.w == nullptr || tensors.y == nullptr;
-
-    const auto tensor_sizes_not_matched = tensors.xDesc.GetSize() != tensors.yDesc.GetSize() ||
-                                          tensors.xDesc.GetSize() != tensors.wDesc.GetSize();
+    const auto tensor_sizes_not_matched =
+        xDesc.GetSize() != yDesc.GetSize() || xDesc.GetSize() != wDesc.GetSize();
 
     const auto tensor_types_not_matched =
-        (tensors.xDesc.GetType() != tensors.yDesc.GetType() &&
-         tensors.xDesc.GetType() != miopenInt8 && tensors.xDesc.GetType() != miopenInt8x4) ||
-        tensors.xDesc.GetType() != tensors.wDesc.GetType();
+        (xDesc.GetType() != yDesc.GetType() && xDesc.GetType() != miopenInt8 &&
+         xDesc.GetType() != miopenInt8x4) ||
+        xDesc.GetType() != wDesc.GetType();
 
     // if(xDesc.GetLengths()[1] != wDesc.GetLengths()[1]) {
     //    MIOPEN_THROW(miopenStatusBadParm);
     //}
 
-    const auto x_tensor_invalid = tensors.xDesc.GetSize() < 3;
+    const auto x_tensor_invalid = xDesc.GetSize() < 3;
+
+    return !(tensor_sizes_not_matched || tensor_types_not_matched || x_tensor_invalid);
+}
+
+void ValidateConvTensors(const ConvTensors& tensors)
+{
+    const auto invalid_buffers =
+        tensors.x == nullptr || tensors.w == nullptr || tensors.y == nullptr;
 
     const auto bad_parameters =
-        invalid_buffers || tensor_sizes_not_matched || tensor_types_not_matched || x_tensor_invalid;
+        invalid_buffers || !ConvTensorDescriptorsMatch(tensors.xDesc, tensors.wDesc, tensors.yDesc);
 
     if(bad_parameters)
         MIOPEN_THROW(miopenStatusBadParm);
@@ -623,8 +630,8 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
         auto ctx =
             ConvolutionContext{xDesc, wDesc, yDesc, *this, conv::Direction::Forward}; // forward
         ctx.SetStream(&handle);
-        const auto network_config = ctx.BuildConfKey();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto problem_key = ctx.BuildProblemKey();
+        const auto& invoker    = handle.GetInvoker(problem_key, {}, algorithm_name);
 
         if(invoker)
         {
@@ -938,7 +945,7 @@ static std::vector<KernelInvoke> CompileSolver(const Handle& handle,
 
 static Invoker PrepareInvoker(Handle& handle,
                               ConvolutionContext& ctx,
-                              const NetworkConfig& config,
+                              const ProblemKey& problem_key,
                               solver::Id solver_id,
                               conv::Direction dir)
 {
@@ -952,7 +959,7 @@ static Invoker PrepareInvoker(Handle& handle,
         handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
 
     handle.RegisterInvoker(
-        invoker, config, solver_id.ToString(), AlgorithmName(solver_id.GetAlgo(dir)));
+        invoker, problem_key, solver_id.ToString(), AlgorithmName(solver_id.GetAlgo(dir)));
     return invoker; // NOLINT (performance-no-automatic-move)
 }
 
@@ -961,11 +968,11 @@ static Invoker LoadOrPrepareInvoker(Handle& handle,
                                     solver::Id solver_id,
                                     conv::Direction dir)
 {
-    const auto config = ctx.BuildConfKey();
-    auto invoker      = handle.GetInvoker(config, solver_id);
+    const auto problem_key = ctx.BuildProblemKey();
+    auto invoker           = handle.GetInvoker(problem_key, solver_id);
     if(invoker)
         return *invoker;
-    return PrepareInvoker(handle, ctx, config, solver_id, dir);
+    return PrepareInvoker(handle, ctx, problem_key, solver_id, dir);
 }
 
 static bool CheckInvokerSupport(const solver::Id solver_id, conv::Direction dir)
@@ -1122,8 +1129,8 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
         }();
 
         perf_db = UserFindDbRecord::TryLoad(handle, problem, [&](DbRecord& record) {
-            const auto network_config = problem.BuildConfKey();
-            const auto invoke_ctx     = conv::DataInvokeParams{
+            const auto problem_key = problem.BuildProblemKey();
+            const auto invoke_ctx  = conv::DataInvokeParams{
                 InvokeType::Evaluate, {dyDesc, dy, wDesc, w, dxDesc, dx}, workSpace, workSpaceSize};
 
             ctx.skip_solutions_that_take_long_time_to_build_and_have_narrow_coverage =
@@ -1170,31 +1177,31 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
             EvaluateInvokers(handle,
                              gemm,
                              AlgorithmName{"miopenConvolutionBwdDataAlgoGEMM"},
-                             network_config,
+                             problem_key,
                              invoke_ctx,
                              record);
             EvaluateInvokers(handle,
                              winograd,
                              AlgorithmName{"miopenConvolutionBwdDataAlgoWinograd"},
-                             network_config,
+                             problem_key,
                              invoke_ctx,
                              record);
             EvaluateInvokers(handle,
                              direct,
                              AlgorithmName{"miopenConvolutionBwdDataAlgoDirect"},
-                             network_config,
+                             problem_key,
                              invoke_ctx,
                              record);
             EvaluateInvokers(handle,
                              igemm,
                              AlgorithmName{"miopenConvolutionBwdDataAlgoImplicitGEMM"},
-                             network_config,
+                             problem_key,
                              invoke_ctx,
                              record);
             EvaluateInvokers(handle,
                              fft,
                              AlgorithmName{"miopenConvolutionBwdDataAlgoFFT"},
-                             network_config,
+                             problem_key,
                              invoke_ctx,
                              record);
         });
@@ -1282,8 +1289,8 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
 
         auto ctx = ConvolutionContext{dxDesc, wDesc, dyDesc, *this, conv::Direction::BackwardData};
         ctx.SetStream(&handle);
-        const auto network_config = ctx.BuildConfKey();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto problem_key = ctx.BuildProblemKey();
+        const auto& invoker    = handle.GetInvoker(problem_key, {}, algorithm_name);
 
         if(!invoker)
             MIOPEN_THROW("No invoker was registered for convolution backward. Was find executed?");
@@ -1487,8 +1494,8 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
             ctx.SetBufs(bufs);
             ctx.SetupFloats();
             ctx.DetectRocm();
-            const auto network_config = ctx.BuildConfKey();
-            const auto invoke_ctx     = conv::WrWInvokeParams{
+            const auto problem_key = ctx.BuildProblemKey();
+            const auto invoke_ctx  = conv::WrWInvokeParams{
                 InvokeType::Evaluate, {dyDesc, dy, xDesc, x, dwDesc, dw}, workSpace, workSpaceSize};
 
             // Find solutions
@@ -1520,25 +1527,25 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
             EvaluateInvokers(handle,
                              gemm,
                              AlgorithmName{"miopenConvolutionBwdWeightsAlgoGEMM"},
-                             network_config,
+                             problem_key,
                              invoke_ctx,
                              record);
             EvaluateInvokers(handle,
                              direct,
                              AlgorithmName{"miopenConvolutionBwdWeightsAlgoDirect"},
-                             network_config,
+                             problem_key,
                              invoke_ctx,
                              record);
             EvaluateInvokers(handle,
                              winograd,
                              AlgorithmName{"miopenConvolutionBwdWeightsAlgoWinograd"},
-                             network_config,
+                             problem_key,
                              invoke_ctx,
                              record);
             EvaluateInvokers(handle,
                              implictgemm,
                              AlgorithmName{"miopenConvolutionBwdWeightsAlgoImplicitGEMM"},
-                             network_config,
+                             problem_key,
                              invoke_ctx,
                              record);
         });
@@ -1620,8 +1627,8 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(const Handle& handle,
         decltype(auto) algorithm_name = AlgorithmName{ConvolutionAlgoToDirectionalString(
             static_cast<miopenConvAlgorithm_t>(algo), direction)};
         decltype(auto) ctx = conv::ProblemDescription{dyDesc, dwDesc, xDesc, *this, direction};
-        decltype(auto) network_config = ctx.BuildConfKey();
-        decltype(auto) invoker = handle.GetInvoker(network_config, boost::none, algorithm_name);
+        decltype(auto) problem_key = ctx.BuildProblemKey();
+        decltype(auto) invoker     = handle.GetInvoker(problem_key, boost::none, algorithm_name);
 
         if(!invoker)
             MIOPEN_THROW("No invoker was registered for convolution weights. Was find executed?");
@@ -1759,6 +1766,44 @@ void ConvolutionDescriptor::ConvolutionWrwImmediate(Handle& handle,
     });
 }
 
+Invoker ConvolutionDescriptor::PrepareSolution(Handle& handle,
+                                               conv::Direction direction,
+                                               const TensorDescriptor& xDesc,
+                                               const TensorDescriptor& wDesc,
+                                               const TensorDescriptor& yDesc,
+                                               solver::Id solver_id) const
+{
+    MIOPEN_LOG_I("solver_id = " << solver_id.ToString());
+
+    if(!solver_id.IsValid() || !ConvTensorDescriptorsMatch(xDesc, wDesc, yDesc))
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    switch(direction)
+    {
+    case conv::Direction::Forward: break;
+    case conv::Direction::BackwardData:
+        if(wDesc.GetType() == miopenInt8 || yDesc.GetLengths()[1] != wDesc.GetLengths()[0])
+            MIOPEN_THROW(miopenStatusBadParm);
+        break;
+    case conv::Direction::BackwardWeights:
+        if(xDesc.GetType() == miopenInt8)
+            MIOPEN_THROW(miopenStatusBadParm);
+        break;
+    }
+
+    ValidateGroupCount(xDesc, wDesc, *this);
+
+    if(!CheckInvokerSupport(solver_id, direction))
+    {
+        MIOPEN_THROW("Solver " + solver_id.ToString() +
+                     " requested in a prepared convolution, which is not supported.");
+    }
+
+    auto ctx = ConvolutionContext{xDesc, wDesc, yDesc, *this, direction};
+    ctx.SetStream(&handle);
+    return LoadOrPrepareInvoker(handle, ctx, solver_id, direction);
+}
+
 void ConvolutionBackwardBias(const Handle& handle,
                              const void* alpha,
                              const TensorDescriptor& dyDesc,
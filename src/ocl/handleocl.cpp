@@ -36,6 +36,7 @@
 #include <miopen/load_file.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/manage_ptr.hpp>
+#include <miopen/mapped_file.hpp>
 #include <miopen/ocldeviceinfo.hpp>
 #include <miopen/timer.hpp>
 
@@ -44,6 +45,7 @@
 #endif
 
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
 
 #include <string>
 
@@ -384,11 +386,53 @@ Program Handle::LoadProgram(const std::string& program_name,
                             bool is_kernel_str,
                             const std::string& kernel_src) const
 {
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    {
+        const auto mapped = miopen::MapBinary(this->GetTargetProperties(),
+                                              this->GetMaxComputeUnits(),
+                                              program_name,
+                                              params,
+                                              is_kernel_str);
+        if(mapped.IsValid())
+        {
+            try
+            {
+                return LoadBinaryProgram(miopen::GetContext(this->GetStream()),
+                                         miopen::GetDevice(this->GetStream()),
+                                         std::string(mapped.Data(), mapped.Size()));
+            }
+            catch(const Exception& ex)
+            {
+                MIOPEN_LOG_W("Unable to load the cached binary " << mapped.Path() << ": "
+                                                                 << ex.what());
+                miopen::RemoveMappedBinary(mapped);
+            }
+        }
+    }
+#endif
+
     auto hsaco = miopen::LoadBinary(this->GetTargetProperties(),
                                     this->GetMaxComputeUnits(),
                                     program_name,
                                     params,
                                     is_kernel_str);
+
+    // Held until the binary is saved, so that the others building it wait and then load it.
+    boost::optional<CompileClaim> claim;
+    if(hsaco.empty())
+    {
+        claim.emplace(this->GetTargetProperties(),
+                      this->GetMaxComputeUnits(),
+                      program_name,
+                      params,
+                      is_kernel_str);
+        hsaco = miopen::LoadBinary(this->GetTargetProperties(),
+                                   this->GetMaxComputeUnits(),
+                                   program_name,
+                                   params,
+                                   is_kernel_str);
+    }
+
     if(hsaco.empty())
     {
         CompileTimer ct;
@@ -23,20 +23,40 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <atomic>
 #include <cassert>
 #include <miopen/fusion.hpp>
 #include <miopen/logger.hpp>
 
 namespace miopen {
 
+static std::size_t NewLayoutId()
+{
+    static std::atomic<std::size_t> next{1};
+    return next++;
+}
+
 // operator args
-OperatorArgs::OperatorArgs() {}
+OperatorArgs::OperatorArgs() : layout_id(NewLayoutId()) {}
 
 void OperatorArgs::ins_arg(std::string name, OpKernelArg v)
 {
-    args_map.emplace(std::make_pair(name, v));
-    //    args_map[name] = std::move(v);
-    args_vec.push_back(v);
+    const auto slot = args_slots.find(name);
+    if(slot != args_slots.end())
+    {
+        args_vec[slot->second] = std::move(v);
+        return;
+    }
+
+    args_slots.emplace(std::move(name), args_vec.size());
+    args_vec.push_back(std::move(v));
+    layout_id = NewLayoutId();
+}
+
+int OperatorArgs::FindSlot(const std::string& name) const
+{
+    const auto slot = args_slots.find(name);
+    return slot != args_slots.end() ? static_cast<int>(slot->second) : -1;
 }
 
 std::ostream& operator<<(std::ostream& stream, const OperatorArgs&) // x )
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/prepared_convolution.hpp>
+
+#include <miopen/check_numerics.hpp>
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/tensors.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+
+#include <ostream>
+#include <utility>
+
+namespace miopen {
+
+PreparedConvolution::PreparedConvolution(Handle& handle,
+                                         const ConvolutionDescriptor& convDesc,
+                                         conv::Direction direction_,
+                                         const TensorDescriptor& wDesc_,
+                                         const TensorDescriptor& xDesc_,
+                                         const TensorDescriptor& yDesc_,
+                                         solver::Id solver_id_)
+    : handle_id(handle.GetId()),
+      direction(direction_),
+      swap_xy(convDesc.mode == miopenTranspose),
+      wDesc(wDesc_),
+      xDesc(swap_xy ? yDesc_ : xDesc_),
+      yDesc(swap_xy ? xDesc_ : yDesc_),
+      solver_id(solver_id_)
+{
+    if(swap_xy && direction == conv::Direction::Forward)
+        direction = conv::Direction::BackwardData;
+    else if(swap_xy && direction == conv::Direction::BackwardData)
+        direction = conv::Direction::Forward;
+
+    invoker = convDesc.PrepareSolution(handle, direction, xDesc, wDesc, yDesc, solver_id);
+}
+
+void PreparedConvolution::Run(const Handle& handle,
+                              Data_t w,
+                              Data_t x,
+                              Data_t y,
+                              Data_t workSpace,
+                              std::size_t workSpaceSize) const
+{
+    if(handle.GetId() != handle_id)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "The convolution has been prepared with a different handle");
+    if(w == nullptr || x == nullptr || y == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm);
+
+    if(swap_xy)
+        std::swap(x, y);
+
+    const auto check_numerics = CheckNumericsEnabled();
+
+    switch(direction)
+    {
+    case conv::Direction::Forward: {
+        if(check_numerics)
+        {
+            checkNumericsInput(handle, xDesc, x);
+            checkNumericsInput(handle, wDesc, w);
+        }
+        const auto tensors    = ConvFwdTensors{xDesc, x, wDesc, w, yDesc, y};
+        const auto invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
+        invoker(handle, invoke_ctx);
+        if(check_numerics)
+            checkNumericsOutput(handle, yDesc, y);
+        break;
+    }
+    case conv::Direction::BackwardData: {
+        if(check_numerics)
+        {
+            checkNumericsInput(handle, yDesc, y);
+            checkNumericsInput(handle, wDesc, w);
+        }
+        const auto tensors    = ConvBwdTensors{yDesc, y, wDesc, w, xDesc, x};
+        const auto invoke_ctx = conv::DataInvokeParams{tensors, workSpace, workSpaceSize};
+        invoker(handle, invoke_ctx);
+        if(check_numerics)
+            checkNumericsOutput(handle, xDesc, x);
+        break;
+    }
+    case conv::Direction::BackwardWeights: {
+        if(check_numerics)
+        {
+            checkNumericsInput(handle, yDesc, y);
+            checkNumericsInput(handle, xDesc, x);
+        }
+        const auto tensors    = ConvWrwTensors{yDesc, y, xDesc, x, wDesc, w};
+        const auto invoke_ctx = conv::WrWInvokeParams{tensors, workSpace, workSpaceSize};
+        invoker(handle, invoke_ctx);
+        if(check_numerics)
+            checkNumericsOutput(handle, wDesc, w);
+        break;
+    }
+    }
+}
+
+std::ostream& operator<<(std::ostream& stream, const PreparedConvolution& prepared)
+{
+    return stream << prepared.solver_id.ToString() << ", direction "
+                  << static_cast<int>(prepared.direction);
+}
+
+} // namespace miopen
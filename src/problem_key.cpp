@@ -0,0 +1,118 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/problem_key.hpp>
+
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <ostream>
+#include <sstream>
+
+namespace miopen {
+
+namespace {
+
+// 64-bit FNV-1a
+constexpr std::uint64_t hash_basis = 14695981039346656037ULL;
+constexpr std::uint64_t hash_prime = 1099511628211ULL;
+
+std::uint64_t HashBytes(std::uint64_t hash, const char* data, std::size_t size)
+{
+    for(std::size_t i = 0; i < size; ++i)
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * hash_prime;
+    return hash;
+}
+
+} // namespace
+
+ProblemKey::ProblemKey(const NetworkConfig& config_)
+    : config(config_.ToString()), hash(HashBytes(hash_basis, config.data(), config.size()))
+{
+}
+
+ProblemKey::ProblemKey(Formatter formatter_, const Field* fields_, std::size_t count)
+    : formatter(formatter_), fields_count(count)
+{
+    std::copy(fields_, fields_ + count, fields.begin());
+
+    // Fields are hashed as whole words, which is enough to spread the small numbers they hold.
+    hash = hash_basis;
+    for(std::size_t i = 0; i < fields_count; ++i)
+        hash = (hash ^ static_cast<std::uint64_t>(fields[i])) * hash_prime;
+    // Keeps the keys of different kinds with equal fields apart.
+    hash = (hash ^ reinterpret_cast<std::uintptr_t>(formatter)) * hash_prime;
+}
+
+std::string ProblemKey::ToString() const
+{
+    if(formatter == nullptr)
+        return config;
+
+    std::ostringstream ss;
+    formatter(ss, fields.data());
+    return ss.str();
+}
+
+bool operator==(const ProblemKey& left, const ProblemKey& right)
+{
+    return left.hash == right.hash && left.formatter == right.formatter &&
+           left.fields_count == right.fields_count &&
+           std::equal(left.fields.begin(),
+                      left.fields.begin() + left.fields_count,
+                      right.fields.begin()) &&
+           left.config == right.config;
+}
+
+std::ostream& operator<<(std::ostream& stream, const ProblemKey& key)
+{
+    if(key.formatter == nullptr)
+        return stream << key.config;
+    key.formatter(stream, key.fields.data());
+    return stream;
+}
+
+ProblemKey::Field ProblemKey::PackString(const std::string& str)
+{
+    if(str.size() > sizeof(Field))
+        MIOPEN_THROW("Can not pack '" + str + "' into a problem key field");
+
+    std::uint64_t packed = 0;
+    for(std::size_t i = 0; i < str.size(); ++i)
+        packed |= static_cast<std::uint64_t>(static_cast<unsigned char>(str[i])) << (8 * i);
+    return static_cast<Field>(packed);
+}
+
+std::string ProblemKey::UnpackString(Field field)
+{
+    auto packed = static_cast<std::uint64_t>(field);
+    std::string str;
+    for(; packed != 0; packed >>= 8)
+        str += static_cast<char>(packed & 0xFF);
+    return str;
+}
+
+} // namespace miopen
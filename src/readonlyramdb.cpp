@@ -25,8 +25,10 @@
  *******************************************************************************/
 
 #include <miopen/readonlyramdb.hpp>
+#include <miopen/cow_registry.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/par_for.hpp>
 
 #if MIOPEN_EMBED_DB
 #include <miopen_data.hpp>
@@ -35,30 +37,41 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
 
-#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <limits>
 #include <mutex>
-#include <sstream>
-#include <map>
+#include <thread>
+#include <vector>
 
 namespace miopen {
 extern boost::optional<std::string>&
 testing_find_db_path_override(); /// \todo Remove when #1723 is resolved.
+namespace {
+struct ReadonlyRamDbRegistry
+{
+    CowRegistry<ReadonlyRamDb> instances;
+    /// Guards prefetches.
+    std::mutex mutex;
+    /// Declared last to be destroyed first, i.e. background loads are waited for while the rest
+    /// of the registry is still alive.
+    std::vector<std::future<void>> prefetches;
+};
+
+ReadonlyRamDbRegistry& GetRegistry()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static ReadonlyRamDbRegistry registry;
+    return registry;
+}
+} // namespace
+
 ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path,
                                         bool warn_if_unreadable,
                                         const std::string& /*arch*/,
                                         const std::size_t /*num_cu*/)
 {
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
-    const std::lock_guard<std::mutex> lock{mutex};
-
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static auto instances = std::map<std::string, ReadonlyRamDb*>{};
-    const auto it         = instances.find(path);
-
-    if(it != instances.end())
-        return *it->second;
-
     // The ReadonlyRamDb objects allocated here by "new" shall be alive during
     // the calling app lifetime. Size of each is very small, and there couldn't
     // be many of them (max number is number of _different_ GPU board installed
@@ -66,12 +79,50 @@ ReadonlyRamDb& ReadonlyRamDb::GetCached(const std::string& path,
     // footprint in heap is very small. That is why we can omit deletion of
     // these objects thus avoiding bothering with MP/MT syncronization.
     // These will be destroyed altogether with heap.
-    auto instance = new ReadonlyRamDb{path};
-    instances.emplace(path, instance);
-    instance->Prefetch(path, warn_if_unreadable);
+    const auto instance =
+        &GetRegistry().instances.GetOrInsert(path, [&]() { return new ReadonlyRamDb{path}; });
+
+    // Loading is done outside of the registry lock, so it does not block access to other dbs.
+    // Concurrent users of the same db wait here until it is loaded.
+    std::call_once(instance->prefetched, [&]() { instance->Prefetch(path, warn_if_unreadable); });
     return *instance;
 }
 
+void ReadonlyRamDb::StartPrefetch(const std::string& path, bool warn_if_unreadable)
+{
+    auto& registry = GetRegistry();
+    if(registry.instances.Find(path) != nullptr)
+        return;
+
+    const std::lock_guard<std::mutex> lock{registry.mutex};
+
+    registry.prefetches.erase(
+        std::remove_if(registry.prefetches.begin(),
+                       registry.prefetches.end(),
+                       [](const auto& f) {
+                           return f.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+                       }),
+        registry.prefetches.end());
+
+    MIOPEN_LOG_I2("Starting background load of " << path);
+    registry.prefetches.push_back(std::async(std::launch::async, [path, warn_if_unreadable]() {
+        try
+        {
+            GetCached(path, warn_if_unreadable);
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Background load of " << path << " has failed: " << ex.what());
+        }
+    }));
+}
+
+ReadonlyRamDb::~ReadonlyRamDb()
+{
+    for(auto i = std::size_t{0}; parsed != nullptr && i < items.size(); ++i)
+        delete parsed[i].load();
+}
+
 template <class TFunc>
 static auto Measure(const std::string& funcName, TFunc&& func)
 {
@@ -84,42 +135,197 @@ static auto Measure(const std::string& funcName, TFunc&& func)
     MIOPEN_LOG_I("Db::" << funcName << " time: " << (end - start).count() * .000001f << " ms");
 }
 
-void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream,
-                                   const std::string& path,
-                                   bool warn_if_unreadable)
+std::size_t ReadonlyRamDb::Hash(boost::string_view key)
 {
-    if(!input_stream)
+    // FNV-1a
+    auto hash = std::uint64_t{14695981039346656037ull};
+    for(const auto c : key)
     {
-        const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB) ? LoggingLevel::Warning
-                                                                             : LoggingLevel::Info;
-        MIOPEN_LOG(log_level, "File is unreadable: " << path);
-        return;
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
     }
+    return static_cast<std::size_t>(hash);
+}
 
-    auto line   = std::string{};
-    auto n_line = 0;
+const ReadonlyRamDb::CacheItem* ReadonlyRamDb::Find(boost::string_view key) const
+{
+    if(slots.empty())
+        return nullptr;
+
+    const auto hash = Hash(key);
+    const auto mask = slots.size() - 1;
 
-    while(std::getline(input_stream, line))
+    for(auto slot = hash & mask;; slot = (slot + 1) & mask)
     {
-        ++n_line;
+        if(slots[slot] == 0)
+            return nullptr;
+
+        const auto& item = items[slots[slot] - 1];
+        if(item.hash == hash && item.key == key)
+            return &item;
+    }
+}
+
+const DbRecord* ReadonlyRamDb::FindParsed(const std::string& problem) const
+{
+    MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
+    const auto item = Find(problem);
+
+    if(item == nullptr)
+        return nullptr;
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+    MIOPEN_LOG_I2("Contents found: " << item->content);
+
+    auto& cached      = parsed[item - items.data()];
+    const auto record = cached.load(std::memory_order_acquire);
+
+    if(record != nullptr)
+        return record;
+
+    auto new_record = std::unique_ptr<DbRecord>{new DbRecord{problem}};
+
+    if(!new_record->ParseContents(item->content))
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << problem << " form file "
+                                                             << db_path << "#" << item->line);
+        MIOPEN_LOG_E("Contents: " << item->content);
+        return nullptr;
+    }
+
+    // Several threads may parse the same record at the same time, the first one wins.
+    const DbRecord* expected = nullptr;
+    if(cached.compare_exchange_strong(expected, new_record.get(), std::memory_order_acq_rel))
+        return new_record.release();
+    return expected;
+}
+
+struct ReadonlyRamDb::Chunk
+{
+    const char* begin;
+    const char* end;
+    std::vector<CacheItem> items;
+    std::vector<int> ill_formed_lines;
+    int lines = 0;
+};
+
+void ReadonlyRamDb::ParseChunk(Chunk& chunk)
+{
+    for(auto line_begin = chunk.begin; line_begin < chunk.end;)
+    {
+        ++chunk.lines;
+
+        const auto eol =
+            static_cast<const char*>(std::memchr(line_begin, '\n', chunk.end - line_begin));
+        const auto line_end = eol == nullptr ? chunk.end : eol;
+        const auto line     = boost::string_view(line_begin, line_end - line_begin);
+        line_begin          = eol == nullptr ? chunk.end : eol + 1;
 
         if(line.empty())
             continue;
 
         const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+        const bool is_key   = (key_size != boost::string_view::npos && key_size != 0);
 
         if(!is_key)
         {
-            MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#" << n_line);
+            chunk.ill_formed_lines.push_back(chunk.lines);
             continue;
         }
 
-        const auto key      = line.substr(0, key_size);
-        const auto contents = line.substr(key_size + 1);
+        const auto key = line.substr(0, key_size);
+        chunk.items.push_back({key, line.substr(key_size + 1), Hash(key), chunk.lines});
+    }
+}
+
+void ReadonlyRamDb::ParseAndLoadDb(const char* begin, const char* end)
+{
+    // Small files are not worth spawning threads.
+    constexpr auto min_chunk_size = std::size_t{256 * 1024};
+    const auto size               = static_cast<std::size_t>(end - begin);
+    const auto chunk_count        = std::max<std::size_t>(
+        1, std::min<std::size_t>(std::thread::hardware_concurrency(), size / min_chunk_size));
+
+    // Split the data on line boundaries.
+    auto chunks = std::vector<Chunk>(chunk_count);
+    for(auto i = std::size_t{0}; i < chunk_count; ++i)
+    {
+        chunks[i].begin = i == 0 ? begin : chunks[i - 1].end;
+        chunks[i].end   = end;
+
+        if(i + 1 == chunk_count)
+            break;
+
+        const auto split = std::max(chunks[i].begin, begin + size * (i + 1) / chunk_count);
+        const auto eol   = static_cast<const char*>(std::memchr(split, '\n', end - split));
+        if(eol != nullptr)
+            chunks[i].end = eol + 1;
+    }
+
+    par_for(chunk_count, max_threads{chunk_count}, [&](auto i) { ParseChunk(chunks[i]); });
+
+    auto total = std::size_t{0};
+    for(const auto& chunk : chunks)
+        total += chunk.items.size();
+    items.reserve(total);
+
+    auto n_line = 0;
+    for(const auto& chunk : chunks)
+    {
+        for(const auto line : chunk.ill_formed_lines)
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << db_path << "#" << n_line + line);
+
+        for(auto item : chunk.items)
+        {
+            item.line += n_line;
+            items.push_back(item);
+        }
+
+        n_line += chunk.lines;
+    }
+
+    MIOPEN_LOG_I2("Loaded " << items.size() << " records from " << db_path << " in "
+                            << chunk_count << " chunk(s)");
+    BuildTable();
+}
+
+void ReadonlyRamDb::BuildTable()
+{
+    if(items.size() >= std::numeric_limits<std::uint32_t>::max() / 2)
+        MIOPEN_THROW("Too many records in " + db_path);
 
-        cache.emplace(key, CacheItem{n_line, contents});
+    // Keep the load factor under 0.5.
+    auto table_size = std::size_t{16};
+    while(table_size < items.size() * 2)
+        table_size *= 2;
+
+    slots.assign(table_size, 0);
+    const auto mask = table_size - 1;
+    auto unique     = std::vector<CacheItem>{};
+    unique.reserve(items.size());
+
+    for(const auto& item : items)
+    {
+        const auto is_same = [&](std::uint32_t index) {
+            return unique[index - 1].hash == item.hash && unique[index - 1].key == item.key;
+        };
+
+        auto slot = item.hash & mask;
+        while(slots[slot] != 0 && !is_same(slots[slot]))
+            slot = (slot + 1) & mask;
+
+        // The first record with the key wins.
+        if(slots[slot] != 0)
+            continue;
+
+        unique.push_back(item);
+        slots[slot] = static_cast<std::uint32_t>(unique.size());
     }
+
+    items.swap(unique);
+    parsed.reset(new std::atomic<const DbRecord*>[items.size()]);
+    for(auto i = std::size_t{0}; i < items.size(); ++i)
+        parsed[i].store(nullptr, std::memory_order_relaxed);
 }
 
 void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
@@ -136,16 +342,25 @@ void ReadonlyRamDb::Prefetch(const std::string& path, bool warn_if_unreadable)
                              "Unknown database: " + filepath.string() + " in internal filesystem");
 
             const auto& p = it_p->second;
-            ptrdiff_t sz  = p.second - p.first;
             MIOPEN_LOG_I2("Loading In Memory file: " << filepath);
-            auto input_stream = std::stringstream(std::string(p.first, sz));
-            ParseAndLoadDb(input_stream, path, warn_if_unreadable);
+            // The embedded data lives as long as the library, no need to copy it.
+            ParseAndLoadDb(p.first, p.second);
 #endif
         }
         else
         {
-            auto input_stream = std::ifstream{path};
-            ParseAndLoadDb(input_stream, path, warn_if_unreadable);
+            file = MappedFile{path};
+
+            if(!file.IsValid())
+            {
+                const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                                           ? LoggingLevel::Warning
+                                           : LoggingLevel::Info;
+                MIOPEN_LOG(log_level, "File is unreadable: " << path);
+                return;
+            }
+
+            ParseAndLoadDb(file.Data(), file.Data() + file.Size());
         }
     });
 }
@@ -54,20 +54,42 @@ std::ostream& operator<<(std::ostream& os, const KernelInfo& k)
     return os << "} '" << k.comp_options << '\'';
 }
 
-std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels)
+std::vector<boost::optional<Program>> TryPrecompileKernels(const Handle& h,
+                                                           const std::vector<KernelInfo>& kernels)
 {
     CompileTimer ct;
-    std::vector<Program> programs(kernels.size());
+    std::vector<boost::optional<Program>> programs(kernels.size());
 
-    // clang-format off
     par_for_strided(kernels.size(),
                     max_threads{Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20)},
                     [&](auto i) {
                         const KernelInfo& k = kernels[i];
-                        programs[i]         = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
+                        try
+                        {
+                            programs[i] = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
+                        }
+                        catch(const std::exception& ex)
+                        {
+                            MIOPEN_LOG_I2("Failed to build " << k.kernel_file << ": " << ex.what());
+                        }
                     });
-    // clang-format on
-    ct.Log("PrecompileKernels");
+    ct.Log("TryPrecompileKernels");
+    return programs;
+}
+
+std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<KernelInfo>& kernels)
+{
+    const auto built = TryPrecompileKernels(h, kernels);
+    std::vector<Program> programs;
+    programs.reserve(built.size());
+
+    for(std::size_t i = 0; i < built.size(); ++i)
+    {
+        if(!built[i])
+            MIOPEN_THROW("Failed to build " + kernels[i].kernel_file + " with options '" +
+                         kernels[i].comp_options + "'");
+        programs.push_back(*built[i]);
+    }
     return programs;
 }
 
@@ -31,6 +31,8 @@
 #include <miopen/hip_build_utils.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
 
+#include <limits>
+
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CONV_IMPLICIT_GEMM_HIP_FWD_V4R4_XDLOPS)
 
 /* this fix is for fp16 xdlops vectorizable kernels due to followings, we may revisit this fix after
@@ -1016,6 +1018,32 @@ bool ConvHipImplicitGemmForwardV4R4Xdlops::IsApplicable(const ConvolutionContext
     return config.IsReallyValid(ctx);
 }
 
+// A CU does a few hundred xdlops multiply-accumulates in the time it takes to load one element
+// of A or B from the memory, so the loads are weighted accordingly. The blocks run in rounds
+// over the CUs, hence the grid is rounded up to the whole rounds.
+float ConvHipImplicitGemmForwardV4R4Xdlops::EstimateCost(
+    const ConvolutionContext& ctx, const PerformanceImplicitGemmForwardV4R4Xdlops& config) const
+{
+    int grid_size = 0;
+    bool valid    = false;
+
+    std::tie(grid_size, valid) = config.CalculateGridSize(ctx);
+    if(!valid || grid_size <= 0)
+        return std::numeric_limits<float>::max();
+
+    int gemm_k_total = 0;
+
+    std::tie(std::ignore, std::ignore, std::ignore, gemm_k_total) = CalculateGemmSize(ctx);
+
+    const auto macs_per_load = 256.0f;
+    const auto num_cu        = std::max<std::size_t>(ctx.GetStream().GetMaxComputeUnits(), 1);
+    const auto n_rounds      = (static_cast<std::size_t>(grid_size) + num_cu - 1) / num_cu;
+
+    const auto block_macs  = static_cast<float>(config.GemmMPerBlock) * config.GemmNPerBlock;
+    const auto block_loads = static_cast<float>(config.GemmMPerBlock + config.GemmNPerBlock);
+    return n_rounds * (block_macs + macs_per_load * block_loads) * gemm_k_total;
+}
+
 PerformanceImplicitGemmForwardV4R4Xdlops
 ConvHipImplicitGemmForwardV4R4Xdlops::Search(const ConvolutionContext& ctx,
                                              const AnyInvokeParams& invoke_ctx) const
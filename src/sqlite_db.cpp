@@ -51,12 +51,15 @@
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
 
 extern "C" {
 int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
 }
 namespace miopen {
 
+using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+
 class SQLite::impl
 {
     struct SQLiteCloser
@@ -172,8 +175,37 @@ class SQLite::impl
             sqlite3_busy_timeout(ptrDb.get(), MIOPEN_SQL_BUSY_TIMEOUT_MS);
     }
 
+    /// Takes a statement prepared earlier for the query out of the cache, if there is one.
+    sqlite3_stmt_ptr TakeStatement(const std::string& query)
+    {
+        const std::lock_guard<std::mutex> lock{statements_mutex};
+        const auto it = statements.find(query);
+        if(it == statements.end())
+            return nullptr;
+        auto stmt = std::move(it->second);
+        statements.erase(it);
+        return stmt;
+    }
+
+    /// Resets the statement and puts it into the cache, unless the cache is full or already has
+    /// a statement for the query (which is the case when a query is run concurrently).
+    void ReturnStatement(const std::string& query, sqlite3_stmt_ptr stmt)
+    {
+        constexpr std::size_t max_cached_statements = 64;
+        sqlite3_reset(stmt.get());
+        sqlite3_clear_bindings(stmt.get());
+        const std::lock_guard<std::mutex> lock{statements_mutex};
+        if(statements.size() < max_cached_statements)
+            statements.emplace(query, std::move(stmt));
+    }
+
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+    /// Declared after ptrDb to be finalized before the connection is closed.
+    std::mutex statements_mutex;
+    std::unordered_map<std::string, sqlite3_stmt_ptr> statements;
+    std::mutex batch_mutex;
+    int batch_depth = 0;
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -263,9 +295,34 @@ std::string SQLite::ErrorMessage() const
 }
 bool SQLite::Valid() const { return pImpl->isValid; }
 
+void SQLite::BeginBatch() const
+{
+    const std::lock_guard<std::mutex> lock{pImpl->batch_mutex};
+    if(pImpl->batch_depth == 0)
+        Exec("BEGIN IMMEDIATE;");
+    ++pImpl->batch_depth;
+}
+
+void SQLite::EndBatch() const
+{
+    const std::lock_guard<std::mutex> lock{pImpl->batch_mutex};
+    if(--pImpl->batch_depth != 0)
+        return;
+
+    try
+    {
+        Exec("COMMIT;");
+    }
+    catch(...)
+    {
+        // Do not leave the transaction open, otherwise the next batch cannot start.
+        sqlite3_exec(pImpl->ptrDb.get(), "ROLLBACK;", nullptr, nullptr, nullptr);
+        throw;
+    }
+}
+
 class SQLite::Statement::impl
 {
-    using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
     sqlite3_stmt_ptr Prepare(const SQLite& sql, const std::string& query)
     {
         sqlite3_stmt* ptr = nullptr;
@@ -282,9 +339,19 @@ class SQLite::Statement::impl
 
     public:
     impl(const SQLite& sql, const std::string& query) { ptrStmt = Prepare(sql, query); }
-    impl(const SQLite& sql, const std::string& query, const std::vector<std::string>& vals)
+    impl(const SQLite& sql,
+         const std::string& query,
+         const std::vector<std::string>& vals,
+         bool cached = false)
     {
-        ptrStmt = Prepare(sql, query);
+        if(cached)
+        {
+            owner   = sql.pImpl.get();
+            key     = query;
+            ptrStmt = owner->TakeStatement(query);
+        }
+        if(ptrStmt == nullptr)
+            ptrStmt = Prepare(sql, query);
         int cnt = 1;
         for(auto& kinder : vals)
         {
@@ -296,7 +363,20 @@ class SQLite::Statement::impl
         MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
     }
 
+    ~impl()
+    {
+        if(owner != nullptr && ptrStmt != nullptr)
+            owner->ReturnStatement(key, std::move(ptrStmt));
+    }
+
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
     sqlite3_stmt_ptr ptrStmt = nullptr;
+
+    private:
+    SQLite::impl* owner = nullptr;
+    std::string key;
 };
 
 SQLite::SQLite(const std::string& filename_, bool is_system)
@@ -314,6 +394,13 @@ SQLite::Statement::Statement(const SQLite& sql,
     : pImpl{std::make_unique<impl>(sql, query, vals)}
 {
 }
+SQLite::Statement::Statement(const SQLite& sql,
+                             const std::string& query,
+                             const std::vector<std::string>& vals,
+                             Cached)
+    : pImpl{std::make_unique<impl>(sql, query, vals, true)}
+{
+}
 SQLite::Statement::~Statement() = default;
 SQLite::Statement::Statement() : pImpl{nullptr} {}
 SQLite::Statement::Statement(Statement&&) noexcept = default;
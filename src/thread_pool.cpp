@@ -0,0 +1,272 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace miopen {
+
+struct ThreadPool::Loop
+{
+    struct Slot
+    {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end   = 0;
+    };
+
+    const Body& body;
+    const std::size_t n;
+    std::vector<Slot> slots;
+    /// The caller always takes the first slot.
+    std::atomic<std::size_t> joined{1};
+    std::atomic<std::size_t> done{0};
+    std::atomic<bool> failed{false};
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+
+    Loop(std::size_t n_, std::size_t participants, const Body& body_)
+        : body(body_), n(n_), slots(participants)
+    {
+        const auto count = slots.size();
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            slots[i].begin = n * i / count;
+            slots[i].end   = n * (i + 1) / count;
+        }
+    }
+
+    void Run(std::size_t slot)
+    {
+        std::size_t begin = 0;
+        std::size_t end   = 0;
+
+        while(Take(slot, begin, end) || Steal(slot, begin, end))
+            Execute(begin, end);
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&]() { return done.load() == n; });
+    }
+
+    private:
+    /// Takes a quarter of the own range, so that chunks get smaller as the loop proceeds and
+    /// there is something left for the others to steal.
+    bool Take(std::size_t slot, std::size_t& begin, std::size_t& end)
+    {
+        auto& own = slots[slot];
+        std::lock_guard<std::mutex> lock(own.mutex);
+
+        if(own.begin == own.end)
+            return false;
+
+        const auto chunk = std::max<std::size_t>(1, (own.end - own.begin) / 4);
+        begin            = own.begin;
+        end              = own.begin + chunk;
+        own.begin        = end;
+        return true;
+    }
+
+    /// Moves the upper half of the largest range left to another participant into the own slot
+    /// and takes a chunk of it.
+    bool Steal(std::size_t slot, std::size_t& begin, std::size_t& end)
+    {
+        while(true)
+        {
+            auto victim  = slots.size();
+            auto largest = std::size_t{0};
+
+            for(std::size_t i = 0; i < slots.size(); ++i)
+            {
+                if(i == slot)
+                    continue;
+
+                std::lock_guard<std::mutex> lock(slots[i].mutex);
+                const auto size = slots[i].end - slots[i].begin;
+                if(size > largest)
+                {
+                    largest = size;
+                    victim  = i;
+                }
+            }
+
+            if(victim == slots.size())
+                return false;
+
+            std::size_t stolen_begin = 0;
+            std::size_t stolen_end   = 0;
+            {
+                auto& other = slots[victim];
+                std::lock_guard<std::mutex> lock(other.mutex);
+
+                // The victim could have taken the rest by now.
+                if(other.begin == other.end)
+                    continue;
+
+                stolen_begin = other.end - (other.end - other.begin + 1) / 2;
+                stolen_end   = other.end;
+                other.end    = stolen_begin;
+            }
+
+            {
+                auto& own = slots[slot];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                own.begin = stolen_begin;
+                own.end   = stolen_end;
+            }
+
+            if(Take(slot, begin, end))
+                return true;
+        }
+    }
+
+    void Execute(std::size_t begin, std::size_t end)
+    {
+        if(!failed)
+        {
+            try
+            {
+                body(begin, end);
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(!error)
+                    error = std::current_exception();
+                failed = true;
+            }
+        }
+
+        if(done.fetch_add(end - begin) + (end - begin) == n)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+    }
+};
+
+ThreadPool::ThreadPool(std::size_t workers)
+{
+    threads.reserve(workers);
+    for(std::size_t i = 0; i < workers; ++i)
+        threads.emplace_back([this]() { WorkerMain(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+
+    for(auto& thread : threads)
+        thread.join();
+}
+
+ThreadPool& ThreadPool::Get()
+{
+    static ThreadPool pool{std::max(std::thread::hardware_concurrency(), 1u) - 1};
+    return pool;
+}
+
+void ThreadPool::ParallelFor(std::size_t n, std::size_t max_threads, const Body& body)
+{
+    const auto participants = std::min({max_threads, threads.size() + 1, n});
+
+    if(participants <= 1)
+    {
+        if(n != 0)
+            body(0, n);
+        return;
+    }
+
+    const auto loop = std::make_shared<Loop>(n, participants, body);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        loops.push_back(loop);
+    }
+
+    if(participants - 1 < threads.size())
+    {
+        for(std::size_t i = 1; i < participants; ++i)
+            wakeup.notify_one();
+    }
+    else
+    {
+        wakeup.notify_all();
+    }
+
+    loop->Run(0);
+    Remove(loop);
+    loop->Wait();
+
+    if(loop->error)
+        std::rethrow_exception(loop->error);
+}
+
+void ThreadPool::WorkerMain()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while(true)
+    {
+        wakeup.wait(lock, [&]() { return stopping || !loops.empty(); });
+
+        if(stopping)
+            return;
+
+        const auto loop = loops.front();
+        const auto slot = loop->joined++;
+
+        if(slot + 1 >= loop->slots.size())
+            loops.pop_front();
+        if(slot >= loop->slots.size())
+            continue;
+
+        lock.unlock();
+        loop->Run(slot);
+        lock.lock();
+    }
+}
+
+void ThreadPool::Remove(const std::shared_ptr<Loop>& loop)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = std::find(loops.begin(), loops.end(), loop);
+    if(it != loops.end())
+        loops.erase(it);
+}
+
+} // namespace miopen
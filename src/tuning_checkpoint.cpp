@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tuning_checkpoint.hpp>
+
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_CHECKPOINT)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+char ToChar(TuningCheckpoint::Record::Status status)
+{
+    switch(status)
+    {
+    case TuningCheckpoint::Record::Status::Failed: return 'f';
+    case TuningCheckpoint::Record::Status::Timed: return 't';
+    case TuningCheckpoint::Record::Status::Averaged: return 'a';
+    }
+    return '?';
+}
+
+bool FromChar(char c, TuningCheckpoint::Record::Status& status)
+{
+    switch(c)
+    {
+    case 'f': status = TuningCheckpoint::Record::Status::Failed; return true;
+    case 't': status = TuningCheckpoint::Record::Status::Timed; return true;
+    case 'a': status = TuningCheckpoint::Record::Status::Averaged; return true;
+    default: return false;
+    }
+}
+
+} // namespace
+
+std::unique_ptr<TuningCheckpoint> TuningCheckpoint::Open(const ExecutionContext& ctx,
+                                                         const std::string& problem,
+                                                         const std::string& solver,
+                                                         const std::string& strategy)
+{
+    if(IsDisabled(MIOPEN_DEBUG_TUNING_CHECKPOINT{}))
+        return nullptr;
+
+    const auto& udb = GetUserDbPath();
+    if(udb.empty())
+        return nullptr;
+
+    const auto key =
+        ctx.GetStream().GetDbBasename() + '\t' + solver + '\t' + strategy + '\t' + problem;
+
+    const auto path = boost::filesystem::path(udb) / "tuning" / (solver + '_' + md5(key) + ".txt");
+
+    return std::make_unique<TuningCheckpoint>(path, key);
+}
+
+TuningCheckpoint::TuningCheckpoint(boost::filesystem::path path_, std::string key_)
+    : path(std::move(path_)), key(std::move(key_))
+{
+    Load();
+}
+
+void TuningCheckpoint::Load()
+{
+    std::ifstream file(path.string());
+    if(!file)
+        return;
+
+    std::string line;
+    if(!std::getline(file, line) || line != key)
+    {
+        MIOPEN_LOG_W("Tuning checkpoint belongs to another problem, removed: " << path);
+        file.close();
+        Remove();
+        return;
+    }
+
+    while(std::getline(file, line))
+    {
+        // The last line has been left incomplete by an interruption.
+        if(file.eof())
+        {
+            needs_newline = true;
+            break;
+        }
+
+        const auto config_end = line.find('\t');
+        if(config_end == std::string::npos || line.size() < config_end + 3 ||
+           line[config_end + 2] != '\t')
+            continue;
+
+        Record record;
+        if(!FromChar(line[config_end + 1], record.status))
+            continue;
+
+        std::istringstream time(line.substr(config_end + 3));
+        if(!(time >> record.time))
+            continue;
+
+        records[line.substr(0, config_end)] = record;
+    }
+
+    if(!records.empty())
+        MIOPEN_LOG_I("Tuning checkpoint: " << records.size() << " configs loaded from " << path);
+}
+
+const TuningCheckpoint::Record* TuningCheckpoint::Find(const std::string& config) const
+{
+    const auto it = records.find(config);
+    return it == records.end() ? nullptr : &it->second;
+}
+
+void TuningCheckpoint::Add(const std::string& config, const Record& record)
+{
+    records[config] = record;
+
+    try
+    {
+        boost::filesystem::create_directories(path.parent_path());
+
+        std::ofstream file(path.string(), std::ios::app);
+        file.seekp(0, std::ios::end);
+
+        // The file may have been removed meanwhile, e.g. by another process that has completed
+        // the same search. Then it is written anew, with the key and all the records so far.
+        if(file.tellp() == 0)
+        {
+            file << key << '\n';
+            for(const auto& kv : records)
+                file << kv.first << '\t' << ToChar(kv.second.status) << '\t' << kv.second.time
+                     << '\n';
+            file.flush();
+        }
+        else
+        {
+            if(needs_newline)
+                file << '\n';
+            file << config << '\t' << ToChar(record.status) << '\t' << record.time << std::endl;
+        }
+        needs_newline = false;
+
+        if(!file)
+            MIOPEN_LOG_W("Unable to write tuning checkpoint: " << path);
+    }
+    catch(const boost::filesystem::filesystem_error& ex)
+    {
+        MIOPEN_LOG_W("Unable to write tuning checkpoint: " << ex.what());
+    }
+}
+
+void TuningCheckpoint::Remove()
+{
+    records.clear();
+
+    boost::system::error_code ec;
+    boost::filesystem::remove(path, ec);
+    if(ec)
+        MIOPEN_LOG_W("Unable to remove tuning checkpoint: " << path << ": " << ec.message());
+}
+
+} // namespace solver
+} // namespace miopen
@@ -84,6 +84,112 @@ void check_bz2_decompress()
     EXPECT(decompressed_str == miopen::decompress(compressed_str, orig_str.size() + 10));
 }
 
+void check_lz()
+{
+    bool success = false;
+    CHECK(miopen::lz_compress("", &success).empty());
+    EXPECT(!success);
+
+    // Nothing to find in random data, so it is kept as it is.
+    const auto random = random_string(4096);
+    EXPECT(miopen::lz_compress(random, &success) == random);
+    EXPECT(!success);
+
+    auto repeated = random_string(100);
+    for(auto i = 0; i < 6; ++i)
+        repeated += repeated;
+    repeated += random_string(17);
+    const auto compressed = miopen::lz_compress(repeated, &success);
+    EXPECT(success);
+    EXPECT(compressed.size() < repeated.size() / 10);
+    EXPECT(miopen::lz_decompress(compressed, repeated.size()) == repeated);
+
+    std::string decompressed;
+    CHECK(throws([&]() { decompressed = miopen::lz_decompress(compressed, 10); }));
+    CHECK(throws([&]() { decompressed = miopen::lz_decompress(compressed, repeated.size() + 1); }));
+    CHECK(throws([&]() {
+        decompressed = miopen::lz_decompress(compressed.substr(0, compressed.size() / 2),
+                                             repeated.size());
+    }));
+}
+
+void check_kern_db_codecs()
+{
+    miopen::KernelConfig cfg;
+    cfg.kernel_name = "kernel";
+    cfg.kernel_args = random_string(64);
+    cfg.kernel_blob = random_string(2048);
+    cfg.kernel_blob += cfg.kernel_blob;
+
+    const auto codecs = {
+        miopen::KernDbCodec::Bzip2, miopen::KernDbCodec::Lz, miopen::KernDbCodec::None};
+    miopen::TempFile temp_file("tmp-kerndb");
+
+    // Every codec reads the rows written by the others.
+    for(const auto writer : codecs)
+    {
+        miopen::KernDb db(std::string(temp_file), false, "gfx906", 60, writer);
+        CHECK(db.StoreRecordUnsafe(cfg));
+
+        for(const auto reader : codecs)
+        {
+            miopen::KernDb other(std::string(temp_file), false, "gfx906", 60, reader);
+            const auto readout = other.FindRecordUnsafe(cfg);
+            CHECK(readout);
+            CHECK(readout.get() == cfg.kernel_blob);
+        }
+
+        CHECK(db.RemoveRecordUnsafe(cfg));
+    }
+}
+
+void check_kern_db_without_codec()
+{
+    miopen::KernelConfig cfg;
+    cfg.kernel_name = "kernel";
+    cfg.kernel_args = random_string(64);
+    cfg.kernel_blob = random_string(4096);
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    {
+        // The layout of the databases written before the codec column was added.
+        const auto sql  = miopen::SQLite{std::string(temp_file), false};
+        bool compressed = false;
+        const auto blob = miopen::compress(cfg.kernel_blob, &compressed);
+        EXPECT(compressed);
+        sql.Exec("CREATE TABLE `kern_db` (`id` INTEGER PRIMARY KEY ASC"
+                 ",`kernel_name` TEXT NOT NULL,`kernel_args` TEXT NOT NULL"
+                 ",`kernel_blob` BLOB NOT NULL,`kernel_hash` TEXT NOT NULL"
+                 ",`uncompressed_size` INT NOT NULL);");
+        auto stmt = miopen::SQLite::Statement{
+            sql,
+            "INSERT INTO kern_db(kernel_name, kernel_args, kernel_blob, kernel_hash, "
+            "uncompressed_size) VALUES(?, ?, ?, ?, ?);"};
+        stmt.BindText(1, cfg.kernel_name);
+        stmt.BindText(2, cfg.kernel_args);
+        stmt.BindBlob(3, blob);
+        stmt.BindText(4, miopen::md5(cfg.kernel_blob));
+        stmt.BindInt64(5, cfg.kernel_blob.size());
+        CHECK(stmt.Step(sql) == SQLITE_DONE);
+    }
+
+    {
+        miopen::KernDb sys_db(std::string(temp_file), true, "gfx906", 60, miopen::KernDbCodec::Lz);
+        const auto readout = sys_db.FindRecordUnsafe(cfg);
+        CHECK(readout);
+        CHECK(readout.get() == cfg.kernel_blob);
+    }
+
+    miopen::KernDb user_db(std::string(temp_file), false, "gfx906", 60, miopen::KernDbCodec::Lz);
+    const auto readout = user_db.FindRecordUnsafe(cfg);
+    CHECK(readout);
+    CHECK(readout.get() == cfg.kernel_blob);
+
+    cfg.kernel_name = "other";
+    CHECK(user_db.StoreRecordUnsafe(cfg));
+    CHECK(user_db.FindRecordUnsafe(cfg).get() == cfg.kernel_blob);
+}
+
 void check_kern_db()
 {
     miopen::KernelConfig cfg0;
@@ -154,6 +260,9 @@ int main()
 #if MIOPEN_ENABLE_SQLITE
     check_bz2_compress();
     check_bz2_decompress();
+    check_lz();
     check_kern_db();
+    check_kern_db_codecs();
+    check_kern_db_without_codec();
 #endif
 }
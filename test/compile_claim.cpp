@@ -0,0 +1,69 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/target_properties.hpp>
+#include <miopen/tmp_dir.hpp>
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    // The lock files are left in the cache directory.
+    const miopen::TmpDir cache_dir{"compile_claim"};
+    setenv("MIOPEN_CUSTOM_CACHE_DIR", cache_dir.path.c_str(), 1); // NOLINT (concurrency-mt-unsafe)
+
+    // Claims are not taken when the binaries can not be shared through the cache.
+    if(miopen::GetCachePath(false).empty() || miopen::IsCacheDisabled())
+        return 0;
+
+    const miopen::TargetProperties target{};
+    std::atomic<int> builders{0};
+    std::atomic<bool> saved{false};
+    std::vector<std::thread> threads;
+
+    for(int i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&]() {
+            const miopen::CompileClaim claim{target, 1, "compile_claim_test.cl", "-DTEST"};
+            // Only the first thread builds, the others find the binary when they get the claim.
+            if(saved)
+                return;
+            EXPECT_EQUAL(++builders, 1);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            saved = true;
+        });
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+    EXPECT_EQUAL(builders.load(), 1);
+}
@@ -213,6 +213,23 @@ struct conv_base
     int conv_spatial_dims{};
     conv_stats* stats{}; // Denotes an object after object construction (never nullptr).
 
+    /// Error of the CPU reference, for a direction of a convolution that is not transposed.
+    double cpu_reference_error(cpu_conv_direction direction) const
+    {
+        if(filter.mode == miopenTranspose && direction != cpu_conv_direction::backward_weights)
+        {
+            direction = direction == cpu_conv_direction::forward ? cpu_conv_direction::backward_data
+                                                                 : cpu_conv_direction::forward;
+        }
+
+        return cpu_convolution_reference_error(cpu_convolution_algo(direction,
+                                                                    weights.desc,
+                                                                    filter.GetConvPads(),
+                                                                    filter.GetConvStrides(),
+                                                                    filter.GetConvDilations(),
+                                                                    filter.GetGroupCount()));
+    }
+
     void fail(float = 0) const
     {
         std::cout << "Input tensor: " << input.desc.ToString() << std::endl;
@@ -258,6 +275,11 @@ struct verify_forward_conv : conv_base<T, Tout>
         stats   = &pstats;
     }
 
+    double reference_error() const
+    {
+        return this->cpu_reference_error(cpu_conv_direction::forward);
+    }
+
     tensor<Tout> cpu() const
     {
         auto rout = out;
@@ -754,6 +776,11 @@ struct verify_backward_conv : conv_base<T>
         stats   = &pstats;
     }
 
+    double reference_error() const
+    {
+        return this->cpu_reference_error(cpu_conv_direction::backward_data);
+    }
+
     tensor<T> cpu() const
     {
         auto rinput = input;
@@ -1127,6 +1154,11 @@ struct verify_backward_weights_conv : conv_base<T>
         stats   = &pstats;
     }
 
+    double reference_error() const
+    {
+        return this->cpu_reference_error(cpu_conv_direction::backward_weights);
+    }
+
     tensor<T> cpu() const
     {
         auto rweights = weights;
@@ -1381,6 +1413,11 @@ struct verify_forward_conv_int8 : conv_base<T>
         stats   = &pstats;
     }
 
+    double reference_error() const
+    {
+        return this->cpu_reference_error(cpu_conv_direction::forward);
+    }
+
     tensor<float> cpu() const
     {
         auto rout = get_output_tensor_int8(filter, input, weights);
@@ -39,6 +39,16 @@
 #include "tensor_holder.hpp"
 #include <miopen/stringutils.hpp>
 #include <miopen/functional.hpp>
+#include <miopen/env.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CPU_CONV_ALGO)
 
 template <class T, class... Ts>
 static constexpr auto make_array(T x, Ts... xs)
@@ -47,13 +57,13 @@ static constexpr auto make_array(T x, Ts... xs)
 }
 
 template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
-void cpu_convolution_forward_impl(const tensor<Tin>& in,
-                                  const tensor<Twei>& wei,
-                                  tensor<Tout>& out,
-                                  const Range& pads,
-                                  const Range& strides,
-                                  const Range& dilations,
-                                  std::size_t group_count)
+void cpu_convolution_forward_direct_impl(const tensor<Tin>& in,
+                                         const tensor<Twei>& wei,
+                                         tensor<Tout>& out,
+                                         const Range& pads,
+                                         const Range& strides,
+                                         const Range& dilations,
+                                         std::size_t group_count)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
@@ -130,13 +140,13 @@ void cpu_convolution_forward_impl(const tensor<Tin>& in,
 }
 
 template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
-void cpu_convolution_backward_data_impl(tensor<Tin>& in,
-                                        const tensor<Twei>& wei,
-                                        const tensor<Tout>& out,
-                                        const Range& pads,
-                                        const Range& strides,
-                                        const Range& dilations,
-                                        std::size_t group_count)
+void cpu_convolution_backward_data_direct_impl(tensor<Tin>& in,
+                                               const tensor<Twei>& wei,
+                                               const tensor<Tout>& out,
+                                               const Range& pads,
+                                               const Range& strides,
+                                               const Range& dilations,
+                                               std::size_t group_count)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
@@ -215,13 +225,13 @@ void cpu_convolution_backward_data_impl(tensor<Tin>& in,
 }
 
 template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
-void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
-                                          tensor<Twei>& wei,
-                                          const tensor<Tout>& out,
-                                          const Range& pads,
-                                          const Range& strides,
-                                          const Range& dilations,
-                                          std::size_t group_count)
+void cpu_convolution_backward_weight_direct_impl(const tensor<Tin>& in,
+                                                 tensor<Twei>& wei,
+                                                 const tensor<Tout>& out,
+                                                 const Range& pads,
+                                                 const Range& strides,
+                                                 const Range& dilations,
+                                                 std::size_t group_count)
 {
     static_assert(ConvDim > 0, "wrong! convolution dim should be larger than 0");
     assert(in.desc.GetSize() == ConvDim + 2 and wei.desc.GetSize() == ConvDim + 2 and
@@ -293,6 +303,964 @@ void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
         });
 }
 
+/// Problem sizes and tensor strides of a convolution, as used by the GEMM based
+/// implementations below. Tensors are addressed through their strides, so any layout works.
+template <std::size_t ConvDim>
+struct cpu_conv_geometry
+{
+    using spatial_ids = std::array<std::ptrdiff_t, ConvDim>;
+
+    std::size_t batch_len;
+    std::size_t group_count;
+    std::size_t k_per_group;
+    std::size_t c_per_group;
+
+    std::array<std::size_t, ConvDim> in_spatial_len{};
+    std::array<std::size_t, ConvDim> wei_spatial_len{};
+    std::array<std::size_t, ConvDim> out_spatial_len{};
+    std::size_t in_spatial_size;
+    std::size_t wei_spatial_size;
+    std::size_t out_spatial_size;
+
+    spatial_ids pads{};
+    spatial_ids strides{};
+    spatial_ids dilations{};
+
+    std::size_t in_n_stride;
+    std::size_t in_c_stride;
+    std::size_t wei_k_stride;
+    std::size_t wei_c_stride;
+    std::size_t out_n_stride;
+    std::size_t out_k_stride;
+    std::array<std::size_t, ConvDim> in_spatial_strides{};
+    std::array<std::size_t, ConvDim> wei_spatial_strides{};
+    std::array<std::size_t, ConvDim> out_spatial_strides{};
+
+    template <typename Tin, typename Twei, typename Tout, typename Range>
+    cpu_conv_geometry(const tensor<Tin>& in,
+                      const tensor<Twei>& wei,
+                      const tensor<Tout>& out,
+                      const Range& pads_,
+                      const Range& strides_,
+                      const Range& dilations_,
+                      std::size_t group_count_)
+        : batch_len(out.desc.GetLengths()[0]),
+          group_count(group_count_),
+          k_per_group(wei.desc.GetLengths()[0] / group_count_),
+          c_per_group(wei.desc.GetLengths()[1]),
+          in_n_stride(in.desc.GetStrides()[0]),
+          in_c_stride(in.desc.GetStrides()[1]),
+          wei_k_stride(wei.desc.GetStrides()[0]),
+          wei_c_stride(wei.desc.GetStrides()[1]),
+          out_n_stride(out.desc.GetStrides()[0]),
+          out_k_stride(out.desc.GetStrides()[1])
+    {
+        std::copy_n(in.desc.GetLengths().begin() + 2, ConvDim, in_spatial_len.begin());
+        std::copy_n(wei.desc.GetLengths().begin() + 2, ConvDim, wei_spatial_len.begin());
+        std::copy_n(out.desc.GetLengths().begin() + 2, ConvDim, out_spatial_len.begin());
+        std::copy_n(in.desc.GetStrides().begin() + 2, ConvDim, in_spatial_strides.begin());
+        std::copy_n(wei.desc.GetStrides().begin() + 2, ConvDim, wei_spatial_strides.begin());
+        std::copy_n(out.desc.GetStrides().begin() + 2, ConvDim, out_spatial_strides.begin());
+        std::copy_n(pads_.begin(), ConvDim, pads.begin());
+        std::copy_n(strides_.begin(), ConvDim, strides.begin());
+        std::copy_n(dilations_.begin(), ConvDim, dilations.begin());
+
+        in_spatial_size  = product(in_spatial_len);
+        wei_spatial_size = product(wei_spatial_len);
+        out_spatial_size = product(out_spatial_len);
+    }
+
+    /// Splits a linear spatial index, the last dimension being the fastest one.
+    static spatial_ids unflatten(std::size_t id, const std::array<std::size_t, ConvDim>& lens)
+    {
+        spatial_ids ids{};
+        for(std::size_t i = ConvDim; i-- > 0;)
+        {
+            ids[i] = id % lens[i];
+            id /= lens[i];
+        }
+        return ids;
+    }
+
+    static std::size_t offset(const spatial_ids& ids,
+                              const std::array<std::size_t, ConvDim>& strides_)
+    {
+        std::size_t result = 0;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+            result += ids[i] * strides_[i];
+        return result;
+    }
+
+    /// Offset of the input element read by a filter tap for an output element, -1 for padding.
+    std::ptrdiff_t in_offset(const spatial_ids& out_id, const spatial_ids& wei_id) const
+    {
+        std::ptrdiff_t result = 0;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            const auto in_id = out_id[i] * strides[i] + wei_id[i] * dilations[i] - pads[i];
+            if(in_id < 0 || in_id >= static_cast<std::ptrdiff_t>(in_spatial_len[i]))
+                return -1;
+            result += in_id * in_spatial_strides[i];
+        }
+        return result;
+    }
+
+    /// Offset of the output element that a filter tap maps an input element to, -1 if none.
+    std::ptrdiff_t out_offset(const spatial_ids& in_id, const spatial_ids& wei_id) const
+    {
+        std::ptrdiff_t result = 0;
+        for(std::size_t i = 0; i < ConvDim; ++i)
+        {
+            const auto out_id_ = pads[i] + in_id[i] - wei_id[i] * dilations[i];
+            const auto out_id  = out_id_ / strides[i];
+            if(out_id_ < 0 || out_id_ % strides[i] != 0 ||
+               out_id >= static_cast<std::ptrdiff_t>(out_spatial_len[i]))
+                return -1;
+            result += out_id * out_spatial_strides[i];
+        }
+        return result;
+    }
+
+    private:
+    static std::size_t product(const std::array<std::size_t, ConvDim>& lens)
+    {
+        return std::accumulate(
+            lens.begin(), lens.end(), std::size_t{1}, std::multiplies<std::size_t>());
+    }
+};
+
+/// Tiles of the GEMM based implementations: columns of the matrices built from the tensors and
+/// rows of the result computed by a task.
+static constexpr std::size_t cpu_conv_tile_cols = 64;
+static constexpr std::size_t cpu_conv_tile_rows = 64;
+
+/// c[i][j] += sum(a[i][r] * b[r][j]) for r in [0, depth). Every element is accumulated in the
+/// order of r, as the direct implementations do, so results match them. The innermost loop
+/// runs over contiguous j, so it vectorizes without reordering the sums.
+inline void cpu_conv_gemm(std::size_t rows,
+                          std::size_t depth,
+                          std::size_t cols,
+                          const double* a,
+                          std::size_t lda,
+                          const double* b,
+                          std::size_t ldb,
+                          double* c,
+                          std::size_t ldc)
+{
+    constexpr std::size_t depth_block = 256;
+
+    for(std::size_t r0 = 0; r0 < depth; r0 += depth_block)
+    {
+        const auto r1 = std::min(depth, r0 + depth_block);
+        std::size_t i = 0;
+
+        for(; i + 4 <= rows; i += 4)
+        {
+            double* c0 = c + i * ldc;
+            double* c1 = c0 + ldc;
+            double* c2 = c1 + ldc;
+            double* c3 = c2 + ldc;
+
+            for(auto r = r0; r < r1; ++r)
+            {
+                const double* br = b + r * ldb;
+                const auto a0    = a[i * lda + r];
+                const auto a1    = a[(i + 1) * lda + r];
+                const auto a2    = a[(i + 2) * lda + r];
+                const auto a3    = a[(i + 3) * lda + r];
+
+                for(std::size_t j = 0; j < cols; ++j)
+                {
+                    c0[j] += a0 * br[j];
+                    c1[j] += a1 * br[j];
+                    c2[j] += a2 * br[j];
+                    c3[j] += a3 * br[j];
+                }
+            }
+        }
+
+        for(; i < rows; ++i)
+        {
+            double* ci = c + i * ldc;
+
+            for(auto r = r0; r < r1; ++r)
+            {
+                const double* br = b + r * ldb;
+                const auto ai    = a[i * lda + r];
+
+                for(std::size_t j = 0; j < cols; ++j)
+                    ci[j] += ai * br[j];
+            }
+        }
+    }
+}
+
+static inline std::size_t cpu_conv_tiles(std::size_t size, std::size_t tile)
+{
+    return (size + tile - 1) / tile;
+}
+
+/// Implicit GEMM: out[k][o] = sum(wei[k][c, s] * in[c, s][o]) for each image and group, where
+/// in[c, s][o] is the input element read by the filter tap s for the output element o.
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_gemm_impl(const tensor<Tin>& in,
+                                       const tensor<Twei>& wei,
+                                       tensor<Tout>& out,
+                                       const Range& pads,
+                                       const Range& strides,
+                                       const Range& dilations,
+                                       std::size_t group_count)
+{
+    using geometry = cpu_conv_geometry<ConvDim>;
+    const auto g   = geometry{in, wei, out, pads, strides, dilations, group_count};
+
+    const auto filter_size = g.wei_spatial_size;
+    const auto depth       = g.c_per_group * filter_size;
+    const auto k_len       = g.k_per_group * g.group_count;
+
+    std::vector<typename geometry::spatial_ids> wei_ids(filter_size);
+    for(std::size_t s = 0; s < filter_size; ++s)
+        wei_ids[s] = geometry::unflatten(s, g.wei_spatial_len);
+
+    std::vector<double> weights(k_len * depth);
+    par_for(k_len, 1, [&](std::size_t k) {
+        for(std::size_t c = 0; c < g.c_per_group; ++c)
+            for(std::size_t s = 0; s < filter_size; ++s)
+                weights[k * depth + c * filter_size + s] = double(
+                    wei.data[k * g.wei_k_stride + c * g.wei_c_stride +
+                             geometry::offset(wei_ids[s], g.wei_spatial_strides)]);
+    });
+
+    const auto col_tiles = cpu_conv_tiles(g.out_spatial_size, cpu_conv_tile_cols);
+    const auto row_tiles = cpu_conv_tiles(g.k_per_group, cpu_conv_tile_rows);
+
+    par_for(g.batch_len * g.group_count * col_tiles * row_tiles, 1, [&](std::size_t task) {
+        const auto row_tile  = task % row_tiles;
+        const auto col_tile  = task / row_tiles % col_tiles;
+        const auto group_id  = task / row_tiles / col_tiles % g.group_count;
+        const auto out_n_id  = task / row_tiles / col_tiles / g.group_count;
+        const auto col_begin = col_tile * cpu_conv_tile_cols;
+        const auto cols      = std::min(cpu_conv_tile_cols, g.out_spatial_size - col_begin);
+        const auto row_begin = row_tile * cpu_conv_tile_rows;
+        const auto rows      = std::min(cpu_conv_tile_rows, g.k_per_group - row_begin);
+
+        std::vector<std::size_t> out_offsets(cols);
+        std::vector<std::ptrdiff_t> in_offsets(filter_size * cols);
+        for(std::size_t j = 0; j < cols; ++j)
+        {
+            const auto out_id = geometry::unflatten(col_begin + j, g.out_spatial_len);
+            out_offsets[j]    = geometry::offset(out_id, g.out_spatial_strides);
+            for(std::size_t s = 0; s < filter_size; ++s)
+                in_offsets[s * cols + j] = g.in_offset(out_id, wei_ids[s]);
+        }
+
+        std::vector<double> col(depth * cols);
+        for(std::size_t c = 0; c < g.c_per_group; ++c)
+        {
+            const auto* in_c = in.data.data() + out_n_id * g.in_n_stride +
+                               (group_id * g.c_per_group + c) * g.in_c_stride;
+
+            for(std::size_t s = 0; s < filter_size; ++s)
+            {
+                auto* col_row           = col.data() + (c * filter_size + s) * cols;
+                const auto* offsets_row = in_offsets.data() + s * cols;
+                for(std::size_t j = 0; j < cols; ++j)
+                    col_row[j] = offsets_row[j] < 0 ? 0.0 : double(in_c[offsets_row[j]]);
+            }
+        }
+
+        const auto k_begin = group_id * g.k_per_group + row_begin;
+        std::vector<double> acc(rows * cols);
+        cpu_conv_gemm(rows,
+                      depth,
+                      cols,
+                      weights.data() + k_begin * depth,
+                      depth,
+                      col.data(),
+                      cols,
+                      acc.data(),
+                      cols);
+
+        for(std::size_t k = 0; k < rows; ++k)
+        {
+            auto* out_k =
+                out.data.data() + out_n_id * g.out_n_stride + (k_begin + k) * g.out_k_stride;
+            for(std::size_t j = 0; j < cols; ++j)
+                out_k[out_offsets[j]] = acc[k * cols + j];
+        }
+    });
+}
+
+/// Gathers instead of scattering, so tasks write disjoint parts of the input:
+/// in[c][i] = sum(wei[k, s][c] * out[k, s][i]) for each image and group, where out[k, s][i] is
+/// the output element the filter tap s maps the input element i to.
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_data_gemm_impl(tensor<Tin>& in,
+                                             const tensor<Twei>& wei,
+                                             const tensor<Tout>& out,
+                                             const Range& pads,
+                                             const Range& strides,
+                                             const Range& dilations,
+                                             std::size_t group_count)
+{
+    using geometry = cpu_conv_geometry<ConvDim>;
+    const auto g   = geometry{in, wei, out, pads, strides, dilations, group_count};
+
+    const auto filter_size = g.wei_spatial_size;
+    const auto depth       = g.k_per_group * filter_size;
+    const auto c_len       = g.c_per_group * g.group_count;
+
+    std::vector<typename geometry::spatial_ids> wei_ids(filter_size);
+    for(std::size_t s = 0; s < filter_size; ++s)
+        wei_ids[s] = geometry::unflatten(s, g.wei_spatial_len);
+
+    // Rows are the input channels of all the groups, one after another.
+    std::vector<double> weights(c_len * depth);
+    par_for(c_len, 1, [&](std::size_t in_c_id) {
+        const auto group_id = in_c_id / g.c_per_group;
+        const auto wei_c_id = in_c_id % g.c_per_group;
+        for(std::size_t k = 0; k < g.k_per_group; ++k)
+            for(std::size_t s = 0; s < filter_size; ++s)
+                weights[in_c_id * depth + k * filter_size + s] =
+                    double(wei.data[(group_id * g.k_per_group + k) * g.wei_k_stride +
+                                    wei_c_id * g.wei_c_stride +
+                                    geometry::offset(wei_ids[s], g.wei_spatial_strides)]);
+    });
+
+    const auto col_tiles = cpu_conv_tiles(g.in_spatial_size, cpu_conv_tile_cols);
+    const auto row_tiles = cpu_conv_tiles(g.c_per_group, cpu_conv_tile_rows);
+
+    par_for(g.batch_len * g.group_count * col_tiles * row_tiles, 1, [&](std::size_t task) {
+        const auto row_tile  = task % row_tiles;
+        const auto col_tile  = task / row_tiles % col_tiles;
+        const auto group_id  = task / row_tiles / col_tiles % g.group_count;
+        const auto in_n_id   = task / row_tiles / col_tiles / g.group_count;
+        const auto col_begin = col_tile * cpu_conv_tile_cols;
+        const auto cols      = std::min(cpu_conv_tile_cols, g.in_spatial_size - col_begin);
+        const auto row_begin = row_tile * cpu_conv_tile_rows;
+        const auto rows      = std::min(cpu_conv_tile_rows, g.c_per_group - row_begin);
+
+        std::vector<std::size_t> in_offsets(cols);
+        std::vector<std::ptrdiff_t> out_offsets(filter_size * cols);
+        for(std::size_t j = 0; j < cols; ++j)
+        {
+            const auto in_id = geometry::unflatten(col_begin + j, g.in_spatial_len);
+            in_offsets[j]    = geometry::offset(in_id, g.in_spatial_strides);
+            for(std::size_t s = 0; s < filter_size; ++s)
+                out_offsets[s * cols + j] = g.out_offset(in_id, wei_ids[s]);
+        }
+
+        std::vector<double> col(depth * cols);
+        for(std::size_t k = 0; k < g.k_per_group; ++k)
+        {
+            const auto* out_k = out.data.data() + in_n_id * g.out_n_stride +
+                                (group_id * g.k_per_group + k) * g.out_k_stride;
+
+            for(std::size_t s = 0; s < filter_size; ++s)
+            {
+                auto* col_row           = col.data() + (k * filter_size + s) * cols;
+                const auto* offsets_row = out_offsets.data() + s * cols;
+                for(std::size_t j = 0; j < cols; ++j)
+                    col_row[j] = offsets_row[j] < 0 ? 0.0 : double(out_k[offsets_row[j]]);
+            }
+        }
+
+        const auto c_begin = group_id * g.c_per_group + row_begin;
+        std::vector<double> acc(rows * cols);
+        cpu_conv_gemm(rows,
+                      depth,
+                      cols,
+                      weights.data() + c_begin * depth,
+                      depth,
+                      col.data(),
+                      cols,
+                      acc.data(),
+                      cols);
+
+        for(std::size_t c = 0; c < rows; ++c)
+        {
+            auto* in_c = in.data.data() + in_n_id * g.in_n_stride + (c_begin + c) * g.in_c_stride;
+            for(std::size_t j = 0; j < cols; ++j)
+                in_c[in_offsets[j]] = acc[c * cols + j];
+        }
+    });
+}
+
+/// wei[k][c, s] = sum(out[k][n, o] * in[n, o][c, s]) for each group, where in[n, o][c, s] is
+/// the input element read by the filter tap s for the output element o of the image n.
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_weight_gemm_impl(const tensor<Tin>& in,
+                                               tensor<Twei>& wei,
+                                               const tensor<Tout>& out,
+                                               const Range& pads,
+                                               const Range& strides,
+                                               const Range& dilations,
+                                               std::size_t group_count)
+{
+    using geometry = cpu_conv_geometry<ConvDim>;
+    const auto g   = geometry{in, wei, out, pads, strides, dilations, group_count};
+
+    const auto filter_size = g.wei_spatial_size;
+    const auto width       = g.c_per_group * filter_size;
+    const auto depth       = g.batch_len * g.out_spatial_size;
+
+    std::vector<typename geometry::spatial_ids> wei_ids(filter_size);
+    for(std::size_t s = 0; s < filter_size; ++s)
+        wei_ids[s] = geometry::unflatten(s, g.wei_spatial_len);
+
+    const auto col_tiles = cpu_conv_tiles(width, cpu_conv_tile_cols);
+    const auto row_tiles = cpu_conv_tiles(g.k_per_group, cpu_conv_tile_rows);
+
+    par_for(g.group_count * col_tiles * row_tiles, 1, [&](std::size_t task) {
+        const auto row_tile  = task % row_tiles;
+        const auto col_tile  = task / row_tiles % col_tiles;
+        const auto group_id  = task / row_tiles / col_tiles;
+        const auto col_begin = col_tile * cpu_conv_tile_cols;
+        const auto cols      = std::min(cpu_conv_tile_cols, width - col_begin);
+        const auto row_begin = row_tile * cpu_conv_tile_rows;
+        const auto rows      = std::min(cpu_conv_tile_rows, g.k_per_group - row_begin);
+        const auto k_begin   = group_id * g.k_per_group + row_begin;
+
+        std::vector<std::size_t> in_c_offsets(cols);
+        for(std::size_t j = 0; j < cols; ++j)
+        {
+            const auto c    = (col_begin + j) / filter_size;
+            in_c_offsets[j] = (group_id * g.c_per_group + c) * g.in_c_stride;
+        }
+
+        // The reduction over images and output elements goes in slices, in order.
+        constexpr std::size_t slice = 64;
+        std::vector<double> out_slice(rows * slice);
+        std::vector<double> col(slice * cols);
+        std::vector<double> acc(rows * cols);
+
+        for(std::size_t r0 = 0; r0 < depth; r0 += slice)
+        {
+            const auto slice_len = std::min(slice, depth - r0);
+
+            for(std::size_t r = 0; r < slice_len; ++r)
+            {
+                const auto out_n_id   = (r0 + r) / g.out_spatial_size;
+                const auto out_id     = geometry::unflatten((r0 + r) % g.out_spatial_size,
+                                                            g.out_spatial_len);
+                const auto out_offset = out_n_id * g.out_n_stride +
+                                        geometry::offset(out_id, g.out_spatial_strides);
+
+                for(std::size_t k = 0; k < rows; ++k)
+                    out_slice[k * slice + r] =
+                        double(out.data[out_offset + (k_begin + k) * g.out_k_stride]);
+
+                auto* col_row = col.data() + r * cols;
+                for(std::size_t j = 0; j < cols; ++j)
+                {
+                    const auto s         = (col_begin + j) % filter_size;
+                    const auto in_offset = g.in_offset(out_id, wei_ids[s]);
+                    col_row[j]           = in_offset < 0
+                                     ? 0.0
+                                     : double(in.data[out_n_id * g.in_n_stride + in_c_offsets[j] +
+                                                      in_offset]);
+                }
+            }
+
+            cpu_conv_gemm(rows,
+                          slice_len,
+                          cols,
+                          out_slice.data(),
+                          slice,
+                          col.data(),
+                          cols,
+                          acc.data(),
+                          cols);
+        }
+
+        for(std::size_t k = 0; k < rows; ++k)
+        {
+            for(std::size_t j = 0; j < cols; ++j)
+            {
+                const auto c = (col_begin + j) / filter_size;
+                const auto s = (col_begin + j) % filter_size;
+                wei.data[(k_begin + k) * g.wei_k_stride + c * g.wei_c_stride +
+                         geometry::offset(wei_ids[s], g.wei_spatial_strides)] = acc[k * cols + j];
+            }
+        }
+    });
+}
+
+/// Host Winograd F(4x4, 3x3). Every 4x4 tile of the result is A^T[(G w G^T) * (B^T x B)]A, where
+/// x is the 6x6 tile of the source it depends on, and the sums over channels of the products of
+/// the transformed tiles are 36 GEMMs.
+struct cpu_conv_winograd
+{
+    static constexpr std::size_t tile_len    = 4;
+    static constexpr std::size_t in_tile_len = 6;
+    static constexpr std::size_t points      = in_tile_len * in_tile_len;
+    /// Tiles transformed and multiplied by a single task.
+    static constexpr std::size_t tiles_per_task = 32;
+
+    /// y[n][k][p][q] = sum(x[n][c][p + r - pad_h][q + s - pad_w] * w[k][c][r][s]), with x read
+    /// as zero outside of it. The filters are given as w[k][c][3 * r + s], x_at(n, c, i, j)
+    /// reads x and y_set(n, k, p, q, value) stores y.
+    template <class XAt, class YSet>
+    static void run(std::size_t batch_len,
+                    std::size_t x_channels,
+                    std::size_t y_channels,
+                    std::array<std::size_t, 2> x_len,
+                    std::array<std::size_t, 2> y_len,
+                    std::array<std::ptrdiff_t, 2> pads,
+                    const std::vector<double>& filters,
+                    XAt x_at,
+                    YSet y_set)
+    {
+        // Transformed filters, as u[point][k][c].
+        std::vector<double> u(points * y_channels * x_channels);
+        par_for(y_channels, 1, [&](std::size_t k) {
+            for(std::size_t c = 0; c < x_channels; ++c)
+            {
+                double transformed[points];
+                transform_filter(filters.data() + (k * x_channels + c) * 9, transformed);
+                for(std::size_t point = 0; point < points; ++point)
+                    u[(point * y_channels + k) * x_channels + c] = transformed[point];
+            }
+        });
+
+        const auto tiles_h = cpu_conv_tiles(y_len[0], tile_len);
+        const auto tiles_w = cpu_conv_tiles(y_len[1], tile_len);
+        const auto tiles   = batch_len * tiles_h * tiles_w;
+
+        par_for(cpu_conv_tiles(tiles, tiles_per_task), 1, [&](std::size_t task) {
+            const auto tile_begin = task * tiles_per_task;
+            const auto count      = std::min(tiles_per_task, tiles - tile_begin);
+
+            // Transformed source tiles, as v[point][c][tile].
+            std::vector<double> v(points * x_channels * count);
+            for(std::size_t t = 0; t < count; ++t)
+            {
+                const auto id = tile_begin + t;
+                const auto n  = id / (tiles_h * tiles_w);
+                const auto i0 = static_cast<std::ptrdiff_t>(id / tiles_w % tiles_h * tile_len) -
+                                pads[0];
+                const auto j0 =
+                    static_cast<std::ptrdiff_t>(id % tiles_w * tile_len) - pads[1];
+
+                for(std::size_t c = 0; c < x_channels; ++c)
+                {
+                    double x[in_tile_len][in_tile_len];
+                    for(std::size_t i = 0; i < in_tile_len; ++i)
+                    {
+                        for(std::size_t j = 0; j < in_tile_len; ++j)
+                        {
+                            const auto x_i = i0 + static_cast<std::ptrdiff_t>(i);
+                            const auto x_j = j0 + static_cast<std::ptrdiff_t>(j);
+                            const auto inside =
+                                x_i >= 0 && x_i < static_cast<std::ptrdiff_t>(x_len[0]) &&
+                                x_j >= 0 && x_j < static_cast<std::ptrdiff_t>(x_len[1]);
+                            x[i][j] = inside ? x_at(n, c, x_i, x_j) : 0.0;
+                        }
+                    }
+
+                    double transformed[points];
+                    transform_input(x, transformed);
+                    for(std::size_t point = 0; point < points; ++point)
+                        v[(point * x_channels + c) * count + t] = transformed[point];
+                }
+            }
+
+            std::vector<double> m(points * y_channels * count);
+            for(std::size_t point = 0; point < points; ++point)
+            {
+                cpu_conv_gemm(y_channels,
+                              x_channels,
+                              count,
+                              u.data() + point * y_channels * x_channels,
+                              x_channels,
+                              v.data() + point * x_channels * count,
+                              count,
+                              m.data() + point * y_channels * count,
+                              count);
+            }
+
+            for(std::size_t t = 0; t < count; ++t)
+            {
+                const auto id = tile_begin + t;
+                const auto n  = id / (tiles_h * tiles_w);
+                const auto p0 = id / tiles_w % tiles_h * tile_len;
+                const auto q0 = id % tiles_w * tile_len;
+
+                for(std::size_t k = 0; k < y_channels; ++k)
+                {
+                    double products[points];
+                    for(std::size_t point = 0; point < points; ++point)
+                        products[point] = m[(point * y_channels + k) * count + t];
+
+                    double y[tile_len][tile_len];
+                    transform_output(products, y);
+
+                    for(std::size_t p = 0; p < tile_len && p0 + p < y_len[0]; ++p)
+                        for(std::size_t q = 0; q < tile_len && q0 + q < y_len[1]; ++q)
+                            y_set(n, k, p0 + p, q0 + q, y[p][q]);
+                }
+            }
+        });
+    }
+
+    private:
+    /// u = G w G^T
+    static void transform_filter(const double* w, double* u)
+    {
+        static constexpr double g[in_tile_len][3] = {{1. / 4, 0, 0},
+                                                     {-1. / 6, -1. / 6, -1. / 6},
+                                                     {-1. / 6, 1. / 6, -1. / 6},
+                                                     {1. / 24, 1. / 12, 1. / 6},
+                                                     {1. / 24, -1. / 12, 1. / 6},
+                                                     {0, 0, 1}};
+        double gw[in_tile_len][3];
+        for(std::size_t i = 0; i < in_tile_len; ++i)
+            for(std::size_t j = 0; j < 3; ++j)
+                gw[i][j] = g[i][0] * w[j] + g[i][1] * w[3 + j] + g[i][2] * w[6 + j];
+
+        for(std::size_t i = 0; i < in_tile_len; ++i)
+            for(std::size_t j = 0; j < in_tile_len; ++j)
+                u[i * in_tile_len + j] =
+                    gw[i][0] * g[j][0] + gw[i][1] * g[j][1] + gw[i][2] * g[j][2];
+    }
+
+    /// v = B^T x B
+    static void transform_input(const double (&x)[in_tile_len][in_tile_len], double* v)
+    {
+        static constexpr double bt[in_tile_len][in_tile_len] = {{4, 0, -5, 0, 1, 0},
+                                                                {0, -4, -4, 1, 1, 0},
+                                                                {0, 4, -4, -1, 1, 0},
+                                                                {0, -2, -1, 2, 1, 0},
+                                                                {0, 2, -1, -2, 1, 0},
+                                                                {0, 4, 0, -5, 0, 1}};
+        double btx[in_tile_len][in_tile_len];
+        for(std::size_t i = 0; i < in_tile_len; ++i)
+        {
+            for(std::size_t j = 0; j < in_tile_len; ++j)
+            {
+                btx[i][j] = 0;
+                for(std::size_t r = 0; r < in_tile_len; ++r)
+                    btx[i][j] += bt[i][r] * x[r][j];
+            }
+        }
+
+        for(std::size_t i = 0; i < in_tile_len; ++i)
+        {
+            for(std::size_t j = 0; j < in_tile_len; ++j)
+            {
+                auto sum = 0.0;
+                for(std::size_t r = 0; r < in_tile_len; ++r)
+                    sum += btx[i][r] * bt[j][r];
+                v[i * in_tile_len + j] = sum;
+            }
+        }
+    }
+
+    /// y = A^T m A
+    static void transform_output(const double* m, double (&y)[tile_len][tile_len])
+    {
+        static constexpr double at[tile_len][in_tile_len] = {{1, 1, 1, 1, 1, 0},
+                                                             {0, 1, -1, 2, -2, 0},
+                                                             {0, 1, 1, 4, 4, 0},
+                                                             {0, 1, -1, 8, -8, 1}};
+        double atm[tile_len][in_tile_len];
+        for(std::size_t i = 0; i < tile_len; ++i)
+        {
+            for(std::size_t j = 0; j < in_tile_len; ++j)
+            {
+                atm[i][j] = 0;
+                for(std::size_t r = 0; r < in_tile_len; ++r)
+                    atm[i][j] += at[i][r] * m[r * in_tile_len + j];
+            }
+        }
+
+        for(std::size_t i = 0; i < tile_len; ++i)
+        {
+            for(std::size_t j = 0; j < tile_len; ++j)
+            {
+                y[i][j] = 0;
+                for(std::size_t r = 0; r < in_tile_len; ++r)
+                    y[i][j] += atm[i][r] * at[j][r];
+            }
+        }
+    }
+};
+
+template <typename Tin, typename Twei, typename Tout>
+void cpu_convolution_forward_winograd_impl(const tensor<Tin>& in,
+                                           const tensor<Twei>& wei,
+                                           tensor<Tout>& out,
+                                           const cpu_conv_geometry<2>& g)
+{
+    const auto& in_str  = g.in_spatial_strides;
+    const auto& wei_str = g.wei_spatial_strides;
+    const auto& out_str = g.out_spatial_strides;
+
+    for(std::size_t group_id = 0; group_id < g.group_count; ++group_id)
+    {
+        const auto c_begin = group_id * g.c_per_group;
+        const auto k_begin = group_id * g.k_per_group;
+
+        std::vector<double> filters(g.k_per_group * g.c_per_group * 9);
+        for(std::size_t k = 0; k < g.k_per_group; ++k)
+            for(std::size_t c = 0; c < g.c_per_group; ++c)
+                for(std::size_t r = 0; r < 3; ++r)
+                    for(std::size_t s = 0; s < 3; ++s)
+                        filters[(k * g.c_per_group + c) * 9 + r * 3 + s] =
+                            double(wei.data[(k_begin + k) * g.wei_k_stride + c * g.wei_c_stride +
+                                            r * wei_str[0] + s * wei_str[1]]);
+
+        cpu_conv_winograd::run(
+            g.batch_len,
+            g.c_per_group,
+            g.k_per_group,
+            {g.in_spatial_len[0], g.in_spatial_len[1]},
+            {g.out_spatial_len[0], g.out_spatial_len[1]},
+            {g.pads[0], g.pads[1]},
+            filters,
+            [&](std::size_t n, std::size_t c, std::size_t i, std::size_t j) {
+                return double(in.data[n * g.in_n_stride + (c_begin + c) * g.in_c_stride +
+                                      i * in_str[0] + j * in_str[1]]);
+            },
+            [&](std::size_t n, std::size_t k, std::size_t p, std::size_t q, double value) {
+                out.data[n * g.out_n_stride + (k_begin + k) * g.out_k_stride + p * out_str[0] +
+                         q * out_str[1]] = value;
+            });
+    }
+}
+
+/// With unit strides, the backward pass is a forward one over the output, with the filters
+/// rotated by 180 degrees and the roles of their channels swapped.
+template <typename Tin, typename Twei, typename Tout>
+void cpu_convolution_backward_data_winograd_impl(tensor<Tin>& in,
+                                                 const tensor<Twei>& wei,
+                                                 const tensor<Tout>& out,
+                                                 const cpu_conv_geometry<2>& g)
+{
+    const auto& in_str  = g.in_spatial_strides;
+    const auto& wei_str = g.wei_spatial_strides;
+    const auto& out_str = g.out_spatial_strides;
+
+    for(std::size_t group_id = 0; group_id < g.group_count; ++group_id)
+    {
+        const auto c_begin = group_id * g.c_per_group;
+        const auto k_begin = group_id * g.k_per_group;
+
+        std::vector<double> filters(g.c_per_group * g.k_per_group * 9);
+        for(std::size_t c = 0; c < g.c_per_group; ++c)
+            for(std::size_t k = 0; k < g.k_per_group; ++k)
+                for(std::size_t r = 0; r < 3; ++r)
+                    for(std::size_t s = 0; s < 3; ++s)
+                        filters[(c * g.k_per_group + k) * 9 + r * 3 + s] =
+                            double(wei.data[(k_begin + k) * g.wei_k_stride + c * g.wei_c_stride +
+                                            (2 - r) * wei_str[0] + (2 - s) * wei_str[1]]);
+
+        cpu_conv_winograd::run(
+            g.batch_len,
+            g.k_per_group,
+            g.c_per_group,
+            {g.out_spatial_len[0], g.out_spatial_len[1]},
+            {g.in_spatial_len[0], g.in_spatial_len[1]},
+            {2 - g.pads[0], 2 - g.pads[1]},
+            filters,
+            [&](std::size_t n, std::size_t k, std::size_t i, std::size_t j) {
+                return double(out.data[n * g.out_n_stride + (k_begin + k) * g.out_k_stride +
+                                       i * out_str[0] + j * out_str[1]]);
+            },
+            [&](std::size_t n, std::size_t c, std::size_t p, std::size_t q, double value) {
+                in.data[n * g.in_n_stride + (c_begin + c) * g.in_c_stride + p * in_str[0] +
+                        q * in_str[1]] = value;
+            });
+    }
+}
+
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout>
+void cpu_convolution_forward_winograd_impl(const tensor<Tin>&,
+                                           const tensor<Twei>&,
+                                           tensor<Tout>&,
+                                           const cpu_conv_geometry<ConvDim>&)
+{
+    MIOPEN_THROW("Host Winograd supports 2D convolutions only");
+}
+
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout>
+void cpu_convolution_backward_data_winograd_impl(tensor<Tin>&,
+                                                 const tensor<Twei>&,
+                                                 const tensor<Tout>&,
+                                                 const cpu_conv_geometry<ConvDim>&)
+{
+    MIOPEN_THROW("Host Winograd supports 2D convolutions only");
+}
+
+enum class cpu_conv_algo
+{
+    direct,
+    gemm,
+    winograd,
+};
+
+enum class cpu_conv_direction
+{
+    forward,
+    backward_data,
+    backward_weights,
+};
+
+/// Winograd is used for 2D 3x3 filters with unit strides and dilations, when there are enough
+/// channels for its GEMMs. The backward data pass also needs the padding not to exceed the
+/// filter, so that the padding of the equivalent forward pass is not negative.
+template <typename Range>
+bool cpu_convolution_winograd_applicable(cpu_conv_direction direction,
+                                         const miopen::TensorDescriptor& wei_desc,
+                                         const Range& pads,
+                                         const Range& strides,
+                                         const Range& dilations)
+{
+    const auto& lens = wei_desc.GetLengths();
+    if(direction == cpu_conv_direction::backward_weights || lens.size() != 4 || lens[2] != 3 ||
+       lens[3] != 3)
+        return false;
+
+    for(std::size_t i = 0; i < 2; ++i)
+    {
+        if(strides[i] != 1 || dilations[i] != 1)
+            return false;
+        if(direction == cpu_conv_direction::backward_data && pads[i] > 2)
+            return false;
+    }
+
+    return true;
+}
+
+/// The algorithm used for the host reference: MIOPEN_DEBUG_CPU_CONV_ALGO=direct|gemm|winograd
+/// forces it when applicable. Otherwise Winograd is chosen where it applies and there are
+/// enough channels for its GEMMs to dominate the transforms, and GEMM everywhere else.
+/// The variable is read on each call, so that a test can compare the algorithms.
+template <typename Range>
+cpu_conv_algo cpu_convolution_algo(cpu_conv_direction direction,
+                                   const miopen::TensorDescriptor& wei_desc,
+                                   const Range& pads,
+                                   const Range& strides,
+                                   const Range& dilations,
+                                   std::size_t group_count)
+{
+    const auto winograd =
+        cpu_convolution_winograd_applicable(direction, wei_desc, pads, strides, dilations);
+    const auto forced = miopen::GetEnv(MIOPEN_DEBUG_CPU_CONV_ALGO::value());
+
+    if(!forced.empty())
+    {
+        const auto& name = forced.front();
+        if(name == "direct")
+            return cpu_conv_algo::direct;
+        if(name == "gemm")
+            return cpu_conv_algo::gemm;
+        if(name == "winograd" && winograd)
+            return cpu_conv_algo::winograd;
+    }
+
+    const auto k_per_group = wei_desc.GetLengths()[0] / group_count;
+    const auto c_per_group = wei_desc.GetLengths()[1];
+    return winograd && k_per_group >= 8 && c_per_group >= 8 ? cpu_conv_algo::winograd
+                                                            : cpu_conv_algo::gemm;
+}
+
+/// Relative RMS error the host result may have before it is rounded to the output type. Direct
+/// and GEMM sum the same products in the same order, and Winograd loses a few bits of double
+/// precision in its transforms, so this only matters for checks tighter than the data types.
+inline double cpu_convolution_reference_error(cpu_conv_algo algo)
+{
+    switch(algo)
+    {
+    case cpu_conv_algo::direct:
+    case cpu_conv_algo::gemm: return 0;
+    case cpu_conv_algo::winograd: return 1e-13;
+    }
+    return 0;
+}
+
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_forward_impl(const tensor<Tin>& in,
+                                  const tensor<Twei>& wei,
+                                  tensor<Tout>& out,
+                                  const Range& pads,
+                                  const Range& strides,
+                                  const Range& dilations,
+                                  std::size_t group_count)
+{
+    switch(cpu_convolution_algo(
+        cpu_conv_direction::forward, wei.desc, pads, strides, dilations, group_count))
+    {
+    case cpu_conv_algo::direct:
+        cpu_convolution_forward_direct_impl<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+        break;
+    case cpu_conv_algo::gemm:
+        cpu_convolution_forward_gemm_impl<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+        break;
+    case cpu_conv_algo::winograd:
+        cpu_convolution_forward_winograd_impl(
+            in,
+            wei,
+            out,
+            cpu_conv_geometry<ConvDim>{in, wei, out, pads, strides, dilations, group_count});
+        break;
+    }
+}
+
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_data_impl(tensor<Tin>& in,
+                                        const tensor<Twei>& wei,
+                                        const tensor<Tout>& out,
+                                        const Range& pads,
+                                        const Range& strides,
+                                        const Range& dilations,
+                                        std::size_t group_count)
+{
+    switch(cpu_convolution_algo(
+        cpu_conv_direction::backward_data, wei.desc, pads, strides, dilations, group_count))
+    {
+    case cpu_conv_algo::direct:
+        cpu_convolution_backward_data_direct_impl<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+        break;
+    case cpu_conv_algo::gemm:
+        cpu_convolution_backward_data_gemm_impl<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+        break;
+    case cpu_conv_algo::winograd:
+        cpu_convolution_backward_data_winograd_impl(
+            in,
+            wei,
+            out,
+            cpu_conv_geometry<ConvDim>{in, wei, out, pads, strides, dilations, group_count});
+        break;
+    }
+}
+
+template <std::size_t ConvDim, typename Tin, typename Twei, typename Tout, typename Range>
+void cpu_convolution_backward_weight_impl(const tensor<Tin>& in,
+                                          tensor<Twei>& wei,
+                                          const tensor<Tout>& out,
+                                          const Range& pads,
+                                          const Range& strides,
+                                          const Range& dilations,
+                                          std::size_t group_count)
+{
+    if(cpu_convolution_algo(cpu_conv_direction::backward_weights,
+                            wei.desc,
+                            pads,
+                            strides,
+                            dilations,
+                            group_count) == cpu_conv_algo::direct)
+        cpu_convolution_backward_weight_direct_impl<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+    else
+        cpu_convolution_backward_weight_gemm_impl<ConvDim>(
+            in, wei, out, pads, strides, dilations, group_count);
+}
+
 template <typename Tin, typename Twei, typename Tout, typename Range>
 void cpu_convolution_forward(std::size_t spatial_dim,
                              const tensor<Tin>& in,
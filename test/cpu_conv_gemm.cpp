@@ -0,0 +1,118 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "serialize.hpp"
+#include "cpu_conv.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Case
+{
+    std::vector<std::size_t> in_lens;
+    std::vector<std::size_t> wei_lens;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    std::size_t group_count;
+};
+
+std::vector<std::size_t> out_lens(const Case& p)
+{
+    auto lens = std::vector<std::size_t>{p.in_lens[0], p.wei_lens[0]};
+    for(std::size_t i = 0; i < p.pads.size(); ++i)
+    {
+        const auto in     = static_cast<int>(p.in_lens[i + 2]) + 2 * p.pads[i];
+        const auto filter = p.dilations[i] * (static_cast<int>(p.wei_lens[i + 2]) - 1) + 1;
+        lens.push_back((in - filter) / p.strides[i] + 1);
+    }
+    return lens;
+}
+
+template <class T>
+tensor<T> make_random(const std::vector<std::size_t>& lens, std::mt19937& gen)
+{
+    std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+    auto t = tensor<T>{lens};
+    for(auto& x : t.data)
+        x = dist(gen);
+    return t;
+}
+
+/// The implicit GEMMs sum the same products in the same order as the direct loops, so the
+/// results must match exactly.
+template <std::size_t ConvDim>
+void check(const Case& p)
+{
+    std::mt19937 gen{static_cast<unsigned>(p.in_lens[1] * 31 + p.wei_lens[0] + ConvDim)};
+    const auto in  = make_random<float>(p.in_lens, gen);
+    const auto wei = make_random<float>(p.wei_lens, gen);
+    const auto out = make_random<float>(out_lens(p), gen);
+
+    auto fwd_direct = tensor<double>{out_lens(p)};
+    auto fwd_gemm   = fwd_direct;
+    cpu_convolution_forward_direct_impl<ConvDim>(
+        in, wei, fwd_direct, p.pads, p.strides, p.dilations, p.group_count);
+    cpu_convolution_forward_gemm_impl<ConvDim>(
+        in, wei, fwd_gemm, p.pads, p.strides, p.dilations, p.group_count);
+    EXPECT(fwd_direct.data == fwd_gemm.data);
+
+    auto bwd_direct = tensor<double>{p.in_lens};
+    auto bwd_gemm   = bwd_direct;
+    cpu_convolution_backward_data_direct_impl<ConvDim>(
+        bwd_direct, wei, out, p.pads, p.strides, p.dilations, p.group_count);
+    cpu_convolution_backward_data_gemm_impl<ConvDim>(
+        bwd_gemm, wei, out, p.pads, p.strides, p.dilations, p.group_count);
+    EXPECT(bwd_direct.data == bwd_gemm.data);
+
+    auto wrw_direct = tensor<double>{p.wei_lens};
+    auto wrw_gemm   = wrw_direct;
+    cpu_convolution_backward_weight_direct_impl<ConvDim>(
+        in, wrw_direct, out, p.pads, p.strides, p.dilations, p.group_count);
+    cpu_convolution_backward_weight_gemm_impl<ConvDim>(
+        in, wrw_gemm, out, p.pads, p.strides, p.dilations, p.group_count);
+    EXPECT(wrw_direct.data == wrw_gemm.data);
+}
+
+} // namespace
+
+int main()
+{
+    check<1>({{2, 4, 37}, {6, 4, 3}, {1}, {1}, {1}, 1});
+    check<1>({{1, 6, 80}, {4, 3, 5}, {2}, {3}, {2}, 2});
+
+    check<2>({{2, 3, 9, 11}, {5, 3, 3, 3}, {1, 1}, {1, 1}, {1, 1}, 1});
+    check<2>({{1, 8, 17, 13}, {12, 2, 3, 2}, {2, 0}, {2, 1}, {1, 2}, 4});
+    check<2>({{2, 6, 12, 12}, {70, 3, 1, 1}, {0, 0}, {2, 2}, {1, 1}, 2});
+    check<2>({{1, 4, 70, 9}, {4, 1, 5, 3}, {2, 1}, {1, 3}, {2, 1}, 4});
+
+    check<3>({{1, 4, 6, 7, 5}, {6, 4, 3, 3, 3}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, 1});
+    check<3>({{2, 6, 7, 6, 9}, {4, 3, 2, 3, 1}, {0, 2, 1}, {2, 1, 3}, {1, 2, 1}, 2});
+}
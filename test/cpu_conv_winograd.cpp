@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "serialize.hpp"
+#include "cpu_conv.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+#include "verify.hpp"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Case
+{
+    std::size_t n;
+    std::size_t c;
+    std::size_t k;
+    std::size_t h;
+    std::size_t w;
+    std::size_t group_count;
+    int pad;
+    bool nhwc;
+};
+
+tensor<double> make_tensor(std::size_t n, std::size_t c, std::size_t h, std::size_t w, bool nhwc)
+{
+    if(!nhwc)
+        return tensor<double>{std::vector<std::size_t>{n, c, h, w}};
+    return tensor<double>{std::vector<std::size_t>{n, c, h, w},
+                          std::vector<std::size_t>{h * w * c, 1, w * c, c}};
+}
+
+void fill(tensor<double>& t, std::mt19937& gen)
+{
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    for(auto& x : t.data)
+        x = dist(gen);
+}
+
+void set_algo(const char* algo)
+{
+    setenv("MIOPEN_DEBUG_CPU_CONV_ALGO", algo, 1); // NOLINT (concurrency-mt-unsafe)
+}
+
+void check(const Case& p)
+{
+    std::mt19937 gen{static_cast<unsigned>(p.c * 131 + p.k * 17 + p.pad * 5 + p.nhwc)};
+    const auto pads      = std::vector<int>{p.pad, p.pad};
+    const auto ones      = std::vector<int>{1, 1};
+    const auto out_h     = p.h + 2 * p.pad - 2;
+    const auto out_w     = p.w + 2 * p.pad - 2;
+    const auto tolerance = cpu_convolution_reference_error(cpu_conv_algo::winograd);
+
+    auto in  = make_tensor(p.n, p.c, p.h, p.w, p.nhwc);
+    auto wei = make_tensor(p.k, p.c / p.group_count, 3, 3, p.nhwc);
+    auto out = make_tensor(p.n, p.k, out_h, out_w, p.nhwc);
+    fill(in, gen);
+    fill(wei, gen);
+    fill(out, gen);
+
+    for(const auto direction : {cpu_conv_direction::forward, cpu_conv_direction::backward_data})
+    {
+        set_algo("winograd");
+        EXPECT(cpu_convolution_algo(direction, wei.desc, pads, ones, ones, p.group_count) ==
+               cpu_conv_algo::winograd);
+    }
+
+    auto fwd_direct = out;
+    auto fwd_wino   = out;
+    set_algo("direct");
+    cpu_convolution_forward(2, in, wei, fwd_direct, pads, ones, ones, p.group_count);
+    set_algo("winograd");
+    cpu_convolution_forward(2, in, wei, fwd_wino, pads, ones, ones, p.group_count);
+    EXPECT(miopen::rms_range(fwd_direct.data, fwd_wino.data) <= tolerance);
+
+    auto bwd_direct = in;
+    auto bwd_wino   = in;
+    set_algo("direct");
+    cpu_convolution_backward_data(2, bwd_direct, wei, out, pads, ones, ones, p.group_count);
+    set_algo("winograd");
+    cpu_convolution_backward_data(2, bwd_wino, wei, out, pads, ones, ones, p.group_count);
+    EXPECT(miopen::rms_range(bwd_direct.data, bwd_wino.data) <= tolerance);
+}
+
+} // namespace
+
+int main()
+{
+    for(const auto nhwc : {false, true})
+        for(const auto pad : {0, 1, 2})
+        {
+            check({2, 8, 8, 9, 11, 1, pad, nhwc});
+            check({1, 16, 24, 7, 6, 2, pad, nhwc});
+            check({1, 24, 16, 13, 5, 1, pad, nhwc});
+        }
+}
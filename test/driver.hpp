@@ -764,6 +764,19 @@ struct test_driver
         return adjust_parameters_impl(miopen::rank<1>{}, v);
     }
 
+    template <class V>
+    static double reference_error_impl(miopen::rank<0>, const V&)
+    {
+        return 0;
+    }
+
+    /// Error of the reference result itself, for the algorithms that have one.
+    template <class V>
+    static auto reference_error_impl(miopen::rank<1>, const V& v) -> decltype(v.reference_error())
+    {
+        return v.reference_error();
+    }
+
     template <class F, class V, class... Ts>
     auto verify_impl(F&& f, V&& v, Ts&&... xs)
         -> decltype(std::make_pair(v.cpu(xs...), v.gpu(xs...)))
@@ -869,7 +882,8 @@ struct test_driver
                 CHECK(miopen::range_distance(cpu) == miopen::range_distance(gpu));
 
                 using value_type = miopen::range_value<decltype(gpu)>;
-                double threshold = std::numeric_limits<value_type>::epsilon() * tolerance;
+                double threshold = std::numeric_limits<value_type>::epsilon() * tolerance +
+                                   reference_error_impl(miopen::rank<1>{}, v);
                 error            = {miopen::rms_range(cpu, gpu)};
                 return error.front() <= threshold;
             },
@@ -0,0 +1,273 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/fusion.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/manage_ptr.hpp>
+#include <miopen/miopen.h>
+#include <miopen/tensor.hpp>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <vector>
+
+using ptr_FusionPlanDesc = MIOPEN_MANAGE_PTR(miopenFusionPlanDescriptor_t, miopenDestroyFusionPlan);
+using ptr_FusionPlanArgs = MIOPEN_MANAGE_PTR(miopenOperatorArgs_t, miopenDestroyOperatorArgs);
+
+static std::vector<char> Bytes(const OpKernelArg& arg)
+{
+    return {arg.buffer.begin(), arg.buffer.end()};
+}
+
+static void CheckOperatorArgs()
+{
+    miopen::OperatorArgs args;
+    const auto empty = args.GetLayoutId();
+    EXPECT(args.FindSlot("a") == -1);
+
+    args.ins_arg("a", OpKernelArg(1));
+    const auto with_a = args.GetLayoutId();
+    EXPECT(with_a != empty);
+    EXPECT(args.FindSlot("a") == 0);
+
+    args.ins_arg("b", OpKernelArg(2.0f));
+    const auto with_b = args.GetLayoutId();
+    EXPECT(with_b != with_a);
+    EXPECT(args.FindSlot("a") == 0);
+    EXPECT(args.FindSlot("b") == 1);
+
+    // Setting an argument again replaces its value in the same slot.
+    args.ins_arg("a", OpKernelArg(3));
+    EXPECT(args.GetLayoutId() == with_b);
+    EXPECT(args.args_vec.size() == 2);
+    EXPECT(Bytes(args.args_vec[0]) == Bytes(OpKernelArg(3)));
+
+    // Slots bound for one object are not valid for another one with the same names.
+    miopen::OperatorArgs reversed;
+    reversed.ins_arg("b", OpKernelArg(2.0f));
+    reversed.ins_arg("a", OpKernelArg(3));
+    EXPECT(reversed.GetLayoutId() != args.GetLayoutId());
+    EXPECT(reversed.FindSlot("a") == 1);
+}
+
+static void CheckHandleIds()
+{
+    // The handles may be allocated at the same address one after another.
+    std::set<std::size_t> ids;
+    for(int i = 0; i < 3; ++i)
+    {
+        const auto handle = std::make_unique<miopen::Handle>();
+        EXPECT(handle->GetId() != 0);
+        ids.insert(handle->GetId());
+    }
+    EXPECT(ids.size() == 3);
+}
+
+struct BnActivPlan
+{
+    miopen::TensorDescriptor data_desc{miopenFloat, {2, 4, 8, 8}};
+    miopen::TensorDescriptor bn_desc{miopenFloat, {1, 4, 1, 1}};
+    ptr_FusionPlanDesc plan;
+    miopenFusionOpDescriptor_t bn_op    = nullptr;
+    miopenFusionOpDescriptor_t activ_op = nullptr;
+
+    BnActivPlan()
+    {
+        miopenFusionPlanDescriptor_t fp;
+        miopenCreateFusionPlan(&fp, miopenVerticalFusion, &data_desc);
+        plan = ptr_FusionPlanDesc{fp};
+        miopenCreateOpBatchNormInference(plan.get(), &bn_op, miopenBNSpatial, &bn_desc);
+        miopenCreateOpActivationForward(plan.get(), &activ_op, miopenActivationLEAKYRELU);
+    }
+
+    miopenStatus_t Compile(miopen::Handle& handle)
+    {
+        return miopenCompileFusionPlan(&handle, plan.get());
+    }
+
+    miopenStatus_t Execute(miopen::Handle& handle,
+                           ConstData_t in,
+                           Data_t out,
+                           miopenOperatorArgs_t args)
+    {
+        return miopenExecuteFusionPlan(&handle, plan.get(), &data_desc, in, &data_desc, out, args);
+    }
+};
+
+struct BnArgs
+{
+    ConstData_t scale;
+    ConstData_t bias;
+    ConstData_t mean;
+    ConstData_t variance;
+};
+
+static void SetArgs(miopenOperatorArgs_t args,
+                    const BnActivPlan& plan,
+                    const BnArgs& bn,
+                    double slope,
+                    bool activ_first)
+{
+    const double alpha = 1.;
+    const double beta  = 0.;
+
+    const auto set_bn = [&]() {
+        miopenSetOpArgsBatchNormInference(
+            args, plan.bn_op, &alpha, &beta, bn.scale, bn.bias, bn.mean, bn.variance, 1e-5);
+    };
+    const auto set_activ = [&]() {
+        miopenSetOpArgsActivForward(args, plan.activ_op, &alpha, &beta, slope, 0., 0.);
+    };
+
+    if(activ_first)
+    {
+        set_activ();
+        set_bn();
+    }
+    else
+    {
+        set_bn();
+        set_activ();
+    }
+}
+
+static ptr_FusionPlanArgs
+MakeArgs(const BnActivPlan& plan, const BnArgs& bn, double slope, bool activ_first)
+{
+    miopenOperatorArgs_t args;
+    miopenCreateOperatorArgs(&args);
+    auto ptr_args = ptr_FusionPlanArgs{args};
+    SetArgs(args, plan, bn, slope, activ_first);
+    return ptr_args;
+}
+
+struct BnActivData
+{
+    std::size_t size;
+    std::vector<float> input;
+    miopen::Allocator::ManageDataPtr in_dev;
+    miopen::Allocator::ManageDataPtr out_dev;
+    miopen::Allocator::ManageDataPtr ones_dev;
+    miopen::Allocator::ManageDataPtr zeros_dev;
+    miopen::Allocator::ManageDataPtr shifts_dev;
+
+    BnActivData(miopen::Handle& handle, const BnActivPlan& plan)
+        : size(plan.data_desc.GetElementSize()), input(size)
+    {
+        for(std::size_t i = 0; i < size; ++i)
+            input[i] = static_cast<float>(static_cast<int>(i % 17) - 8) / 4;
+
+        in_dev     = handle.Write(input);
+        out_dev    = handle.Write(input);
+        ones_dev   = handle.Write(std::vector<float>(4, 1.0f));
+        zeros_dev  = handle.Write(std::vector<float>(4, 0.0f));
+        shifts_dev = handle.Write(std::vector<float>{1.0f, -1.0f, 2.0f, -2.0f});
+    }
+
+    BnArgs Identity() const
+    {
+        return {ones_dev.get(), zeros_dev.get(), zeros_dev.get(), ones_dev.get()};
+    }
+
+    BnArgs Shifted() const
+    {
+        return {ones_dev.get(), shifts_dev.get(), zeros_dev.get(), ones_dev.get()};
+    }
+
+    std::vector<float> Run(miopen::Handle& handle, BnActivPlan& plan, miopenOperatorArgs_t args)
+    {
+        EXPECT(plan.Execute(handle, in_dev.get(), out_dev.get(), args) == miopenStatusSuccess);
+        return handle.Read<float>(out_dev, size);
+    }
+};
+
+static void CheckArgPlan()
+{
+    auto&& handle = get_handle();
+    BnActivPlan plan;
+
+    if(plan.Compile(handle) != miopenStatusSuccess)
+    {
+        std::cerr << "BatchNorm+Activation Inference plan not supported." << std::endl;
+        return;
+    }
+
+    BnActivData data{handle, plan};
+
+    // The two objects keep the same arguments in different slots.
+    const auto args     = MakeArgs(plan, data.Identity(), 0.5, false);
+    const auto reversed = MakeArgs(plan, data.Identity(), 0.5, true);
+    const auto expected = data.Run(handle, plan, args.get());
+    EXPECT(data.Run(handle, plan, reversed.get()) == expected);
+    EXPECT(data.Run(handle, plan, args.get()) == expected);
+
+    for(std::size_t i = 0; i < data.size; ++i)
+    {
+        const auto x = data.input[i];
+        CHECK(std::abs(expected[i] - (x < 0 ? x / 2 : x)) < 1e-3f);
+    }
+
+    // Values set again go to the slots bound before.
+    const auto shifted = MakeArgs(plan, data.Shifted(), 0.25, true);
+    const auto changed = data.Run(handle, plan, shifted.get());
+    EXPECT(changed != expected);
+    SetArgs(args.get(), plan, data.Shifted(), 0.25, false);
+    EXPECT(data.Run(handle, plan, args.get()) == changed);
+}
+
+static void CheckOtherHandle()
+{
+    BnActivPlan plan;
+    {
+        miopen::Handle compiled_for{};
+        if(plan.Compile(compiled_for) != miopenStatusSuccess)
+            return;
+    }
+
+    // This handle may take the place of the destroyed one, the plan must not use the kernel
+    // compiled for it.
+    miopen::Handle handle{};
+    BnActivData data{handle, plan};
+    const auto args = MakeArgs(plan, data.Identity(), 0.5, false);
+    EXPECT(plan.Execute(handle, data.in_dev.get(), data.out_dev.get(), args.get()) !=
+           miopenStatusSuccess);
+
+    EXPECT(plan.Compile(handle) == miopenStatusSuccess);
+    data.Run(handle, plan, args.get());
+}
+
+int main()
+{
+    CheckOperatorArgs();
+    CheckHandleIds();
+    CheckArgPlan();
+    CheckOtherHandle();
+}
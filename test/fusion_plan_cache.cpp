@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/fusion_plan.hpp>
+
+#include "test.hpp"
+
+#include <string>
+
+namespace {
+
+miopen::CompiledFusionPlan Plan(const std::string& program_name)
+{
+    miopen::CompiledFusionPlan plan;
+    plan.program_name = program_name;
+    return plan;
+}
+
+bool Has(miopen::FusionPlanCache& cache, const std::string& key)
+{
+    miopen::CompiledFusionPlan plan;
+    if(!cache.Find(key, plan))
+        return false;
+    EXPECT_EQUAL(plan.program_name, key + ".cl");
+    return true;
+}
+
+void CheckHitAndMiss()
+{
+    miopen::FusionPlanCache cache{4};
+    EXPECT(!Has(cache, "a"));
+
+    cache.Insert("a", Plan("a.cl"));
+    EXPECT(Has(cache, "a"));
+    EXPECT(!Has(cache, "b"));
+
+    // Inserting a key again replaces the plan.
+    cache.Insert("a", Plan("b.cl"));
+    miopen::CompiledFusionPlan plan;
+    EXPECT(cache.Find("a", plan));
+    EXPECT_EQUAL(plan.program_name, "b.cl");
+    EXPECT_EQUAL(cache.GetSize(), 1);
+}
+
+void CheckEviction()
+{
+    miopen::FusionPlanCache cache{2};
+    cache.Insert("a", Plan("a.cl"));
+    cache.Insert("b", Plan("b.cl"));
+
+    // Using a makes b the least recently used one.
+    EXPECT(Has(cache, "a"));
+    cache.Insert("c", Plan("c.cl"));
+    EXPECT_EQUAL(cache.GetSize(), 2);
+    EXPECT(!Has(cache, "b"));
+    EXPECT(Has(cache, "a"));
+    EXPECT(Has(cache, "c"));
+
+    for(auto i = 0; i < 100; ++i)
+        cache.Insert(std::to_string(i), Plan(std::to_string(i) + ".cl"));
+    EXPECT_EQUAL(cache.GetSize(), 2);
+    EXPECT(Has(cache, "98"));
+    EXPECT(Has(cache, "99"));
+}
+
+void CheckDisabled()
+{
+    miopen::FusionPlanCache cache{0};
+    cache.Insert("a", Plan("a.cl"));
+    EXPECT(!Has(cache, "a"));
+    EXPECT_EQUAL(cache.GetSize(), 0);
+}
+
+} // namespace
+
+int main()
+{
+    CheckHitAndMiss();
+    CheckEviction();
+    CheckDisabled();
+}
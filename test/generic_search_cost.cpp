@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/tensor.hpp>
+
+#include "get_handle.hpp"
+#include "test.hpp"
+
+#include <limits>
+#include <vector>
+
+namespace {
+
+using Solver = miopen::solver::ConvHipImplicitGemmForwardV4R4Xdlops;
+using Config = miopen::solver::PerformanceImplicitGemmForwardV4R4Xdlops;
+
+using miopen::solver::EstimateCost_t;
+using miopen::solver::is_detected;
+
+static_assert(is_detected<EstimateCost_t, Solver, miopen::ConvolutionContext, Config>{},
+              "the cost search strategy must see the cost model");
+
+miopen::ConvolutionContext MakeContext(const std::vector<std::size_t>& in_lens,
+                                       const std::vector<std::size_t>& weights_lens,
+                                       int pad)
+{
+    const auto conv    = miopen::ConvolutionDescriptor{{pad, pad}, {1, 1}, {1, 1}, {0, 0}, 1};
+    const auto in      = miopen::TensorDescriptor{miopenFloat, in_lens};
+    const auto weights = miopen::TensorDescriptor{miopenFloat, weights_lens};
+    const auto out     = conv.GetForwardOutputTensor(in, weights, miopenFloat);
+
+    auto ctx = miopen::ConvolutionContext{in, weights, out, conv, miopen::conv::Direction::Forward};
+    ctx.SetStream(&get_handle());
+    return ctx;
+}
+
+void CheckCost()
+{
+    const auto solver = Solver{};
+    const auto large  = Config{256, 128, 4, 64, 64, 1, false, false, 1};
+    const auto small  = Config{64, 64, 4, 32, 32, 1, false, false, 1};
+
+    // The large blocks load the matrices fewer times, which wins on a large problem.
+    const auto large_problem = MakeContext({128, 256, 28, 28}, {256, 256, 3, 3}, 1);
+    EXPECT(solver.EstimateCost(large_problem, large) < solver.EstimateCost(large_problem, small));
+
+    // The small problem fits into a round of blocks either way, so the smaller blocks win.
+    const auto small_problem = MakeContext({16, 256, 4, 4}, {256, 256, 1, 1}, 0);
+    if(get_handle().GetMaxComputeUnits() >= 16)
+        EXPECT(solver.EstimateCost(small_problem, small) <
+               solver.EstimateCost(small_problem, large));
+
+    // The blocks must tile the GEMM.
+    const auto odd_problem = MakeContext({1, 256, 5, 5}, {256, 256, 1, 1}, 0);
+    EXPECT_EQUAL(solver.EstimateCost(odd_problem, large), std::numeric_limits<float>::max());
+}
+
+} // namespace
+
+int main() { CheckCost(); }
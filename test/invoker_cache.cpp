@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/invoker_cache.hpp>
+#include <miopen/problem_key.hpp>
+#include <miopen/solver_id.hpp>
+#include "test.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+static miopen::Invoker MakeInvoker(int* calls)
+{
+    return [calls](const miopen::Handle&, const miopen::AnyInvokeParams&) { ++*calls; };
+}
+
+static miopen::ProblemKey Key(const std::string& config)
+{
+    return miopen::ProblemKey{miopen::NetworkConfig{config}};
+}
+
+static void TestLookups()
+{
+    const auto solver = miopen::solver::Id{"ConvDirectNaiveConvFwd"};
+    CHECK(solver.IsValid());
+
+    miopen::InvokerCache cache;
+    const auto config = Key("config");
+    int fwd_calls     = 0;
+    int other         = 0;
+
+    EXPECT(!cache.GetInvoker(config, solver));
+    EXPECT(!cache.GetFound1_0(config, "miopenConvolutionFwdAlgoDirect"));
+    EXPECT(throws([&]() { cache.SetAsFound1_0(config, "algo", solver.ToString()); }));
+
+    cache.Register(config, solver.ToString(), MakeInvoker(&fwd_calls));
+    // The first registered invoker is kept.
+    cache.Register(config, solver.ToString(), MakeInvoker(&other));
+    cache.Register(config, "NotASolver", MakeInvoker(&other));
+
+    const auto invoker = cache.GetInvoker(config, solver);
+    EXPECT(invoker);
+    EXPECT(!cache.GetInvoker(Key("another config"), solver));
+    EXPECT(!cache.GetFound1_0(config, "miopenConvolutionFwdAlgoDirect"));
+
+    EXPECT(throws([&]() { cache.SetAsFound1_0(config, "algo", "ConvDirectNaiveConvBwd"); }));
+    cache.SetAsFound1_0(config, "miopenConvolutionFwdAlgoDirect", solver.ToString());
+    const auto found = cache.GetFound1_0(config, "miopenConvolutionFwdAlgoDirect");
+    EXPECT(found);
+    EXPECT(&*found == &*invoker);
+    EXPECT(!cache.GetFound1_0(config, "miopenConvolutionFwdAlgoGEMM"));
+
+    cache.SetAsFound1_0(config, "miopenConvolutionFwdAlgoDirect", "NotASolver");
+    const auto replaced = cache.GetFound1_0(config, "miopenConvolutionFwdAlgoDirect");
+    EXPECT(replaced);
+    EXPECT(&*replaced != &*invoker);
+}
+
+static void TestConcurrentAccess()
+{
+    const auto solver = miopen::solver::Id{"ConvDirectNaiveConvFwd"};
+    const auto algo   = std::string{"miopenConvolutionFwdAlgoDirect"};
+    const int configs = 1000;
+
+    miopen::InvokerCache cache;
+    std::atomic<int> missing{0};
+    std::vector<int> calls(configs);
+    std::vector<std::thread> threads;
+
+    for(int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for(int i = 0; i < configs; ++i)
+            {
+                const auto index  = (i + t * 131) % configs;
+                const auto config = Key(std::to_string(index));
+                cache.Register(config, solver.ToString(), MakeInvoker(&calls[index]));
+                cache.SetAsFound1_0(config, algo, solver.ToString());
+                if(!cache.GetInvoker(config, solver) || !cache.GetFound1_0(config, algo))
+                    ++missing;
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQUAL(missing.load(), 0);
+    for(int i = 0; i < configs; ++i)
+    {
+        const auto config  = Key(std::to_string(i));
+        const auto invoker = cache.GetInvoker(config, solver);
+        EXPECT(invoker);
+        EXPECT(&*invoker == &*cache.GetFound1_0(config, algo));
+    }
+}
+
+int main()
+{
+    TestLookups();
+    TestConcurrentAccess();
+}
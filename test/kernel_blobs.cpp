@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/config.h>
+#include <miopen/mapped_file.hpp>
+#include <miopen/target_properties.hpp>
+#include <miopen/tmp_dir.hpp>
+#include "test.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+static std::string Map(const miopen::TargetProperties& target, const std::string& args)
+{
+    const auto file = miopen::MapBinary(target, 1, "kernel_blobs_test.cl", args);
+    return file.IsValid() ? std::string(file.Data(), file.Size()) : std::string{};
+}
+
+/// The only file of the blob store.
+static boost::filesystem::path GetBlob()
+{
+    std::vector<boost::filesystem::path> blobs;
+    for(const auto& entry :
+        boost::filesystem::directory_iterator{miopen::GetCachePath(false) / "blobs"})
+        blobs.push_back(entry.path());
+    EXPECT_EQUAL(blobs.size(), 1);
+    return blobs.front();
+}
+#endif
+
+int main()
+{
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    const miopen::TmpDir cache_dir{"kernel_blobs"};
+    setenv("MIOPEN_CUSTOM_CACHE_DIR", cache_dir.path.c_str(), 1); // NOLINT (concurrency-mt-unsafe)
+    setenv("MIOPEN_DEBUG_KERNEL_CACHE_BLOBS", "1", 1);            // NOLINT (concurrency-mt-unsafe)
+
+    if(miopen::GetCachePath(false).empty() || miopen::IsCacheDisabled())
+        return 0;
+
+    const miopen::TargetProperties target{};
+    const auto binary = std::string("\177ELF\0\0\0\0code", 12);
+
+    EXPECT(Map(target, "-DTEST").empty());
+    miopen::SaveBinary(binary, target, 1, "kernel_blobs_test.cl", "-DTEST");
+    EXPECT(Map(target, "-DTEST") == binary);
+    EXPECT(Map(target, "-DOTHER").empty());
+
+    // The binaries found only in the database are written to the blob store when loaded.
+    boost::filesystem::remove_all(miopen::GetCachePath(false) / "blobs");
+    EXPECT(Map(target, "-DTEST").empty());
+    EXPECT(miopen::LoadBinary(target, 1, "kernel_blobs_test.cl", "-DTEST") == binary);
+    EXPECT(Map(target, "-DTEST") == binary);
+
+    // A damaged file is removed and written anew from the database.
+    const auto blob = GetBlob();
+    {
+        std::fstream file{blob.string(), std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(4);
+        file.put('X');
+    }
+    EXPECT(Map(target, "-DTEST").empty());
+    EXPECT(!boost::filesystem::exists(blob));
+    EXPECT(miopen::LoadBinary(target, 1, "kernel_blobs_test.cl", "-DTEST") == binary);
+    EXPECT(Map(target, "-DTEST") == binary);
+
+    // So is a truncated one.
+    boost::filesystem::resize_file(blob, binary.size());
+    EXPECT(Map(target, "-DTEST").empty());
+    EXPECT(!boost::filesystem::exists(blob));
+    EXPECT(miopen::LoadBinary(target, 1, "kernel_blobs_test.cl", "-DTEST") == binary);
+
+    // A binary that fails to load is removed by the caller.
+    miopen::RemoveMappedBinary(miopen::MapBinary(target, 1, "kernel_blobs_test.cl", "-DTEST"));
+    EXPECT(!boost::filesystem::exists(blob));
+    EXPECT(Map(target, "-DTEST").empty());
+#endif
+}
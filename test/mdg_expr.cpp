@@ -0,0 +1,321 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/fusion.hpp>
+#include <miopen/md_graph.hpp>
+#include <miopen/mdg_expr.hpp>
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/// Constraints of the fusion metadata graphs.
+const std::vector<std::string>& Constraints()
+{
+    static const std::vector<std::string> constraints = {
+        "((padded_x / 3) * (padded_y / 3) * c ) >= 18",
+        "((stride_h == 1) | (stride_h == 2))",
+        "((stride_w == 1) | (stride_w == 2))",
+        "(2^28) >= k",
+        "(c % 2) == 0",
+        "(c * iH * iW * 4) < (2^24)",
+        "(c * k) < (2^29)",
+        "(iN * c * iH * iW) < (2^29)",
+        "(iN * k * oH * oW) < (2^29)",
+        "(k % 2) == 0",
+        "(k * oH * oW * 4) < (2^24)",
+        "(oH * oW) >= 2",
+        "(x % 6) != 1",
+        "(x % 6) == 1",
+        "(x == 3) & (y == 3)",
+        "(y == 3) & (x == 3)",
+        "activ_mode == miopenActivationLEAKYRELU",
+        "activ_mode == miopenActivationRELU",
+        "algo === miopenConvolutionFwdAlgoDirect",
+        "algo === miopenConvolutionFwdAlgoWinograd",
+        "bn_mode == miopenBNPerActivation",
+        "bn_mode == miopenBNSpatial",
+        "c * iH * iW <= (2^28)",
+        "c * x * y <= (2^28)",
+        "c < (2^16)",
+        "c <= (2^16)",
+        "dilation_h == 1",
+        "dilation_w == 1",
+        "group_count == 1",
+        "iH <= (2^16)",
+        "iN < (2^16)",
+        "iW <= (2^16)",
+        "k * oH * oW <= (2^28)",
+        "k * x * y <= (2^28)",
+        "k >= 4",
+        "oH * oW <= (2^23)",
+        "pad_h <= 2",
+        "pad_h == 0",
+        "pad_w <= 2",
+        "pad_w == 0",
+        "padded_x === (x ~ 3)",
+        "padded_x === (x ~ 6)",
+        "padded_y === (y ~ 6)",
+        "padded_y === 3",
+        "precision == miopenFloat",
+        "precision == miopenHalf",
+        "stride_h == stride_w",
+        "weight === 0",
+        "weight === 100",
+        "weight === 5",
+        "x ~ 3 == 6",
+        "y < 3",
+        "y <= 3",
+        "y > 3",
+    };
+    return constraints;
+}
+
+/// What matching an edge with the constraints gives.
+struct Outcome
+{
+    std::vector<bool> results;
+    std::map<std::string, int> assigned;
+    std::string error;
+
+    friend bool operator==(const Outcome& l, const Outcome& r)
+    {
+        return l.results == r.results && l.assigned == r.assigned && l.error == r.error;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Outcome& o)
+    {
+        for(auto result : o.results)
+            os << result << ',';
+        for(auto& symbol : o.assigned)
+            os << symbol.first << '=' << symbol.second << ';';
+        return os << o.error;
+    }
+};
+
+using Attributes = std::map<std::string, int>;
+
+std::string ErrorOf(const miopen::Exception& ex)
+{
+    // Drop the location of the throw
+    const std::string what = ex.what();
+    const auto pos         = what.find("Invalid");
+    return pos == std::string::npos ? what : what.substr(pos);
+}
+
+/// Matching as it was done before the constraints were compiled: each one is parsed and
+/// visited, the values assigned by the previous ones are passed on.
+Outcome MatchTreeVisit(const std::vector<std::string>& constraints, const Attributes& attrs)
+{
+    Outcome outcome;
+    miopen::tree_visit visitor{[&](const std::string& sym, int& val) {
+        const auto attr = attrs.find(sym);
+        if(attr == attrs.end())
+            return false;
+        val = attr->second;
+        return true;
+    }};
+
+    try
+    {
+        for(auto& constraint : constraints)
+        {
+            auto first = constraint.begin();
+            miopen::MDGExprParser parser;
+            boost::spirit::utree tree;
+            EXPECT(boost::spirit::qi::phrase_parse(
+                first, constraint.end(), parser, boost::spirit::ascii::space, tree));
+            const auto r = boost::spirit::utree::visit(tree, visitor);
+            visitor.tabl.insert(r.tabl.begin(), r.tabl.end());
+            outcome.results.push_back(r.b_res);
+            if(!r.b_res)
+                break;
+        }
+        outcome.assigned = {visitor.tabl.begin(), visitor.tabl.end()};
+        // Assigning a symbol again put the value under an empty name, which nothing looks up.
+        outcome.assigned.erase("");
+    }
+    catch(const miopen::Exception& ex)
+    {
+        outcome.error = ErrorOf(ex);
+    }
+    return outcome;
+}
+
+Outcome MatchCompiled(const std::vector<const miopen::MDGraph_expr*>& constraints,
+                      const std::vector<std::string>& names,
+                      const std::unordered_map<std::string, int>& ids,
+                      const Attributes& attrs)
+{
+    Outcome outcome;
+    miopen::MDGraph_symbols syms{names};
+    for(auto& attr : attrs)
+    {
+        syms.attrs[ids.at(attr.first)]    = attr.second;
+        syms.has_attr[ids.at(attr.first)] = 1;
+    }
+
+    try
+    {
+        for(auto constraint : constraints)
+        {
+            const auto r = constraint->Eval(syms);
+            outcome.results.push_back(r.b_res);
+            if(!r.b_res)
+                break;
+        }
+        for(auto& symbol : syms.assigned)
+            outcome.assigned[names[symbol.first]] = symbol.second;
+    }
+    catch(const miopen::Exception& ex)
+    {
+        outcome.error = ErrorOf(ex);
+    }
+    return outcome;
+}
+
+void CheckEval()
+{
+    std::vector<std::string> names;
+    std::unordered_map<std::string, int> ids;
+    const auto intern = [&](const std::string& name) {
+        const auto id = ids.find(name);
+        if(id != ids.end())
+            return id->second;
+        names.push_back(name);
+        return ids[name] = static_cast<int>(names.size() - 1);
+    };
+
+    std::vector<miopen::MDGraph_expr> compiled;
+    for(auto& constraint : Constraints())
+        compiled.push_back(miopen::MDGraph_expr::Parse(constraint, intern));
+
+    // Symbols assigned by the graphs, they are never attributes.
+    const auto assigned_only = std::vector<std::string>{"weight", "algo", "padded_x", "padded_y"};
+
+    std::mt19937 rng(1); // NOLINT (cert-msc32-c, cert-msc51-cpp)
+    for(auto i = 0; i < 20000; ++i)
+    {
+        Attributes attrs;
+        for(auto& name : names)
+        {
+            if(std::find(assigned_only.begin(), assigned_only.end(), name) !=
+                   assigned_only.end() ||
+               rng() % 8 == 0)
+                continue;
+            const auto value = rng() % 2 != 0 ? rng() % 8 : rng() % 70000;
+            attrs[name]      = static_cast<int>(value) - (rng() % 16 == 0 ? 3 : 0);
+        }
+
+        std::vector<std::string> sources;
+        std::vector<const miopen::MDGraph_expr*> sequence;
+        const auto length = 1 + rng() % 6;
+        for(auto j = 0u; j < length; ++j)
+        {
+            const auto constraint = rng() % compiled.size();
+            sources.push_back(Constraints()[constraint]);
+            sequence.push_back(&compiled[constraint]);
+        }
+
+        const auto expected = MatchTreeVisit(sources, attrs);
+        const auto actual   = MatchCompiled(sequence, names, ids, attrs);
+        if(!(actual == expected))
+        {
+            std::cerr << "Sequence:";
+            for(auto& source : sources)
+                std::cerr << " [" << source << ']';
+            std::cerr << std::endl;
+            EXPECT_EQUAL(actual, expected);
+        }
+    }
+}
+
+void CheckAssignAttribute()
+{
+    // tree_visit assigned the value to an empty name instead.
+    std::vector<std::string> names;
+    const auto intern = [&](const std::string& name) {
+        names.push_back(name);
+        return static_cast<int>(names.size() - 1);
+    };
+    const auto expr = miopen::MDGraph_expr::Parse("weight === 5", intern);
+    miopen::MDGraph_symbols syms{names};
+    syms.attrs[0]    = 1;
+    syms.has_attr[0] = 1;
+    EXPECT(throws([&]() { expr.Eval(syms); }));
+}
+
+void CheckAdvanceWeights()
+{
+    auto relu  = std::make_shared<miopen::MDGraph_vertex>(miopen::miopenFusionOpActivForward);
+    auto other = std::make_shared<miopen::MDGraph_vertex>(miopen::miopenFusionOpActivForward);
+
+    miopen::FusionMDGraph_Edge_Map low  = {{"constraints", {"weight === 5"}}};
+    miopen::FusionMDGraph_Edge_Map high = {{"constraints", {"weight === 100"}}};
+    miopen::FusionMDGraph_Edge_Map none = {{"constraints", {"y > 3", "weight === 1000"}}};
+    miopen::FusionMDGraph_Edge_Map bare = {{"constraints", {"y <= 3"}}};
+
+    miopen::FusionMDGraph g;
+    g.AddEdge(nullptr, relu, low);
+    g.AddEdge(nullptr, relu, none);
+    g.AddEdge(nullptr, relu, high);
+    g.AddEdge(nullptr, other, bare);
+
+    const auto op = std::make_shared<miopen::ActivFwdFusionOpDescriptor>(miopenActivationRELU);
+    EXPECT(g.Advance(op, [](const std::string& sym, int& val) {
+        val = 3;
+        return sym == "y";
+    }));
+
+    // Every edge to a vertex that matches gives a path, with the weight of the matches of the
+    // edges to the vertex before it added.
+    auto paths = std::vector<std::pair<int, int>>{};
+    for(auto& kinder : g.cur_vertex)
+        paths.emplace_back(kinder.first->id, kinder.second.weight);
+    const auto expected = std::vector<std::pair<int, int>>{
+        {relu->id, 105},
+        {relu->id, 5},
+        {other->id, 0},
+    };
+    EXPECT(paths == expected);
+}
+
+} // namespace
+
+int main()
+{
+    CheckEval();
+    CheckAssignAttribute();
+    CheckAdvanceWeights();
+}
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/par_for.hpp>
+#include <miopen/thread_pool.hpp>
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static void CheckAllVisitedOnce(miopen::ThreadPool& pool, std::size_t n, std::size_t threads)
+{
+    std::vector<std::atomic<int>> visits(n);
+    for(auto& visit : visits)
+        visit = 0;
+
+    pool.ParallelFor(n, threads, [&](std::size_t begin, std::size_t end) {
+        CHECK(begin < end);
+        CHECK(end <= n);
+        for(auto i = begin; i < end; ++i)
+            ++visits[i];
+    });
+
+    for(const auto& visit : visits)
+        EXPECT_EQUAL(visit.load(), 1);
+}
+
+static void TestRanges(miopen::ThreadPool& pool)
+{
+    for(const auto n : {0, 1, 3, 17, 1000, 100003})
+        for(const auto threads : {1, 2, 5, 64})
+            CheckAllVisitedOnce(pool, n, threads);
+}
+
+static void TestImbalanced(miopen::ThreadPool& pool)
+{
+    // All the slow iterations are at the start, so the thread that gets them has to be helped.
+    std::atomic<int> sum{0};
+    pool.ParallelFor(64, 5, [&](std::size_t begin, std::size_t end) {
+        for(auto i = begin; i < end; ++i)
+        {
+            if(i < 8)
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            sum += static_cast<int>(i);
+        }
+    });
+    EXPECT_EQUAL(sum.load(), 64 * 63 / 2);
+}
+
+static void TestNested(miopen::ThreadPool& pool)
+{
+    std::atomic<int> count{0};
+    pool.ParallelFor(16, 64, [&](std::size_t begin, std::size_t end) {
+        for(auto i = begin; i < end; ++i)
+        {
+            pool.ParallelFor(100, 64, [&](std::size_t inner_begin, std::size_t inner_end) {
+                count += static_cast<int>(inner_end - inner_begin);
+            });
+        }
+    });
+    EXPECT_EQUAL(count.load(), 1600);
+}
+
+static void TestException(miopen::ThreadPool& pool)
+{
+    auto thrown = false;
+
+    try
+    {
+        pool.ParallelFor(1000, 64, [&](std::size_t begin, std::size_t end) {
+            if(begin <= 500 && 500 < end)
+                throw std::runtime_error("par_for test");
+        });
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+
+    EXPECT(thrown);
+    CheckAllVisitedOnce(pool, 1000, 64);
+}
+
+static void TestParFor()
+{
+    std::vector<std::atomic<int>> visits(1000);
+    for(auto& visit : visits)
+        visit = 0;
+
+    miopen::par_for(visits.size(), [&](std::size_t i) { ++visits[i]; });
+    miopen::par_for(visits.size(), miopen::max_threads{3}, [&](std::size_t i) { ++visits[i]; });
+    miopen::par_for_strided(
+        visits.size(), miopen::max_threads{5}, [&](std::size_t i) { ++visits[i]; });
+
+    for(const auto& visit : visits)
+        EXPECT_EQUAL(visit.load(), 3);
+}
+
+int main()
+{
+    // Explicit worker count, so the test is parallel regardless of the hardware.
+    miopen::ThreadPool pool{4};
+
+    TestRanges(pool);
+    TestImbalanced(pool);
+    TestNested(pool);
+    TestException(pool);
+    TestParFor();
+}
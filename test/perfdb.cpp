@@ -27,9 +27,12 @@
 #include "test.hpp"
 #include "driver.hpp"
 
+#include <miopen/binary_db.hpp>
 #include <miopen/db.hpp>
+#include <miopen/db_cache.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/lock_file.hpp>
+#include <miopen/readonlyramdb.hpp>
 #include <miopen/temp_file.hpp>
 
 #include <boost/filesystem/operations.hpp>
@@ -395,6 +398,254 @@ class DbReadTest : public DbTest
     }
 };
 
+class DbExternalChangeTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for reading file changed by another writer..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        PlainTextDb db(temp_file);
+        ValidateSingleEntry(key(), common_data(), db);
+
+        // Same size of the file and likely same mtime second, only contents differ.
+        const std::array<std::pair<const std::string, TestData>, 2> changed_data{{
+            {id1(), value0()},
+            {id0(), value1()},
+        }};
+
+        RawWrite(temp_file, key(), changed_data);
+        ValidateSingleEntry(key(), changed_data, db);
+
+        ResetDb();
+        EXPECT(!db.FindRecord(key()));
+    }
+};
+
+class DbReadonlyRamDbTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing readonly ram db for reading premade file..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+        // Duplicate key and ill-formed lines shall be ignored.
+        std::ofstream(temp_file, std::ios::app) << "\nill-formed\n"
+                                                << key().x << ',' << key().y << "=0:1,1\n";
+
+        const auto& db = ReadonlyRamDb::GetCached(temp_file, false);
+        ValidateSingleEntry<const ReadonlyRamDb&>(key(), common_data(), db);
+
+        TestData read(TestData::NoInit{});
+        EXPECT(db.Load(key(), id1(), read));
+        EXPECT_EQUAL(read, value1());
+        EXPECT(!db.Load(key(), missing_id(), read));
+        EXPECT(!db.FindRecord(TestData(100, 200)));
+
+        std::cout << "Testing readonly ram db for background loading of a large file..."
+                  << std::endl;
+
+        // Large enough to be split into several chunks.
+        constexpr auto records = 32 * 1024;
+        const TempFile large_file{"miopen.tests.perfdb.large"};
+
+        {
+            std::ofstream out(large_file);
+            for(auto i = 0; i < records; ++i)
+                out << i << ',' << i + 1 << '=' << id0() << ':' << i << ',' << -i << ';' << id1()
+                    << ':' << -i << ',' << i << std::endl;
+        }
+
+        ReadonlyRamDb::StartPrefetch(large_file, false);
+        const auto& large_db = ReadonlyRamDb::GetCached(large_file, false);
+
+        for(auto i = 0; i < records; i += 97)
+        {
+            const std::array<std::pair<const std::string, TestData>, 2> data{{
+                {id0(), {i, -i}},
+                {id1(), {-i, i}},
+            }};
+            ValidateSingleEntry<const ReadonlyRamDb&>(TestData(i, i + 1), data, large_db);
+        }
+
+        EXPECT(!large_db.FindRecord(TestData(records, records + 1)));
+    }
+};
+
+class DbBinaryDbTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing binary db for reading converted file..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+        // Duplicate key and ill-formed lines shall be ignored, the same as by text dbs.
+        std::ofstream(temp_file, std::ios::app) << "\nill-formed\n"
+                                                << key().x << ',' << key().y << "=0:1,1\n"
+                                                << "3,4=ill-formed;" << id0() << ":5,6;"
+                                                << id0() << ":7,8\n";
+
+        const TempFile binary_file{"miopen.tests.perfdb.bin"};
+        EXPECT(BinaryDb::Convert(temp_file, binary_file));
+        EXPECT(BinaryDb::Verify(temp_file, binary_file));
+
+        {
+            const BinaryDb db{binary_file};
+            EXPECT_EQUAL(db.GetSize(), 2);
+            ValidateSingleEntry<const BinaryDb&>(key(), common_data(), db);
+
+            const std::array<std::pair<const std::string, TestData>, 1> data{{
+                {id0(), {5, 6}},
+            }};
+            ValidateSingleEntry<const BinaryDb&>(TestData(3, 4), data, db);
+
+            TestData read(TestData::NoInit{});
+            EXPECT(db.Load(key(), id1(), read));
+            EXPECT_EQUAL(read, value1());
+            EXPECT(!db.Load(key(), missing_id(), read));
+            EXPECT(!db.FindRecord(TestData(100, 200)));
+        }
+
+        std::cout << "Testing binary db as an installed db..." << std::endl;
+
+        {
+            const TempFile user_file{"miopen.tests.perfdb.user"};
+            const std::array<std::pair<const std::string, TestData>, 1> user_data{{
+                {id0(), value1()},
+            }};
+            RawWrite(user_file, key(), user_data);
+
+            MultiFileDb<BinaryDb, PlainTextDb, false> db{binary_file, user_file};
+            ValidateSingleEntry(key(), user_data, db);
+
+            const TestData other_key(3, 4);
+            TestData read(TestData::NoInit{});
+            EXPECT(db.Load(other_key, id0(), read));
+            EXPECT_EQUAL(read, TestData(5, 6));
+        }
+
+        std::cout << "Testing binary db for rejecting invalid files..." << std::endl;
+
+        {
+            // Text db is not a valid binary one.
+            const BinaryDb db{temp_file};
+            EXPECT(!db.IsValid());
+            EXPECT(!db.FindRecord(key()));
+        }
+
+        std::cout << "Testing binary db for round trip of a large file..." << std::endl;
+
+        constexpr auto records = 32 * 1024;
+        const TempFile large_file{"miopen.tests.perfdb.large"};
+        const TempFile large_binary_file{"miopen.tests.perfdb.large.bin"};
+
+        {
+            std::ofstream out(large_file);
+            for(auto i = 0; i < records; ++i)
+                out << i << ',' << i + 1 << '=' << id0() << ':' << i << ',' << -i << ';' << id1()
+                    << ':' << -i << ',' << i << std::endl;
+        }
+
+        EXPECT(BinaryDb::Convert(large_file, large_binary_file));
+        EXPECT(BinaryDb::Verify(large_file, large_binary_file));
+
+        const BinaryDb large_db{large_binary_file};
+        EXPECT_EQUAL(large_db.GetSize(), records);
+
+        for(auto i = 0; i < records; i += 97)
+        {
+            const std::array<std::pair<const std::string, TestData>, 2> data{{
+                {id0(), {i, -i}},
+                {id1(), {-i, i}},
+            }};
+            ValidateSingleEntry<const BinaryDb&>(TestData(i, i + 1), data, large_db);
+        }
+
+        EXPECT(!large_db.FindRecord(TestData(records, records + 1)));
+
+        // Verification shall catch a binary db converted from different data.
+        std::ofstream(large_file, std::ios::app) << records << ',' << records + 1 << "=0:1,2\n";
+        EXPECT(!BinaryDb::Verify(large_file, large_binary_file));
+    }
+};
+
+class DbLargeRecordTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db for a record with many IDs..." << std::endl;
+        ResetDb();
+
+        constexpr auto count = 64;
+        const auto id        = [](int i) { return "Solver" + std::to_string(i); };
+
+        {
+            DbRecord record(key());
+            for(auto i = count - 1; i >= 0; --i)
+                EXPECT(record.SetValues(id(i), TestData(i, i)));
+
+            // Overwritten values leave garbage in the record, which should not be visible.
+            for(auto n = 1; n <= 8; ++n)
+                for(auto i = 0; i < count; i += 2)
+                    EXPECT(record.SetValues(id(i), TestData(i, n)));
+
+            for(auto i = 1; i < count; i += 4)
+                EXPECT(record.EraseValues(id(i)));
+
+            DbRecord other(key());
+            EXPECT(other.SetValues(id(0), value0()));
+            EXPECT(other.SetValues(id(1), value1()));
+            EXPECT(other.SetValues("Solver", value2()));
+            record.Merge(other);
+
+            PlainTextDb db(temp_file);
+            EXPECT(db.StoreRecord(record));
+        }
+
+        PlainTextDb db(temp_file);
+        const auto record = db.FindRecord(key());
+        EXPECT(record);
+        EXPECT_EQUAL(record->GetSize(), count - count / 4 + 2);
+
+        // Merge adds only the IDs missing in the record.
+        TestData read(TestData::NoInit{});
+        EXPECT(record->GetValues("Solver", read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(record->GetValues(id(1), read));
+        EXPECT_EQUAL(read, value1());
+
+        for(auto i = 2; i < count; ++i)
+        {
+            if(i % 4 == 1)
+            {
+                EXPECT(!record->GetValues(id(i), read));
+                continue;
+            }
+
+            EXPECT(record->GetValues(id(i), read));
+            EXPECT_EQUAL(read, TestData(i, i % 2 == 0 ? 8 : i));
+        }
+
+        auto iterated = 0;
+        for(const auto& pair : record->As<TestData>())
+        {
+            TestData expected(TestData::NoInit{});
+            EXPECT(record->GetValues(pair.first, expected));
+            EXPECT_EQUAL(pair.second, expected);
+            ++iterated;
+        }
+        EXPECT_EQUAL(iterated, record->GetSize());
+    }
+};
+
 class DbWriteTest : public DbTest
 {
     public:
@@ -418,6 +669,76 @@ class DbWriteTest : public DbTest
     }
 };
 
+class DbJournalTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db journal replay and compaction..." << std::endl;
+
+        ResetDb();
+        const TestData to_be_rewritten(7, 8);
+        const std::array<std::pair<const std::string, TestData>, 1> other_data{{
+            {id0(), value1()},
+        }};
+        const TestData other_key(9, 10);
+
+        PlainTextDb db(temp_file);
+
+        EXPECT(db.Update(key(), id0(), to_be_rewritten));
+        EXPECT(db.Update(other_key, id0(), value1()));
+        EXPECT(db.Update(key(), id1(), to_be_rewritten));
+        EXPECT(db.Update(key(), id0(), value0()));
+        EXPECT(db.Update(key(), id1(), value1()));
+
+        ValidateSingleEntry(key(), common_data(), db);
+        ValidateReplay(other_key, other_data);
+
+        EXPECT(db.Compact());
+        EXPECT_EQUAL(CountLines(), 2);
+        ValidateSingleEntry(key(), common_data(), db);
+        ValidateReplay(other_key, other_data);
+
+        EXPECT(db.RemoveRecord(other_key));
+        EXPECT(!db.FindRecord(other_key));
+        ValidateReplay(key(), common_data());
+        EXPECT(!PlainTextDb(CopyDb()).FindRecord(other_key));
+
+        EXPECT(db.Compact());
+        EXPECT_EQUAL(CountLines(), 1);
+        ValidateSingleEntry(key(), common_data(), db);
+    }
+
+    private:
+    TempFile copy_file{"miopen.tests.perfdb.copy"};
+
+    int CountLines() const
+    {
+        auto file  = std::ifstream(temp_file);
+        auto line  = std::string{};
+        auto count = 0;
+        while(std::getline(file, line))
+            ++count;
+        return count;
+    }
+
+    std::string CopyDb() const
+    {
+        boost::filesystem::copy_file(temp_file.Path(),
+                                     copy_file.Path(),
+                                     boost::filesystem::copy_option::overwrite_if_exists);
+        return copy_file;
+    }
+
+    // Reading the file with a fresh index replays the whole journal.
+    template <size_t count>
+    void ValidateReplay(const TestData& key_,
+                        const std::array<std::pair<const std::string, TestData>, count>& data) const
+    {
+        ValidateSingleEntry(key_, data, PlainTextDb(CopyDb()));
+    }
+};
+
 class DbOperationsTest : public DbTest
 {
     public:
@@ -1195,6 +1516,107 @@ class DbMultiFileOperationsTest : public DbMultiFileTest
     }
 };
 
+class DbMultiFileCachedTest : public DbMultiFileTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Running multifile cached test..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        using Db = CachedDb<MultiFileDb<PlainTextDb, PlainTextDb, true>>;
+        Db db(temp_file, user_db_path);
+        const auto initial = db.GetCacheStats();
+        TestData read(TestData::NoInit{});
+
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value0());
+        EXPECT(db.Load(key(), id1(), read));
+        EXPECT_EQUAL(read, value1());
+
+        auto stats = db.GetCacheStats();
+        EXPECT_EQUAL(stats.misses - initial.misses, 1);
+        EXPECT_EQUAL(stats.hits - initial.hits, 1);
+
+        {
+            // The cache is shared by all the instances for the same files.
+            Db other(temp_file, user_db_path);
+            EXPECT(other.FindRecord(key()));
+            EXPECT_EQUAL(db.GetCacheStats().hits - stats.hits, 1);
+
+            EXPECT(other.Update(key(), id1(), value2()));
+        }
+
+        EXPECT(db.Load(key(), id1(), read));
+        EXPECT_EQUAL(read, value2());
+
+        EXPECT(db.Remove(key(), id1()));
+        EXPECT(db.Load(key(), id1(), read));
+        EXPECT_EQUAL(read, value1());
+
+        // Absence of a record is cached too.
+        const TestData missing_key(100, 200);
+        stats = db.GetCacheStats();
+        EXPECT(!db.FindRecord(missing_key));
+        EXPECT(!db.FindRecord(missing_key));
+        EXPECT_EQUAL(db.GetCacheStats().misses - stats.misses, 1);
+        EXPECT_EQUAL(db.GetCacheStats().hits - stats.hits, 1);
+    }
+};
+
+class DbMultiFileWriteBehindTest : public DbMultiFileTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Running multifile write-behind test..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        using Db = MultiFileDb<PlainTextDb, PlainTextDb, true>;
+        DbRecordCache cache{16};
+        DbWriteBehindQueue<Db> queue{cache, temp_file.Path(), user_db_path};
+        const auto db_key = DbRecord{key()}.GetKey();
+
+        const auto update = [&](const TestData& value) {
+            std::ostringstream ss;
+            value.Serialize(ss);
+            EXPECT(queue.Push(db_key, id1(), ss.str(), [value](Db& db) {
+                db.Update(key(), id1(), value);
+            }));
+        };
+
+        update(value0());
+        update(value2());
+
+        // Queued changes are visible before they are written.
+        auto record = boost::optional<DbRecord>{};
+        queue.Overlay(db_key, record);
+        EXPECT(record);
+        TestData read(TestData::NoInit{});
+        EXPECT(record->GetValues(id1(), read));
+        EXPECT_EQUAL(read, value2());
+
+        queue.Flush();
+
+        {
+            PlainTextDb db(user_db_path);
+            EXPECT(db.Load(key(), id1(), read));
+            EXPECT_EQUAL(read, value2());
+        }
+
+        record = boost::none;
+        queue.Overlay(db_key, record);
+        EXPECT(!record);
+
+        queue.Stop();
+        EXPECT(!queue.Push(db_key, id1(), "", [](Db&) {}));
+    }
+};
+
 class DbMultiFileMultiThreadedReadTest : public DbMultiFileTest
 {
     public:
@@ -1313,8 +1735,13 @@ struct PerfDbDriver : test_driver
         DbUpdateTest().Run();
         DbRemoveTest().Run();
         DbReadTest().Run();
+        DbExternalChangeTest().Run();
+        DbReadonlyRamDbTest().Run();
+        DbBinaryDbTest().Run();
+        DbLargeRecordTest().Run();
         DbWriteTest().Run();
         DbOperationsTest().Run();
+        DbJournalTest().Run();
         DbParallelTest().Run();
 
         DbMultiThreadedReadTest().Run();
@@ -1326,6 +1753,8 @@ struct PerfDbDriver : test_driver
         DbMultiFileReadTest<false>().Run();
         DbMultiFileWriteTest().Run();
         DbMultiFileOperationsTest().Run();
+        DbMultiFileCachedTest().Run();
+        DbMultiFileWriteBehindTest().Run();
         DbMultiFileMultiThreadedReadTest().Run();
         DbMultiFileMultiThreadedTest().Run();
 #endif
@@ -0,0 +1,249 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/miopen.h>
+#include <miopen/solver_id.hpp>
+
+#include "serialize.hpp"
+#include "cpu_conv.hpp"
+#include "get_handle.hpp"
+#include "tensor_holder.hpp"
+#include "test.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace {
+
+const std::vector<std::size_t> in_lens  = {2, 8, 11, 13};
+const std::vector<std::size_t> wei_lens = {16, 8, 3, 3};
+
+/// Small integers keep every sum exact, so the results must match the reference bitwise.
+tensor<float> make_integer_tensor(const std::vector<std::size_t>& lens, unsigned seed)
+{
+    return make_tensor<float>(lens, [&](auto... is) {
+        std::size_t hash = seed;
+        for(auto i : std::initializer_list<std::size_t>{static_cast<std::size_t>(is)...})
+            hash = hash * 31 + i;
+        return static_cast<float>(static_cast<int>(hash % 7) - 3);
+    });
+}
+
+uint64_t SolutionId(const char* solver) { return miopen::solver::Id(solver).Value(); }
+
+struct Prepared
+{
+    miopenPreparedConvolution_t ptr = nullptr;
+
+    Prepared(miopenConvDirection_t direction,
+             tensor<float>& wei,
+             tensor<float>& x,
+             miopen::ConvolutionDescriptor& conv,
+             tensor<float>& y,
+             const char* solver)
+    {
+        EXPECT(miopenCreatePreparedConvolution(&get_handle(),
+                                               &ptr,
+                                               direction,
+                                               &wei.desc,
+                                               &x.desc,
+                                               &conv,
+                                               &y.desc,
+                                               SolutionId(solver)) == miopenStatusSuccess);
+    }
+
+    ~Prepared() { miopenDestroyPreparedConvolution(ptr); }
+
+    Prepared(const Prepared&) = delete;
+    Prepared& operator=(const Prepared&) = delete;
+};
+
+/// Runs the prepared convolution on the tensors and reads them all back.
+void run(const Prepared& prepared, tensor<float>& wei, tensor<float>& x, tensor<float>& y)
+{
+    auto&& handle = get_handle();
+    auto w_dev    = handle.Write(wei.data);
+    auto x_dev    = handle.Write(x.data);
+    auto y_dev    = handle.Write(y.data);
+
+    EXPECT(miopenRunPreparedConvolution(
+               &handle, prepared.ptr, w_dev.get(), x_dev.get(), y_dev.get(), nullptr, 0) ==
+           miopenStatusSuccess);
+
+    wei.data = handle.Read<float>(w_dev, wei.data.size());
+    x.data   = handle.Read<float>(x_dev, x.data.size());
+    y.data   = handle.Read<float>(y_dev, y.data.size());
+}
+
+void check_directions()
+{
+    auto conv = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    auto x    = make_integer_tensor(in_lens, 1);
+    auto wei  = make_integer_tensor(wei_lens, 2);
+    auto y    = tensor<float>{conv.GetForwardOutputTensor(x.desc, wei.desc)};
+
+    const Prepared fwd{miopenConvDirectionForward, wei, x, conv, y, "ConvDirectNaiveConvFwd"};
+    const Prepared bwd{miopenConvDirectionBackwardData, wei, x, conv, y, "ConvDirectNaiveConvBwd"};
+    const Prepared wrw{
+        miopenConvDirectionBackwardWeights, wei, x, conv, y, "ConvDirectNaiveConvWrw"};
+
+    // Each object is run twice to check that it does not depend on the data it has been run on.
+    for(unsigned seed = 10; seed < 12; ++seed)
+    {
+        x      = make_integer_tensor(in_lens, seed);
+        wei    = make_integer_tensor(wei_lens, seed + 1);
+        auto r = y;
+        cpu_convolution_forward(2,
+                                x,
+                                wei,
+                                r,
+                                conv.GetConvPads(),
+                                conv.GetConvStrides(),
+                                conv.GetConvDilations(),
+                                conv.GetGroupCount());
+        run(fwd, wei, x, y);
+        EXPECT(y.data == r.data);
+
+        y      = make_integer_tensor(y.desc.GetLengths(), seed + 2);
+        auto d = x;
+        cpu_convolution_backward_data(2,
+                                      d,
+                                      wei,
+                                      y,
+                                      conv.GetConvPads(),
+                                      conv.GetConvStrides(),
+                                      conv.GetConvDilations(),
+                                      conv.GetGroupCount());
+        run(bwd, wei, x, y);
+        EXPECT(x.data == d.data);
+
+        x = make_integer_tensor(in_lens, seed + 3);
+        d = wei;
+        cpu_convolution_backward_weight(2,
+                                        x,
+                                        d,
+                                        y,
+                                        conv.GetConvPads(),
+                                        conv.GetConvStrides(),
+                                        conv.GetConvDilations(),
+                                        conv.GetGroupCount());
+        run(wrw, wei, x, y);
+        EXPECT(wei.data == d.data);
+    }
+}
+
+void check_transpose()
+{
+    auto conv = miopen::ConvolutionDescriptor{
+        2, miopenTranspose, miopenPaddingDefault, {1, 1}, {1, 1}, {1, 1}, {0, 0}};
+    // The transpose convolution maps the 16 channels of the filter to its 8 ones.
+    auto x   = make_integer_tensor({2, 16, 11, 13}, 3);
+    auto wei = make_integer_tensor(wei_lens, 4);
+    auto y   = tensor<float>{conv.GetForwardOutputTensor(x.desc, wei.desc)};
+
+    // Run as the backward convolution w-r-t data, so the naive backward solver is requested.
+    const Prepared fwd{miopenConvDirectionForward, wei, x, conv, y, "ConvDirectNaiveConvBwd"};
+
+    auto r = y;
+    cpu_convolution_backward_data(2,
+                                  r,
+                                  wei,
+                                  x,
+                                  conv.GetConvPads(),
+                                  conv.GetConvStrides(),
+                                  conv.GetConvDilations(),
+                                  conv.GetGroupCount());
+    run(fwd, wei, x, y);
+    EXPECT(y.data == r.data);
+}
+
+void check_errors()
+{
+    auto&& handle = get_handle();
+    auto conv     = miopen::ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+    auto x        = make_integer_tensor(in_lens, 1);
+    auto wei      = make_integer_tensor(wei_lens, 2);
+    auto y        = tensor<float>{conv.GetForwardOutputTensor(x.desc, wei.desc)};
+
+    // The channels of x do not match the ones of the filter.
+    auto bad_x                      = make_integer_tensor({2, 4, 11, 13}, 1);
+    miopenPreparedConvolution_t ptr = nullptr;
+    EXPECT(miopenCreatePreparedConvolution(&handle,
+                                           &ptr,
+                                           miopenConvDirectionForward,
+                                           &wei.desc,
+                                           &bad_x.desc,
+                                           &conv,
+                                           &y.desc,
+                                           SolutionId("ConvDirectNaiveConvFwd")) ==
+           miopenStatusBadParm);
+
+    const Prepared fwd{miopenConvDirectionForward, wei, x, conv, y, "ConvDirectNaiveConvFwd"};
+    auto w_dev = handle.Write(wei.data);
+    auto x_dev = handle.Write(x.data);
+    auto y_dev = handle.Write(y.data);
+
+    EXPECT(miopenRunPreparedConvolution(
+               &handle, fwd.ptr, w_dev.get(), nullptr, y_dev.get(), nullptr, 0) ==
+           miopenStatusBadParm);
+
+    auto other = miopen::Handle{};
+    EXPECT(miopenRunPreparedConvolution(
+               &other, fwd.ptr, w_dev.get(), x_dev.get(), y_dev.get(), nullptr, 0) ==
+           miopenStatusBadParm);
+
+    // A handle that takes the place of a destroyed one is still another handle.
+    miopenPreparedConvolution_t stale = nullptr;
+    {
+        auto destroyed = miopen::Handle{};
+        EXPECT(miopenCreatePreparedConvolution(&destroyed,
+                                               &stale,
+                                               miopenConvDirectionForward,
+                                               &wei.desc,
+                                               &x.desc,
+                                               &conv,
+                                               &y.desc,
+                                               SolutionId("ConvDirectNaiveConvFwd")) ==
+               miopenStatusSuccess);
+    }
+    auto next = miopen::Handle{};
+    EXPECT(miopenRunPreparedConvolution(
+               &next, stale, w_dev.get(), x_dev.get(), y_dev.get(), nullptr, 0) ==
+           miopenStatusBadParm);
+    miopenDestroyPreparedConvolution(stale);
+}
+
+} // namespace
+
+int main()
+{
+    check_directions();
+    check_transpose();
+    check_errors();
+}
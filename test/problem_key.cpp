@@ -0,0 +1,153 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/problem_key.hpp>
+#include <miopen/tensor.hpp>
+#include "test.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using Direction = miopen::conv::Direction;
+
+struct Problem
+{
+    miopen::TensorDescriptor in;
+    miopen::TensorDescriptor weights;
+    miopen::TensorDescriptor out;
+    miopen::ConvolutionDescriptor conv;
+    Direction direction;
+
+    miopen::conv::ProblemDescription Describe() const
+    {
+        return {in, weights, out, conv, direction};
+    }
+};
+
+Problem MakeProblem(miopenDataType_t type,
+                    const std::vector<std::size_t>& in_lens,
+                    const std::vector<std::size_t>& weights_lens,
+                    const std::vector<int>& pads,
+                    int group_count,
+                    Direction direction,
+                    bool nhwc = false)
+{
+    const auto dims = in_lens.size() - 2;
+    auto conv       = miopen::ConvolutionDescriptor{dims,
+                                              miopenConvolution,
+                                              miopenPaddingDefault,
+                                              pads,
+                                              std::vector<int>(dims, 1),
+                                              std::vector<int>(dims, 1),
+                                              std::vector<int>(dims, 0),
+                                              group_count};
+
+    // The dimensions are always given in the NCHW order, the strides define the layout.
+    const auto make_tensor = [&](const std::vector<std::size_t>& lens) {
+        if(!nhwc)
+            return miopen::TensorDescriptor{type, lens};
+        const auto c = lens[1];
+        const auto h = lens[2];
+        const auto w = lens[3];
+        return miopen::TensorDescriptor{type, lens, {h * w * c, 1, w * c, c}};
+    };
+
+    const auto in      = make_tensor(in_lens);
+    const auto weights = make_tensor(weights_lens);
+    const auto out     = make_tensor(conv.GetForwardOutputTensor(in, weights, type).GetLengths());
+    return {in, weights, out, conv, direction};
+}
+
+void CheckConfigs()
+{
+    // The network configs are stored in find-db, so they must not change.
+    const auto check = [](const Problem& problem, const std::string& expected) {
+        const auto description = problem.Describe();
+        EXPECT_EQUAL(description.BuildProblemKey().ToString(), expected);
+        EXPECT_EQUAL(description.BuildConfKey().ToString(), expected);
+    };
+
+    check(MakeProblem(
+              miopenFloat, {16, 64, 28, 28}, {128, 64, 3, 3}, {1, 1}, 1, Direction::Forward),
+          "64x28x28x3x3x128x28x28x16xNCHWxFP32x1x1x1x1x1x1x1xF");
+    check(MakeProblem(
+              miopenHalf, {2, 8, 5, 9, 9}, {8, 4, 1, 3, 3}, {0, 1, 1}, 2, Direction::BackwardData),
+          "8x5x9x9x1x3x3x8x5x9x9x2xNCDHWxFP16x0x1x1x1x1x1x1x1x1x2xB");
+    check(MakeProblem(miopenFloat,
+                      {4, 32, 14, 14},
+                      {32, 32, 1, 1},
+                      {0, 0},
+                      1,
+                      Direction::BackwardWeights,
+                      true),
+          "32x14x14x1x1x32x14x14x4xNHWCxNHWCxNHWCxFP32x0x0x1x1x1x1x1xW");
+}
+
+void CheckKeys()
+{
+    const auto problem = MakeProblem(
+        miopenFloat, {16, 64, 28, 28}, {128, 64, 3, 3}, {1, 1}, 1, Direction::Forward);
+    const auto key = problem.Describe().BuildProblemKey();
+
+    EXPECT(key == problem.Describe().BuildProblemKey());
+    EXPECT_EQUAL(key.GetHash(), problem.Describe().BuildProblemKey().GetHash());
+
+    auto other      = problem;
+    other.direction = Direction::BackwardData;
+    EXPECT(key != other.Describe().BuildProblemKey());
+    EXPECT(key.GetHash() != other.Describe().BuildProblemKey().GetHash());
+
+    const auto padded = MakeProblem(
+        miopenFloat, {16, 64, 28, 28}, {128, 64, 3, 3}, {0, 0}, 1, Direction::Forward);
+    EXPECT(key != padded.Describe().BuildProblemKey());
+
+    // A key from a string is never equal to one from a problem, even with the same config.
+    const auto config = miopen::ProblemKey{key.ToNetworkConfig()};
+    EXPECT_EQUAL(config.ToString(), key.ToString());
+    EXPECT(config != key);
+    EXPECT(config == miopen::ProblemKey{miopen::NetworkConfig{key.ToString()}});
+    EXPECT(config != miopen::ProblemKey{miopen::NetworkConfig{"another config"}});
+}
+
+void CheckPacking()
+{
+    for(const auto str : {"", "NCHW", "NCDHW", "NHWCc4", "12345678"})
+        EXPECT_EQUAL(miopen::ProblemKey::UnpackString(miopen::ProblemKey::PackString(str)), str);
+    EXPECT(throws([]() { miopen::ProblemKey::PackString("123456789"); }));
+}
+
+} // namespace
+
+int main()
+{
+    CheckConfigs();
+    CheckKeys();
+    CheckPacking();
+}
@@ -464,6 +464,51 @@ class DbOperationsTest : public DbTest
     }
 };
 
+class DbBatchTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing batched db updates..." << std::endl;
+
+        const ProblemData p0(0);
+        const ProblemData p1(1);
+
+        {
+            SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+            const auto batch = db.BeginBatch();
+
+            EXPECT(db.Update(p0, id0(), value0()));
+            EXPECT(db.Update(p0, id1(), value2()));
+
+            {
+                // Nested batch joins the outer one.
+                const auto inner = db.BeginBatch();
+                EXPECT(db.Update(p0, id1(), value1()));
+                EXPECT(db.StoreRecord(p1, id2(), value2()));
+            }
+
+            // Changes are visible through the same db before the batch is committed.
+            SolverData read;
+            EXPECT(db.Load(p0, id1(), read));
+            EXPECT_EQUAL(read, value1());
+        }
+
+        {
+            SolverData read0, read1, read2;
+            SQLitePerfDb db(std::string(temp_file), false, "gfx906", 64);
+
+            EXPECT(db.Load(p0, id0(), read0));
+            EXPECT(db.Load(p0, id1(), read1));
+            EXPECT(db.Load(p1, id2(), read2));
+
+            EXPECT_EQUAL(read0, value0());
+            EXPECT_EQUAL(read1, value1());
+            EXPECT_EQUAL(read2, value2());
+        }
+    }
+};
+
 class DbParallelTest : public DbTest
 {
     public:
@@ -1264,6 +1309,7 @@ struct PerfDbDriver : test_driver
         }
         DbFindTest().Run();
         DbOperationsTest().Run();
+        DbBatchTest().Run();
         DbParallelTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiThreadedReadTest().Run();
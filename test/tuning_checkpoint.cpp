@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+
+#include <miopen/tmp_dir.hpp>
+#include <miopen/tuning_checkpoint.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+
+using Record = miopen::solver::TuningCheckpoint::Record;
+
+static void Check(const miopen::solver::TuningCheckpoint& checkpoint,
+                  const std::string& config,
+                  Record::Status status,
+                  float time)
+{
+    const auto record = checkpoint.Find(config);
+    EXPECT(record != nullptr);
+    EXPECT(record->status == status);
+    EXPECT(record->time == time);
+}
+
+int main()
+{
+    const miopen::TmpDir dir{"tuning_checkpoint"};
+    const auto path = dir.path / "tuning" / "checkpoint.txt";
+
+    {
+        miopen::solver::TuningCheckpoint checkpoint{path, "problem"};
+        EXPECT(checkpoint.Size() == 0);
+        checkpoint.Add("1,2,3", {Record::Status::Averaged, 0.5f});
+        checkpoint.Add("4,5,6", {Record::Status::Timed, 2.0f});
+        checkpoint.Add("7,8,9", {});
+    }
+
+    // An interruption in the middle of a record.
+    std::ofstream(path.string(), std::ios::app) << "10,11,12\ta";
+
+    {
+        miopen::solver::TuningCheckpoint checkpoint{path, "problem"};
+        EXPECT(checkpoint.Size() == 3);
+        Check(checkpoint, "1,2,3", Record::Status::Averaged, 0.5f);
+        Check(checkpoint, "4,5,6", Record::Status::Timed, 2.0f);
+        Check(checkpoint, "7,8,9", Record::Status::Failed, 0.0f);
+        EXPECT(checkpoint.Find("10,11,12") == nullptr);
+        checkpoint.Add("10,11,12", {Record::Status::Timed, 3.0f});
+    }
+
+    {
+        miopen::solver::TuningCheckpoint checkpoint{path, "problem"};
+        EXPECT(checkpoint.Size() == 4);
+        Check(checkpoint, "10,11,12", Record::Status::Timed, 3.0f);
+    }
+
+    {
+        miopen::solver::TuningCheckpoint checkpoint{path, "another problem"};
+        EXPECT(checkpoint.Size() == 0);
+        EXPECT(!boost::filesystem::exists(path));
+
+        checkpoint.Add("1,2,3", {Record::Status::Timed, 1.0f});
+        checkpoint.Remove();
+        EXPECT(checkpoint.Size() == 0);
+        EXPECT(!boost::filesystem::exists(path));
+    }
+
+    {
+        // Another process completes the same search and removes the file in the meantime.
+        miopen::solver::TuningCheckpoint checkpoint{path, "problem"};
+        checkpoint.Add("1,2,3", {Record::Status::Averaged, 0.5f});
+        miopen::solver::TuningCheckpoint other{path, "problem"};
+        EXPECT(other.Size() == 1);
+        other.Remove();
+
+        checkpoint.Add("4,5,6", {Record::Status::Timed, 2.0f});
+        miopen::solver::TuningCheckpoint reloaded{path, "problem"};
+        EXPECT(reloaded.Size() == 2);
+        Check(reloaded, "1,2,3", Record::Status::Averaged, 0.5f);
+        Check(reloaded, "4,5,6", Record::Status::Timed, 2.0f);
+    }
+}
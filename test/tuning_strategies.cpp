@@ -0,0 +1,245 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "get_handle.hpp"
+#include "test.hpp"
+
+#include <miopen/generic_search.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using miopen::solver::SearchOptions;
+using miopen::solver::SearchStrategy;
+
+constexpr int n_configs = 16;
+
+/// The fastest config is 5, followed by 4, 6 and 3; no two configs take the same time.
+float Cost(int x) { return 1.0f + static_cast<float>((x - 5) * (x - 5)) + 0.1f * x; }
+
+struct Config
+{
+    int x = 0;
+
+    void Serialize(std::ostream& os) const { os << x; }
+    friend std::ostream& operator<<(std::ostream& os, const Config& c) { return os << c.x; }
+};
+
+struct Context
+{
+    const miopen::Handle& GetStream() const { return get_handle(); }
+};
+
+/// What the search has done with the configs.
+struct Trace
+{
+    /// Configs in the order their invokers have been prepared, i.e. of their first run.
+    std::vector<int> visited;
+    std::vector<int> runs = std::vector<int>(n_configs, 0);
+    int delay_ms          = 0;
+};
+
+/// Reports Cost(x) as the time of config x, without a kernel.
+struct StubSolver
+{
+    Trace* trace;
+
+    miopen::solver::ConvSolution GetSolution(const Context&, const Config& config, bool) const
+    {
+        auto solution            = miopen::solver::ConvSolution{};
+        auto* const t            = trace;
+        solution.invoker_factory = [t, config](const std::vector<miopen::Kernel>&) {
+            t->visited.push_back(config.x);
+            return [t, config](const miopen::Handle& h, const miopen::AnyInvokeParams&) {
+                ++t->runs[config.x];
+                if(t->delay_ms != 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(t->delay_ms));
+                h.ResetKernelTime();
+                h.AccumKernelTime(Cost(config.x));
+            };
+        };
+        return solution;
+    }
+
+    float EstimateCost(const Context&, const Config& config) const { return Cost(config.x); }
+};
+
+using Session = miopen::solver::SearchSession<StubSolver, Context, Config>;
+
+std::vector<Config> AllConfigs()
+{
+    std::vector<Config> configs(n_configs);
+    for(auto i = 0; i < n_configs; ++i)
+        configs[i].x = i;
+    return configs;
+}
+
+std::vector<int> Range(int n)
+{
+    std::vector<int> range(n);
+    for(auto i = 0; i < n; ++i)
+        range[i] = i;
+    return range;
+}
+
+/// The fastest of the visited configs.
+int Best(const std::vector<int>& visited)
+{
+    return *std::min_element(visited.begin(), visited.end(), [](int l, int r) {
+        return Cost(l) < Cost(r);
+    });
+}
+
+miopen::solver::SearchResult<Config> Run(Trace& trace, const SearchOptions& options)
+{
+    const Context context{};
+    const StubSolver solver{&trace};
+    const miopen::AnyInvokeParams invoke_ctx{};
+    const auto default_solution = solver.GetSolution(context, Config{}, false);
+    miopen::AutoEnableProfiling enable_profiling{context.GetStream()};
+
+    const Session session{solver, context, invoke_ctx, default_solution};
+    const auto result = session.Run(AllConfigs(), options);
+    EXPECT(result.is_passed);
+    EXPECT_EQUAL(result.n_timed, trace.visited.size());
+    EXPECT(result.n_failed == 0);
+    // The time is an average of several runs in most cases.
+    EXPECT(std::abs(result.time - Cost(result.config.x)) < 1e-5f * Cost(result.config.x));
+    return result;
+}
+
+SearchOptions Options(SearchStrategy strategy, std::size_t max_configs = 0)
+{
+    SearchOptions options;
+    options.strategy    = strategy;
+    options.max_configs = max_configs;
+    options.seed        = 42;
+    return options;
+}
+
+void TestExhaustive()
+{
+    Trace trace;
+    const auto result = Run(trace, Options(SearchStrategy::Exhaustive));
+    EXPECT(trace.visited == Range(n_configs));
+    EXPECT_EQUAL(result.config.x, 5);
+
+    // Only the configs that are the fastest so far when timed are run 4 more times.
+    for(auto i = 0; i < n_configs; ++i)
+        EXPECT_EQUAL(trace.runs[i], i <= 5 ? 5 : 1);
+
+    Trace limited;
+    const auto first = Run(limited, Options(SearchStrategy::Exhaustive, 4));
+    EXPECT(limited.visited == Range(4));
+    EXPECT_EQUAL(first.config.x, 3);
+}
+
+void TestRandom()
+{
+    Trace trace;
+    const auto result = Run(trace, Options(SearchStrategy::Random));
+    auto sorted       = trace.visited;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT(sorted == Range(n_configs));
+    EXPECT(trace.visited != Range(n_configs));
+    EXPECT_EQUAL(result.config.x, 5);
+
+    // The same seed gives the same order, which max_configs cuts short.
+    Trace limited;
+    const auto first = Run(limited, Options(SearchStrategy::Random, 4));
+    EXPECT(limited.visited == std::vector<int>(trace.visited.begin(), trace.visited.begin() + 4));
+    EXPECT_EQUAL(first.config.x, Best(limited.visited));
+}
+
+void TestCostModel()
+{
+    Trace trace;
+    const auto result = Run(trace, Options(SearchStrategy::CostModel));
+    EXPECT(std::is_sorted(trace.visited.begin(), trace.visited.end(), [](int l, int r) {
+        return Cost(l) < Cost(r);
+    }));
+    EXPECT_EQUAL(trace.visited.size(), static_cast<std::size_t>(n_configs));
+    EXPECT_EQUAL(result.config.x, 5);
+}
+
+void TestHalving(const SearchOptions& options)
+{
+    Trace trace;
+    const auto result = Run(trace, options);
+    EXPECT(trace.visited == Range(n_configs));
+    EXPECT_EQUAL(result.config.x, 5);
+
+    // 16 configs are timed once, the fastest 4 of them twice more, then the fastest one 4 times
+    // more.
+    for(auto i = 0; i < n_configs; ++i)
+    {
+        const auto expected = i == 5 ? 7 : (i >= 3 && i <= 6) ? 3 : 1;
+        EXPECT_EQUAL(trace.runs[i], expected);
+    }
+}
+
+void TestBudget()
+{
+    Trace trace;
+    trace.delay_ms    = 10;
+    auto options      = Options(SearchStrategy::SuccessiveHalving);
+    options.budget_ms = 50;
+
+    const auto result = Run(trace, options);
+    EXPECT(!trace.visited.empty());
+    EXPECT(trace.visited.size() < static_cast<std::size_t>(n_configs));
+    EXPECT(trace.visited == Range(static_cast<int>(trace.visited.size())));
+    EXPECT_EQUAL(result.config.x, Best(trace.visited));
+}
+
+} // namespace
+
+int main()
+{
+    // The names of MIOPEN_DEBUG_TUNING_STRATEGY.
+    EXPECT_EQUAL(std::string(ToString(SearchStrategy::Exhaustive)), "exhaustive");
+    EXPECT_EQUAL(std::string(ToString(SearchStrategy::Random)), "random");
+    EXPECT_EQUAL(std::string(ToString(SearchStrategy::SuccessiveHalving)), "halving");
+    EXPECT_EQUAL(std::string(ToString(SearchStrategy::CostModel)), "cost");
+
+    setenv("MIOPEN_DEBUG_TUNING_STRATEGY", "halving", 1); // NOLINT (concurrency-mt-unsafe)
+    const auto options = SearchOptions::FromEnv();
+    EXPECT(options.strategy == SearchStrategy::SuccessiveHalving);
+    EXPECT(!options.IsExhaustive());
+
+    TestExhaustive();
+    TestRandom();
+    TestCostModel();
+    TestHalving(options);
+    TestBudget();
+}